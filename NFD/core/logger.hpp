@@ -26,9 +26,11 @@
 #define NFD_CORE_LOGGER_HPP
 
 #include "ns3/log.h"
+#include "ns3/ndn-log-level.h"
 
 namespace nfd {
 
+// statements below NDNSIM_MIN_LOG_LEVEL are removed by ns3/ndn-log-level.h
 #define NFD_LOG_INIT(name) NS_LOG_COMPONENT_DEFINE ("nfd." name);
 
 #define NFD_LOG_TRACE(expression)  NS_LOG_LOGIC(expression)
@@ -41,10 +41,6 @@ Face::Face(const FaceUri& remoteUri, const FaceUri& localUri, bool isLocal)
   , m_isOnDemand(false)
   , m_isFailed(false)
 {
-  onReceiveInterest += [this](const ndn::Interest&) { ++m_counters.getNInInterests(); };
-  onReceiveData     += [this](const ndn::Data&) {     ++m_counters.getNInDatas(); };
-  onSendInterest    += [this](const ndn::Interest&) { ++m_counters.getNOutInterests(); };
-  onSendData        += [this](const ndn::Data&) {     ++m_counters.getNOutDatas(); };
 }
 
 Face::Face()
@@ -104,6 +100,7 @@ Face::decodeAndDispatchInput(const Block& element, ns3::Ptr<ns3::Packet> packet)
         shared_ptr<ns3::ndn::Interest> i = make_shared<ns3::ndn::Interest>();
         i->wireDecode(element);
         i->setPacket (packet);
+        ++m_counters.getNInInterests();
         this->onReceiveInterest(dynamic_cast<Interest&>(*i));
       }
     else if (element.type() == ::ndn::tlv::Data)
@@ -111,6 +108,7 @@ Face::decodeAndDispatchInput(const Block& element, ns3::Ptr<ns3::Packet> packet)
         shared_ptr<ns3::ndn::Data> d = make_shared<ns3::ndn::Data>();
         d->wireDecode(element);
         d->setPacket (packet);
+        ++m_counters.getNInDatas();
         this->onReceiveData(dynamic_cast<Data&>(*d));
       }
     else
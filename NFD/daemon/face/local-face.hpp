@@ -157,6 +157,7 @@ LocalFace::decodeAndDispatchInput(const Block& element)
               this->isLocalControlHeaderEnabled(LOCAL_CONTROL_FEATURE_NEXT_HOP_FACE_ID));
           }
 
+        ++this->getMutableCounters().getNInInterests();
         this->onReceiveInterest(*i);
       }
     else if (payload.type() == tlv::Data)
@@ -175,6 +176,7 @@ LocalFace::decodeAndDispatchInput(const Block& element)
         //       false);
         //   }
 
+        ++this->getMutableCounters().getNInDatas();
         this->onReceiveData(*d);
       }
     else
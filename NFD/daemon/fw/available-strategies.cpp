@@ -34,31 +34,66 @@
 namespace nfd {
 namespace fw {
 
+/** \brief returns the instance of strategy S shared by all forwarders
+ *
+ *  S must keep all per-forwarder state in Measurements or PIT entry strategy info.
+ */
+template<typename S>
+inline shared_ptr<Strategy>
+getSharedStrategy()
+{
+  static shared_ptr<Strategy> instance = make_shared<S>();
+  return instance;
+}
+
 shared_ptr<Strategy>
-makeDefaultStrategy(Forwarder& forwarder)
+makeDefaultStrategy(Forwarder&)
 {
-  return make_shared<BestRouteStrategy2>(ref(forwarder));
+  return getSharedStrategy<BestRouteStrategy2>();
 }
 
+template<typename S>
+inline shared_ptr<Strategy>
+makeStrategy(Forwarder& forwarder)
+{
+  return make_shared<S>(ref(forwarder));
+}
+
+/** \brief installs strategy S, which is instantiated only when a prefix is assigned to it
+ */
 template<typename S>
 inline void
 installStrategy(Forwarder& forwarder)
 {
   StrategyChoice& strategyChoice = forwarder.getStrategyChoice();
-  if (!strategyChoice.hasStrategy(S::STRATEGY_NAME)) {
-    strategyChoice.install(make_shared<S>(ref(forwarder)));
+  if (!strategyChoice.hasStrategy(S::STRATEGY_NAME, true)) {
+    strategyChoice.install(S::STRATEGY_NAME, bind(&makeStrategy<S>, ref(forwarder)));
+  }
+}
+
+/** \brief installs the shared instance of strategy S
+ */
+template<typename S>
+inline void
+installSharedStrategy(Forwarder& forwarder)
+{
+  StrategyChoice& strategyChoice = forwarder.getStrategyChoice();
+  if (!strategyChoice.hasStrategy(S::STRATEGY_NAME, true)) {
+    strategyChoice.install(getSharedStrategy<S>());
   }
 }
 
 void
 installStrategies(Forwarder& forwarder)
 {
-  installStrategy<BestRouteStrategy>(forwarder);
-  installStrategy<BroadcastStrategy>(forwarder);
-  installStrategy<ClientControlStrategy>(forwarder);
+  installSharedStrategy<BestRouteStrategy>(forwarder);
+  installSharedStrategy<BroadcastStrategy>(forwarder);
+  installSharedStrategy<ClientControlStrategy>(forwarder);
+  // NCC schedules per-forwarder events, so each forwarder needs its own instance
   installStrategy<NccStrategy>(forwarder);
-  installStrategy<BestRouteStrategy2>(forwarder);
-  // Install the random load balancer forwarding strategy
+  installSharedStrategy<BestRouteStrategy2>(forwarder);
+  // Install the random load balancer forwarding strategy;
+  // each instance has its own random number generator
   installStrategy<RandomLoadBalancerStrategy>(forwarder);
 }
 
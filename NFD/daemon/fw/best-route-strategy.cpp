@@ -35,12 +35,17 @@ BestRouteStrategy::BestRouteStrategy(Forwarder& forwarder, const Name& name)
 {
 }
 
+BestRouteStrategy::BestRouteStrategy(const Name& name)
+  : Strategy(name)
+{
+}
+
 BestRouteStrategy::~BestRouteStrategy()
 {
 }
 
 static inline bool
-predicate_PitEntry_canForwardTo_NextHop(shared_ptr<pit::Entry> pitEntry,
+predicate_PitEntry_canForwardTo_NextHop(const shared_ptr<pit::Entry>& pitEntry,
                                         const fib::NextHop& nexthop)
 {
   return pitEntry->canForwardTo(*nexthop.getFace());
@@ -49,8 +54,8 @@ predicate_PitEntry_canForwardTo_NextHop(shared_ptr<pit::Entry> pitEntry,
 void
 BestRouteStrategy::afterReceiveInterest(const Face& inFace,
                    const Interest& interest,
-                   shared_ptr<fib::Entry> fibEntry,
-                   shared_ptr<pit::Entry> pitEntry)
+                   const shared_ptr<fib::Entry>& fibEntry,
+                   const shared_ptr<pit::Entry>& pitEntry)
 {
   if (pitEntry->hasUnexpiredOutRecords()) {
     // not a new Interest, don't forward
@@ -59,14 +64,14 @@ BestRouteStrategy::afterReceiveInterest(const Face& inFace,
 
   const fib::NextHopList& nexthops = fibEntry->getNextHops();
   fib::NextHopList::const_iterator it = std::find_if(nexthops.begin(), nexthops.end(),
-    bind(&predicate_PitEntry_canForwardTo_NextHop, pitEntry, _1));
+    bind(&predicate_PitEntry_canForwardTo_NextHop, cref(pitEntry), _1));
 
   if (it == nexthops.end()) {
     this->rejectPendingInterest(pitEntry);
     return;
   }
 
-  shared_ptr<Face> outFace = it->getFace();
+  const shared_ptr<Face>& outFace = it->getFace();
   this->sendInterest(pitEntry, outFace);
 }
 
@@ -47,14 +47,18 @@ class BestRouteStrategy : public Strategy
 public:
   BestRouteStrategy(Forwarder& forwarder, const Name& name = STRATEGY_NAME);
 
+  /// construct an instance shared by all forwarders
+  explicit
+  BestRouteStrategy(const Name& name = STRATEGY_NAME);
+
   virtual
   ~BestRouteStrategy();
 
   virtual void
   afterReceiveInterest(const Face& inFace,
                        const Interest& interest,
-                       shared_ptr<fib::Entry> fibEntry,
-                       shared_ptr<pit::Entry> pitEntry);
+                       const shared_ptr<fib::Entry>& fibEntry,
+                       const shared_ptr<pit::Entry>& pitEntry);
 
 public:
   static const Name STRATEGY_NAME;
@@ -25,6 +25,7 @@
 
 #include "ns3/ndnSIM/NFD/daemon/fw/best-route-strategy2.hpp"
 #include "ns3/ndnSIM/NFD/core/logger.hpp"
+#include "ns3/ndn-time.h"
 
 namespace nfd {
 namespace fw {
@@ -40,6 +41,11 @@ BestRouteStrategy2::BestRouteStrategy2(Forwarder& forwarder, const Name& name)
 {
 }
 
+BestRouteStrategy2::BestRouteStrategy2(const Name& name)
+  : Strategy(name)
+{
+}
+
 /** \brief determines whether a NextHop is eligible
  *  \param currentDownstream incoming FaceId of current Interest
  *  \param wantUnused if true, NextHop must not have unexpired OutRecord
@@ -51,7 +57,7 @@ predicate_NextHop_eligible(const shared_ptr<pit::Entry>& pitEntry,
   bool wantUnused = false,
   time::steady_clock::TimePoint now = time::steady_clock::TimePoint::min())
 {
-  shared_ptr<Face> upstream = nexthop.getFace();
+  const shared_ptr<Face>& upstream = nexthop.getFace();
 
   // upstream is current downstream
   if (upstream->getId() == currentDownstream)
@@ -105,8 +111,8 @@ findEligibleNextHopWithEarliestOutRecord(const shared_ptr<pit::Entry>& pitEntry,
 void
 BestRouteStrategy2::afterReceiveInterest(const Face& inFace,
                                          const Interest& interest,
-                                         shared_ptr<fib::Entry> fibEntry,
-                                         shared_ptr<pit::Entry> pitEntry)
+                                         const shared_ptr<fib::Entry>& fibEntry,
+                                         const shared_ptr<pit::Entry>& pitEntry)
 {
   const fib::NextHopList& nexthops = fibEntry->getNextHops();
   fib::NextHopList::const_iterator it = nexthops.end();
@@ -115,7 +121,7 @@ BestRouteStrategy2::afterReceiveInterest(const Face& inFace,
   if (isNewPitEntry) {
     // forward to nexthop with lowest cost except downstream
     it = std::find_if(nexthops.begin(), nexthops.end(),
-      bind(&predicate_NextHop_eligible, pitEntry, _1, inFace.getId(),
+      bind(&predicate_NextHop_eligible, cref(pitEntry), _1, inFace.getId(),
            false, time::steady_clock::TimePoint::min()));
 
     if (it == nexthops.end()) {
@@ -124,7 +130,7 @@ BestRouteStrategy2::afterReceiveInterest(const Face& inFace,
       return;
     }
 
-    shared_ptr<Face> outFace = it->getFace();
+    const shared_ptr<Face>& outFace = it->getFace();
     this->sendInterest(pitEntry, outFace);
     NFD_LOG_DEBUG(interest << " from=" << inFace.getId()
                            << " newPitEntry-to=" << outFace->getId());
@@ -137,7 +143,7 @@ BestRouteStrategy2::afterReceiveInterest(const Face& inFace,
     outRecords.begin(), outRecords.end(), &compare_OutRecord_lastRenewed);
   BOOST_ASSERT(lastOutgoing != outRecords.end()); // otherwise it's new PIT entry
 
-  time::steady_clock::TimePoint now = time::steady_clock::now();
+  time::steady_clock::TimePoint now = ns3::ndn::time::steadyNow();
   time::steady_clock::Duration sinceLastOutgoing = now - lastOutgoing->getLastRenewed();
   bool shouldRetransmit = sinceLastOutgoing >= MIN_RETRANSMISSION_INTERVAL;
   if (!shouldRetransmit) {
@@ -148,9 +154,9 @@ BestRouteStrategy2::afterReceiveInterest(const Face& inFace,
 
   // find an unused upstream with lowest cost except downstream
   it = std::find_if(nexthops.begin(), nexthops.end(),
-    bind(&predicate_NextHop_eligible, pitEntry, _1, inFace.getId(), true, now));
+    bind(&predicate_NextHop_eligible, cref(pitEntry), _1, inFace.getId(), true, now));
   if (it != nexthops.end()) {
-    shared_ptr<Face> outFace = it->getFace();
+    const shared_ptr<Face>& outFace = it->getFace();
     this->sendInterest(pitEntry, outFace);
     NFD_LOG_DEBUG(interest << " from=" << inFace.getId()
                            << " retransmit-unused-to=" << outFace->getId());
@@ -163,7 +169,7 @@ BestRouteStrategy2::afterReceiveInterest(const Face& inFace,
     NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " retransmitNoNextHop");
   }
   else {
-    shared_ptr<Face> outFace = it->getFace();
+    const shared_ptr<Face>& outFace = it->getFace();
     this->sendInterest(pitEntry, outFace);
     NFD_LOG_DEBUG(interest << " from=" << inFace.getId()
                            << " retransmit-retry-to=" << outFace->getId());
@@ -44,11 +44,15 @@ class BestRouteStrategy2 : public Strategy
 public:
   BestRouteStrategy2(Forwarder& forwarder, const Name& name = STRATEGY_NAME);
 
+  /// construct an instance shared by all forwarders
+  explicit
+  BestRouteStrategy2(const Name& name = STRATEGY_NAME);
+
   virtual void
   afterReceiveInterest(const Face& inFace,
                        const Interest& interest,
-                       shared_ptr<fib::Entry> fibEntry,
-                       shared_ptr<pit::Entry> pitEntry);
+                       const shared_ptr<fib::Entry>& fibEntry,
+                       const shared_ptr<pit::Entry>& pitEntry);
 
 public:
   static const Name STRATEGY_NAME;
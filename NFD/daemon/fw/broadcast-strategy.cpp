@@ -35,6 +35,11 @@ BroadcastStrategy::BroadcastStrategy(Forwarder& forwarder, const Name& name)
 {
 }
 
+BroadcastStrategy::BroadcastStrategy(const Name& name)
+  : Strategy(name)
+{
+}
+
 BroadcastStrategy::~BroadcastStrategy()
 {
 }
@@ -42,13 +47,13 @@ BroadcastStrategy::~BroadcastStrategy()
 void
 BroadcastStrategy::afterReceiveInterest(const Face& inFace,
                    const Interest& interest,
-                   shared_ptr<fib::Entry> fibEntry,
-                   shared_ptr<pit::Entry> pitEntry)
+                   const shared_ptr<fib::Entry>& fibEntry,
+                   const shared_ptr<pit::Entry>& pitEntry)
 {
   const fib::NextHopList& nexthops = fibEntry->getNextHops();
 
   for (fib::NextHopList::const_iterator it = nexthops.begin(); it != nexthops.end(); ++it) {
-    shared_ptr<Face> outFace = it->getFace();
+    const shared_ptr<Face>& outFace = it->getFace();
     if (pitEntry->canForwardTo(*outFace)) {
       this->sendInterest(pitEntry, outFace);
     }
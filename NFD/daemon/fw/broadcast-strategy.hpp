@@ -39,14 +39,18 @@ class BroadcastStrategy : public Strategy
 public:
   BroadcastStrategy(Forwarder& forwarder, const Name& name = STRATEGY_NAME);
 
+  /// construct an instance shared by all forwarders
+  explicit
+  BroadcastStrategy(const Name& name = STRATEGY_NAME);
+
   virtual
   ~BroadcastStrategy();
 
   virtual void
   afterReceiveInterest(const Face& inFace,
                        const Interest& interest,
-                       shared_ptr<fib::Entry> fibEntry,
-                       shared_ptr<pit::Entry> pitEntry);
+                       const shared_ptr<fib::Entry>& fibEntry,
+                       const shared_ptr<pit::Entry>& pitEntry);
 
 public:
   static const Name STRATEGY_NAME;
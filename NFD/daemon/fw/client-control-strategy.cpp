@@ -39,6 +39,11 @@ ClientControlStrategy::ClientControlStrategy(Forwarder& forwarder, const Name& n
 {
 }
 
+ClientControlStrategy::ClientControlStrategy(const Name& name)
+  : BestRouteStrategy(name)
+{
+}
+
 ClientControlStrategy::~ClientControlStrategy()
 {
 }
@@ -46,8 +51,8 @@ ClientControlStrategy::~ClientControlStrategy()
 void
 ClientControlStrategy::afterReceiveInterest(const Face& inFace,
                                             const Interest& interest,
-                                            shared_ptr<fib::Entry> fibEntry,
-                                            shared_ptr<pit::Entry> pitEntry)
+                                            const shared_ptr<fib::Entry>& fibEntry,
+                                            const shared_ptr<pit::Entry>& pitEntry)
 {
   // Strategy needn't check whether LocalControlHeader-NextHopFaceId is enabled.
   // LocalFace does this check.
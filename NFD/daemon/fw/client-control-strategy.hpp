@@ -38,14 +38,18 @@ class ClientControlStrategy : public BestRouteStrategy
 public:
   ClientControlStrategy(Forwarder& forwarder, const Name& name = STRATEGY_NAME);
 
+  /// construct an instance shared by all forwarders
+  explicit
+  ClientControlStrategy(const Name& name = STRATEGY_NAME);
+
   virtual
   ~ClientControlStrategy();
 
   virtual void
   afterReceiveInterest(const Face& inFace,
                        const Interest& interest,
-                       shared_ptr<fib::Entry> fibEntry,
-                       shared_ptr<pit::Entry> pitEntry);
+                       const shared_ptr<fib::Entry>& fibEntry,
+                       const shared_ptr<pit::Entry>& pitEntry);
 
 public:
   static const Name STRATEGY_NAME;
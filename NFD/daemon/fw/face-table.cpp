@@ -27,6 +27,8 @@
 #include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
 #include "ns3/ndnSIM/NFD/core/logger.hpp"
 
+#include <algorithm>
+
 namespace nfd {
 
 NFD_LOG_INIT("FaceTable");
@@ -45,7 +47,7 @@ FaceTable::~FaceTable()
 void
 FaceTable::add(shared_ptr<Face> face)
 {
-  if (face->getId() != INVALID_FACEID && m_faces.count(face->getId()) > 0) {
+  if (face->getId() != INVALID_FACEID && static_cast<bool>(this->get(face->getId()))) {
     NFD_LOG_WARN("Trying to add existing face id=" << face->getId() << " to the face table");
     return;
   }
@@ -59,7 +61,7 @@ void
 FaceTable::addReserved(shared_ptr<Face> face, FaceId faceId)
 {
   BOOST_ASSERT(face->getId() == INVALID_FACEID);
-  BOOST_ASSERT(m_faces.count(face->getId()) == 0);
+  BOOST_ASSERT(!static_cast<bool>(this->get(faceId)));
   BOOST_ASSERT(faceId <= FACEID_RESERVED_MAX);
   this->addImpl(face, faceId);
 }
@@ -68,7 +70,14 @@ void
 FaceTable::addImpl(shared_ptr<Face> face, FaceId faceId)
 {
   face->setId(faceId);
-  m_faces[faceId] = face;
+  m_faces.insert(this->findPosition(faceId), face);
+  if (faceId > FACEID_RESERVED_MAX) {
+    FaceId index = faceId - FACEID_RESERVED_MAX - 1;
+    if (index >= m_facesById.size()) {
+      m_facesById.resize(index + 1);
+    }
+    m_facesById[index] = face;
+  }
   NFD_LOG_INFO("Added face id=" << faceId << " remote=" << face->getRemoteUri()
                                           << " local=" << face->getLocalUri());
 
@@ -87,7 +96,13 @@ FaceTable::remove(shared_ptr<Face> face)
   this->onRemove(face);
 
   FaceId faceId = face->getId();
-  m_faces.erase(faceId);
+  FaceList::iterator position = this->findPosition(faceId);
+  if (position != m_faces.end() && *position == face) {
+    m_faces.erase(position);
+  }
+  if (faceId > FACEID_RESERVED_MAX) {
+    m_facesById[faceId - FACEID_RESERVED_MAX - 1].reset();
+  }
   face->setId(INVALID_FACEID);
   NFD_LOG_INFO("Removed face id=" << faceId << " remote=" << face->getRemoteUri() <<
                                                  " local=" << face->getLocalUri());
@@ -103,6 +118,22 @@ FaceTable::remove(shared_ptr<Face> face)
   m_forwarder.getFib().removeNextHopFromAllEntries(face);
 }
 
+static bool
+compareFaceId(const shared_ptr<Face>& face, FaceId faceId)
+{
+  return face->getId() < faceId;
+}
+
+FaceTable::FaceList::iterator
+FaceTable::findPosition(FaceId faceId)
+{
+  // new faces get the largest FaceId, so they are usually appended at the end
+  if (m_faces.empty() || m_faces.back()->getId() < faceId) {
+    return m_faces.end();
+  }
+  return std::lower_bound(m_faces.begin(), m_faces.end(), faceId, &compareFaceId);
+}
+
 
 
 } // namespace nfd
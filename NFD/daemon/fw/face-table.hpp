@@ -27,7 +27,6 @@
 #define NFD_DAEMON_FW_FACE_TABLE_HPP
 
 #include "ns3/ndnSIM/model/ndn-face.h"
-#include "ns3/ndnSIM/NFD/core/map-value-iterator.hpp"
 
 namespace nfd
 {
@@ -59,15 +58,17 @@ public:
   size() const;
 
 public: // enumeration
-  typedef std::map<FaceId, shared_ptr<Face> > FaceMap;
+  /** \brief faces ordered by FaceId
+   */
+  typedef std::vector<shared_ptr<Face> > FaceList;
 
   /** \brief ForwardIterator for shared_ptr<Face>
    */
-  typedef MapValueIterator<FaceMap> const_iterator;
+  typedef FaceList::const_iterator const_iterator;
 
   /** \brief ReverseIterator for shared_ptr<Face>
    */
-  typedef MapValueReverseIterator<FaceMap> const_reverse_iterator;
+  typedef FaceList::const_reverse_iterator const_reverse_iterator;
 
   const_iterator
   begin() const;
@@ -101,17 +102,41 @@ private:
   void
   remove(shared_ptr<Face> face);
 
+  /// position of the first face in m_faces whose FaceId is not less than faceId
+  FaceList::iterator
+  findPosition(FaceId faceId);
+
 private:
   Forwarder& m_forwarder;
   FaceId m_lastFaceId;
-  FaceMap m_faces;
+
+  /// all faces, ordered by FaceId
+  FaceList m_faces;
+
+  /** \brief faces with FaceIds above FACEID_RESERVED_MAX, indexed by FaceId - FACEID_RESERVED_MAX - 1
+   *
+   *  FaceIds are allocated sequentially, so the vector is dense;
+   *  entries of removed faces are null.
+   */
+  FaceList m_facesById;
 };
 
 inline shared_ptr<Face>
 FaceTable::get(FaceId id) const
 {
-  std::map<FaceId, shared_ptr<Face> >::const_iterator i = m_faces.find(id);
-  return (i == m_faces.end()) ? (shared_ptr<Face>()) : (i->second);
+  if (id > FACEID_RESERVED_MAX) {
+    FaceId index = id - FACEID_RESERVED_MAX - 1;
+    return index < m_facesById.size() ? m_facesById[index] : shared_ptr<Face>();
+  }
+
+  // reserved faces are few and always at the front of m_faces
+  for (const_iterator i = m_faces.begin();
+       i != m_faces.end() && (*i)->getId() <= FACEID_RESERVED_MAX; ++i) {
+    if ((*i)->getId() == id) {
+      return *i;
+    }
+  }
+  return shared_ptr<Face>();
 }
 
 inline size_t
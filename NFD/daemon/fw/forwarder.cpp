@@ -31,6 +31,7 @@
 
 #include "ns3/ndn-data.h"
 #include "ns3/ndn-interest.h"
+#include "ns3/ndn-time.h"
 
 namespace nfd {
 
@@ -55,6 +56,26 @@ Forwarder::~Forwarder()
 
 }
 
+#ifdef WITH_TESTS
+void
+Forwarder::dispatchToStrategy(const shared_ptr<pit::Entry>& pitEntry,
+                              function<void(fw::Strategy*)> trigger)
+#else
+template<class Function>
+inline void
+Forwarder::dispatchToStrategy(const shared_ptr<pit::Entry>& pitEntry, Function trigger)
+#endif
+{
+  fw::Strategy& strategy = m_strategyChoice.findEffectiveStrategy(*pitEntry);
+  if (!strategy.isShared()) {
+    trigger(&strategy);
+    return;
+  }
+
+  fw::Strategy::TriggerScope scope(*this, strategy);
+  trigger(&strategy);
+}
+
 void
 Forwarder::setNode (ns3::Ptr<ns3::Node> node)
 {
@@ -125,6 +146,17 @@ Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
       // set PIT straggler timer
       this->setStragglerTimer(pitEntry, true, csMatch->getFreshnessPeriod());
 
+      const ns3::ndn::Data* cached = dynamic_cast<const ns3::ndn::Data*>(csMatch);
+      if (cached != 0) {
+        // the cached Data may still be held by local applications, so it is not changed:
+        // its reply copy with a zero hop count is made on the first hit and reused later
+        shared_ptr<const ns3::ndn::Data> reply = cached->getContentStoreReply();
+
+        // goto outgoing Data pipeline
+        this->onOutgoingData(*reply, inFace);
+        return;
+      }
+
       // Take care of packet tags
       ns3::Ptr<ns3::Packet> packet = ns3::Create<ns3::Packet>();
       ns3::ndn::FwHopCountTag hopCount;
@@ -150,12 +182,13 @@ Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
 
   // dispatch to strategy
   this->dispatchToStrategy(pitEntry, bind(&Strategy::afterReceiveInterest, _1,
-                                          cref(inFace), cref(interest), fibEntry, pitEntry));
+                                          cref(inFace), cref(interest),
+                                          cref(fibEntry), cref(pitEntry)));
 }
 
 void
 Forwarder::onInterestLoop(Face& inFace, const Interest& interest,
-                          shared_ptr<pit::Entry> pitEntry)
+                          const shared_ptr<pit::Entry>& pitEntry)
 {
   NFD_LOG_DEBUG("onInterestLoop face=" << inFace.getId() <<
                 " interest=" << interest.getName());
@@ -190,7 +223,7 @@ compare_pickInterest(const pit::InRecord& a, const pit::InRecord& b, const Face*
 }
 
 void
-Forwarder::onOutgoingInterest(shared_ptr<pit::Entry> pitEntry, Face& outFace,
+Forwarder::onOutgoingInterest(const shared_ptr<pit::Entry>& pitEntry, Face& outFace,
                               bool wantNewNonce)
 {
   if (outFace.getId() == INVALID_FACEID) {
@@ -230,7 +263,7 @@ Forwarder::onOutgoingInterest(shared_ptr<pit::Entry> pitEntry, Face& outFace,
 }
 
 void
-Forwarder::onInterestReject(shared_ptr<pit::Entry> pitEntry)
+Forwarder::onInterestReject(const shared_ptr<pit::Entry>& pitEntry)
 {
   if (pitEntry->hasUnexpiredOutRecords()) {
     NFD_LOG_ERROR("onInterestReject interest=" << pitEntry->getName() <<
@@ -247,20 +280,20 @@ Forwarder::onInterestReject(shared_ptr<pit::Entry> pitEntry)
 }
 
 void
-Forwarder::onInterestUnsatisfied(shared_ptr<pit::Entry> pitEntry)
+Forwarder::onInterestUnsatisfied(const shared_ptr<pit::Entry>& pitEntry)
 {
   NFD_LOG_DEBUG("onInterestUnsatisfied interest=" << pitEntry->getName());
 
   // invoke PIT unsatisfied callback
   this->dispatchToStrategy(pitEntry, bind(&Strategy::beforeExpirePendingInterest, _1,
-                                          pitEntry));
+                                          cref(pitEntry)));
 
   // goto Interest Finalize pipeline
   this->onInterestFinalize(pitEntry, false);
 }
 
 void
-Forwarder::onInterestFinalize(shared_ptr<pit::Entry> pitEntry, bool isSatisfied,
+Forwarder::onInterestFinalize(const shared_ptr<pit::Entry>& pitEntry, bool isSatisfied,
                               const time::milliseconds& dataFreshnessPeriod)
 {
   NFD_LOG_DEBUG("onInterestFinalize interest=" << pitEntry->getName() <<
@@ -307,11 +340,13 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
     getNode ()->GetObject<ns3::ndn::L3Protocol> ()->GetObject<ns3::ndn::ContentStore> ()
       ->Add (data.shared_from_this());
 
-  std::set<shared_ptr<Face> > pendingDownstreams;
+  // pending downstreams, deduplicated after the loop
+  std::vector<Face*> pendingDownstreams;
+  time::steady_clock::TimePoint now = ns3::ndn::time::steadyNow();
   // foreach PitEntry
   for (pit::DataMatchResult::iterator it = pitMatches->begin();
        it != pitMatches->end(); ++it) {
-    shared_ptr<pit::Entry> pitEntry = *it;
+    const shared_ptr<pit::Entry>& pitEntry = *it;
     NFD_LOG_DEBUG("onIncomingData matching=" << pitEntry->getName());
 
     // cancel unsatisfy & straggler timer
@@ -321,14 +356,14 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
     const pit::InRecordCollection& inRecords = pitEntry->getInRecords();
     for (pit::InRecordCollection::const_iterator it = inRecords.begin();
                                                  it != inRecords.end(); ++it) {
-      if (it->getExpiry() > time::steady_clock::now()) {
-        pendingDownstreams.insert(it->getFace());
+      if (it->getExpiry() > now) {
+        pendingDownstreams.push_back(it->getFace().get());
       }
     }
 
     // invoke PIT satisfy callback
     this->dispatchToStrategy(pitEntry, bind(&Strategy::beforeSatisfyInterest, _1,
-                                            pitEntry, cref(inFace), cref(data)));
+                                            cref(pitEntry), cref(inFace), cref(data)));
 
     // Dead Nonce List insert if necessary (for OutRecord of inFace)
     this->insertDeadNonceList(*pitEntry, true, data.getFreshnessPeriod(), &inFace);
@@ -341,15 +376,24 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
     this->setStragglerTimer(pitEntry, true, data.getFreshnessPeriod());
   }
 
+  this->onOutgoingDataFanOut(data, inFace, pendingDownstreams);
+}
+
+void
+Forwarder::onOutgoingDataFanOut(const Data& data, const Face& inFace,
+                                std::vector<Face*>& downstreams)
+{
+  std::sort(downstreams.begin(), downstreams.end());
+  downstreams.erase(std::unique(downstreams.begin(), downstreams.end()), downstreams.end());
+
   // foreach pending downstream
-  for (std::set<shared_ptr<Face> >::iterator it = pendingDownstreams.begin();
-      it != pendingDownstreams.end(); ++it) {
-    shared_ptr<Face> pendingDownstream = *it;
-    if (pendingDownstream.get() == &inFace) {
+  for (std::vector<Face*>::const_iterator it = downstreams.begin();
+       it != downstreams.end(); ++it) {
+    if (*it == &inFace) {
       continue;
     }
-    // goto outgoing Data pipeline
-    this->onOutgoingData(data, *pendingDownstream);
+    // goto outgoing Data pipeline; the Data is encoded once and shared by all faces
+    this->onOutgoingData(data, **it);
   }
 }
 
@@ -405,7 +449,7 @@ compare_InRecord_expiry(const pit::InRecord& a, const pit::InRecord& b)
 }
 
 void
-Forwarder::setUnsatisfyTimer(shared_ptr<pit::Entry> pitEntry)
+Forwarder::setUnsatisfyTimer(const shared_ptr<pit::Entry>& pitEntry)
 {
   const pit::InRecordCollection& inRecords = pitEntry->getInRecords();
   pit::InRecordCollection::const_iterator lastExpiring =
@@ -413,7 +457,7 @@ Forwarder::setUnsatisfyTimer(shared_ptr<pit::Entry> pitEntry)
     &compare_InRecord_expiry);
 
   time::steady_clock::TimePoint lastExpiry = lastExpiring->getExpiry();
-  time::nanoseconds lastExpiryFromNow = lastExpiry  - time::steady_clock::now();
+  time::nanoseconds lastExpiryFromNow = lastExpiry  - ns3::ndn::time::steadyNow();
   if (lastExpiryFromNow <= time::seconds(0)) {
     // TODO all InRecords are already expired; will this happen?
   }
@@ -424,7 +468,7 @@ Forwarder::setUnsatisfyTimer(shared_ptr<pit::Entry> pitEntry)
 }
 
 void
-Forwarder::setStragglerTimer(shared_ptr<pit::Entry> pitEntry, bool isSatisfied,
+Forwarder::setStragglerTimer(const shared_ptr<pit::Entry>& pitEntry, bool isSatisfied,
                              const time::milliseconds& dataFreshnessPeriod)
 {
   time::nanoseconds stragglerTime = time::milliseconds(100);
@@ -435,7 +479,7 @@ Forwarder::setStragglerTimer(shared_ptr<pit::Entry> pitEntry, bool isSatisfied,
 }
 
 void
-Forwarder::cancelUnsatisfyAndStragglerTimer(shared_ptr<pit::Entry> pitEntry)
+Forwarder::cancelUnsatisfyAndStragglerTimer(const shared_ptr<pit::Entry>& pitEntry)
 {
   scheduler::cancel(pitEntry->m_unsatisfyTimer);
   scheduler::cancel(pitEntry->m_stragglerTimer);
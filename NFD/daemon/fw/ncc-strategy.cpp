@@ -48,8 +48,8 @@ const time::nanoseconds NccStrategy::MEASUREMENTS_LIFETIME = time::seconds(16);
 void
 NccStrategy::afterReceiveInterest(const Face& inFace,
                                   const Interest& interest,
-                                  shared_ptr<fib::Entry> fibEntry,
-                                  shared_ptr<pit::Entry> pitEntry)
+                                  const shared_ptr<fib::Entry>& fibEntry,
+                                  const shared_ptr<pit::Entry>& pitEntry)
 {
   const fib::NextHopList& nexthops = fibEntry->getNextHops();
   if (nexthops.size() == 0) {
@@ -139,7 +139,7 @@ NccStrategy::doPropagate(weak_ptr<pit::Entry> pitEntryWeak, weak_ptr<fib::Entry>
   const fib::NextHopList& nexthops = fibEntry->getNextHops();
   bool isForwarded = false;
   for (fib::NextHopList::const_iterator it = nexthops.begin(); it != nexthops.end(); ++it) {
-    shared_ptr<Face> face = it->getFace();
+    const shared_ptr<Face>& face = it->getFace();
     if (pitEntry->canForwardTo(*face)) {
       isForwarded = true;
       this->sendInterest(pitEntry, face);
@@ -182,7 +182,7 @@ NccStrategy::timeoutOnBestFace(weak_ptr<pit::Entry> pitEntryWeak)
 }
 
 void
-NccStrategy::beforeSatisfyInterest(shared_ptr<pit::Entry> pitEntry,
+NccStrategy::beforeSatisfyInterest(const shared_ptr<pit::Entry>& pitEntry,
                                    const Face& inFace, const Data& data)
 {
   if (pitEntry->getInRecords().empty()) {
@@ -214,14 +214,14 @@ NccStrategy::beforeSatisfyInterest(shared_ptr<pit::Entry> pitEntry,
 }
 
 shared_ptr<NccStrategy::MeasurementsEntryInfo>
-NccStrategy::getMeasurementsEntryInfo(shared_ptr<pit::Entry> entry)
+NccStrategy::getMeasurementsEntryInfo(const shared_ptr<pit::Entry>& entry)
 {
   shared_ptr<measurements::Entry> measurementsEntry = this->getMeasurements().get(*entry);
   return this->getMeasurementsEntryInfo(measurementsEntry);
 }
 
 shared_ptr<NccStrategy::MeasurementsEntryInfo>
-NccStrategy::getMeasurementsEntryInfo(shared_ptr<measurements::Entry> entry)
+NccStrategy::getMeasurementsEntryInfo(const shared_ptr<measurements::Entry>& entry)
 {
   shared_ptr<MeasurementsEntryInfo> info = entry->getStrategyInfo<MeasurementsEntryInfo>();
   if (static_cast<bool>(info)) {
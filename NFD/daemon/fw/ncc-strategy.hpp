@@ -44,11 +44,11 @@ public:
   virtual void
   afterReceiveInterest(const Face& inFace,
                        const Interest& interest,
-                       shared_ptr<fib::Entry> fibEntry,
-                       shared_ptr<pit::Entry> pitEntry);
+                       const shared_ptr<fib::Entry>& fibEntry,
+                       const shared_ptr<pit::Entry>& pitEntry);
 
   virtual void
-  beforeSatisfyInterest(shared_ptr<pit::Entry> pitEntry,
+  beforeSatisfyInterest(const shared_ptr<pit::Entry>& pitEntry,
                         const Face& inFace, const Data& data);
 
 protected:
@@ -107,10 +107,10 @@ protected:
 
 protected:
   shared_ptr<MeasurementsEntryInfo>
-  getMeasurementsEntryInfo(shared_ptr<measurements::Entry> entry);
+  getMeasurementsEntryInfo(const shared_ptr<measurements::Entry>& entry);
 
   shared_ptr<MeasurementsEntryInfo>
-  getMeasurementsEntryInfo(shared_ptr<pit::Entry> entry);
+  getMeasurementsEntryInfo(const shared_ptr<pit::Entry>& entry);
 
   /// propagate to another upstream
   void
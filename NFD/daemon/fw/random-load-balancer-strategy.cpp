@@ -49,7 +49,7 @@ RandomLoadBalancerStrategy::~RandomLoadBalancerStrategy()
 }
 
 static bool
-canForwardToNextHop(shared_ptr<pit::Entry> pitEntry,
+canForwardToNextHop(const shared_ptr<pit::Entry>& pitEntry,
                     const fib::NextHop& nexthop)
 {
   return pitEntry->canForwardTo(*nexthop.getFace());
@@ -57,17 +57,17 @@ canForwardToNextHop(shared_ptr<pit::Entry> pitEntry,
 
 static bool
 hasFaceForForwarding(const fib::NextHopList& nexthops,
-                     shared_ptr<pit::Entry>& pitEntry)
+                     const shared_ptr<pit::Entry>& pitEntry)
 {
   return std::find_if(nexthops.begin(), nexthops.end(),
-                      bind(&canForwardToNextHop, pitEntry, _1)) != nexthops.end();
+                      bind(&canForwardToNextHop, cref(pitEntry), _1)) != nexthops.end();
 }
 
 void
 RandomLoadBalancerStrategy::afterReceiveInterest(const Face& inFace,
                                                  const Interest& interest,
-                                                 shared_ptr<fib::Entry> fibEntry,
-                                                 shared_ptr<pit::Entry> pitEntry)
+                                                 const shared_ptr<fib::Entry>& fibEntry,
+                                                 const shared_ptr<pit::Entry>& pitEntry)
 {
   if (pitEntry->hasUnexpiredOutRecords())
     {
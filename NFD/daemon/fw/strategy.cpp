@@ -32,11 +32,19 @@ namespace fw {
 
 NFD_LOG_INIT("Strategy");
 
+thread_local Strategy::TriggerScope* Strategy::s_scope = nullptr;
+
 Strategy::Strategy(Forwarder& forwarder, const Name& name)
   : m_name(name)
-  , m_forwarder(forwarder)
-  , m_measurements(m_forwarder.getMeasurements(),
-                   m_forwarder.getStrategyChoice(), this)
+  , m_forwarder(&forwarder)
+  , m_measurements(new MeasurementsAccessor(forwarder.getMeasurements(),
+                                            forwarder.getStrategyChoice(), this))
+{
+}
+
+Strategy::Strategy(const Name& name)
+  : m_name(name)
+  , m_forwarder(nullptr)
 {
 }
 
@@ -45,7 +53,7 @@ Strategy::~Strategy()
 }
 
 void
-Strategy::beforeSatisfyInterest(shared_ptr<pit::Entry> pitEntry,
+Strategy::beforeSatisfyInterest(const shared_ptr<pit::Entry>& pitEntry,
                                 const Face& inFace, const Data& data)
 {
   NFD_LOG_DEBUG("beforeSatisfyInterest pitEntry=" << pitEntry->getName() <<
@@ -53,11 +61,24 @@ Strategy::beforeSatisfyInterest(shared_ptr<pit::Entry> pitEntry,
 }
 
 void
-Strategy::beforeExpirePendingInterest(shared_ptr<pit::Entry> pitEntry)
+Strategy::beforeExpirePendingInterest(const shared_ptr<pit::Entry>& pitEntry)
 {
   NFD_LOG_DEBUG("beforeExpirePendingInterest pitEntry=" << pitEntry->getName());
 }
 
+Strategy::TriggerScope::TriggerScope(Forwarder& forwarder, Strategy& strategy)
+  : m_forwarder(forwarder)
+  , m_measurements(forwarder.getMeasurements(), forwarder.getStrategyChoice(), &strategy)
+  , m_previous(s_scope)
+{
+  s_scope = this;
+}
+
+Strategy::TriggerScope::~TriggerScope()
+{
+  s_scope = m_previous;
+}
+
 //void
 //Strategy::afterAddFibEntry(shared_ptr<fib::Entry> fibEntry)
 //{
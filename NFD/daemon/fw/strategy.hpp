@@ -46,6 +46,16 @@ public:
    */
   Strategy(Forwarder& forwarder, const Name& name);
 
+  /** \brief construct a strategy instance that can be shared by several forwarders
+   *  \param name the strategy Name.
+   *
+   *  A shared instance keeps no per-forwarder state in its members; all such state
+   *  must be stored in Measurements or in PIT entry strategy info.
+   *  Actions and accessors operate on the forwarder that dispatched the current trigger.
+   */
+  explicit
+  Strategy(const Name& name);
+
   virtual
   ~Strategy();
 
@@ -53,6 +63,31 @@ public:
   const Name&
   getName() const;
 
+  /// whether this instance is shared by several forwarders
+  bool
+  isShared() const;
+
+  /** \brief binds a shared strategy to the forwarder during a trigger
+   *
+   *  Forwarder::dispatchToStrategy creates a scope around every trigger of a shared
+   *  strategy.  Scopes can be nested, e.g. when an action synchronously delivers a packet
+   *  to an application that responds on the same forwarder.
+   */
+  class TriggerScope : noncopyable
+  {
+  public:
+    TriggerScope(Forwarder& forwarder, Strategy& strategy);
+
+    ~TriggerScope();
+
+  private:
+    Forwarder& m_forwarder;
+    MeasurementsAccessor m_measurements;
+    TriggerScope* m_previous;
+
+    friend class Strategy;
+  };
+
 public: // triggers
   /** \brief trigger after Interest is received
    *
@@ -70,15 +105,14 @@ public: // triggers
    *
    *  \note The strategy is permitted to store a weak reference to fibEntry.
    *        Do not store a shared reference, because PIT entry may be deleted at any moment.
-   *        fibEntry is passed by value to allow obtaining a weak reference from it.
-   *  \note The strategy is permitted to store a shared reference to pitEntry.
-   *        pitEntry is passed by value to reflect this fact.
+   *  \note The strategy is permitted to store a shared reference to pitEntry
+   *        by copying it; the reference passed in is only valid during the trigger.
    */
   virtual void
   afterReceiveInterest(const Face& inFace,
                        const Interest& interest,
-                       shared_ptr<fib::Entry> fibEntry,
-                       shared_ptr<pit::Entry> pitEntry) = 0;
+                       const shared_ptr<fib::Entry>& fibEntry,
+                       const shared_ptr<pit::Entry>& pitEntry) = 0;
 
   /** \brief trigger before PIT entry is satisfied
    *
@@ -87,11 +121,11 @@ public: // triggers
    *
    *  In this base class this method does nothing.
    *
-   *  \note The strategy is permitted to store a shared reference to pitEntry.
-   *        pitEntry is passed by value to reflect this fact.
+   *  \note The strategy is permitted to store a shared reference to pitEntry
+   *        by copying it; the reference passed in is only valid during the trigger.
    */
   virtual void
-  beforeSatisfyInterest(shared_ptr<pit::Entry> pitEntry,
+  beforeSatisfyInterest(const shared_ptr<pit::Entry>& pitEntry,
                         const Face& inFace, const Data& data);
 
   /** \brief trigger before PIT entry expires
@@ -103,17 +137,17 @@ public: // triggers
    *
    *  In this base class this method does nothing.
    *
-   *  \note The strategy is permitted to store a shared reference to pitEntry.
-   *        pitEntry is passed by value to reflect this fact.
+   *  \note The strategy is permitted to store a shared reference to pitEntry
+   *        by copying it; the reference passed in is only valid during the trigger.
    */
   virtual void
-  beforeExpirePendingInterest(shared_ptr<pit::Entry> pitEntry);
+  beforeExpirePendingInterest(const shared_ptr<pit::Entry>& pitEntry);
 
 protected: // actions
   /// send Interest to outFace
   VIRTUAL_WITH_TESTS void
-  sendInterest(shared_ptr<pit::Entry> pitEntry,
-               shared_ptr<Face> outFace,
+  sendInterest(const shared_ptr<pit::Entry>& pitEntry,
+               const shared_ptr<Face>& outFace,
                bool wantNewNonce = false);
 
   /** \brief decide that a pending Interest cannot be forwarded
@@ -122,7 +156,7 @@ protected: // actions
    *  forwarded earlier, and does not need to be resent now.
    */
   VIRTUAL_WITH_TESTS void
-  rejectPendingInterest(shared_ptr<pit::Entry> pitEntry);
+  rejectPendingInterest(const shared_ptr<pit::Entry>& pitEntry);
 
 protected: // accessors
   MeasurementsAccessor&
@@ -131,16 +165,24 @@ protected: // accessors
   shared_ptr<Face>
   getFace(FaceId id);
 
+private:
+  /// forwarder of this instance, or of the current trigger if the instance is shared
+  Forwarder&
+  getForwarder();
+
 private:
   Name m_name;
 
-  /** \brief reference to the forwarder
+  /** \brief pointer to the forwarder, null if the instance is shared
    *
    *  Triggers can access forwarder indirectly via actions.
    */
-  Forwarder& m_forwarder;
+  Forwarder* m_forwarder;
 
-  MeasurementsAccessor m_measurements;
+  unique_ptr<MeasurementsAccessor> m_measurements;
+
+  /// innermost trigger scope of shared strategies on this thread
+  static thread_local TriggerScope* s_scope;
 };
 
 inline const Name&
@@ -149,30 +191,50 @@ Strategy::getName() const
   return m_name;
 }
 
+inline bool
+Strategy::isShared() const
+{
+  return m_forwarder == nullptr;
+}
+
+inline Forwarder&
+Strategy::getForwarder()
+{
+  if (m_forwarder != nullptr) {
+    return *m_forwarder;
+  }
+  BOOST_ASSERT(s_scope != nullptr);
+  return s_scope->m_forwarder;
+}
+
 inline void
-Strategy::sendInterest(shared_ptr<pit::Entry> pitEntry,
-                       shared_ptr<Face> outFace,
+Strategy::sendInterest(const shared_ptr<pit::Entry>& pitEntry,
+                       const shared_ptr<Face>& outFace,
                        bool wantNewNonce)
 {
-  m_forwarder.onOutgoingInterest(pitEntry, *outFace, wantNewNonce);
+  this->getForwarder().onOutgoingInterest(pitEntry, *outFace, wantNewNonce);
 }
 
 inline void
-Strategy::rejectPendingInterest(shared_ptr<pit::Entry> pitEntry)
+Strategy::rejectPendingInterest(const shared_ptr<pit::Entry>& pitEntry)
 {
-  m_forwarder.onInterestReject(pitEntry);
+  this->getForwarder().onInterestReject(pitEntry);
 }
 
 inline MeasurementsAccessor&
 Strategy::getMeasurements()
 {
-  return m_measurements;
+  if (m_measurements != nullptr) {
+    return *m_measurements;
+  }
+  BOOST_ASSERT(s_scope != nullptr);
+  return s_scope->m_measurements;
 }
 
 inline shared_ptr<Face>
 Strategy::getFace(FaceId id)
 {
-  return m_forwarder.getFace(id);
+  return this->getForwarder().getFace(id);
 }
 
 } // namespace fw
@@ -39,6 +39,7 @@ InternalFace::InternalFace()
 void
 InternalFace::sendInterest(const Interest& interest)
 {
+  ++getMutableCounters().getNOutInterests();
   onSendInterest(interest);
 
   // Invoke .processInterest a bit later,
@@ -123,6 +124,7 @@ InternalFace::processInterest(const shared_ptr<const Interest>& interest)
 void
 InternalFace::sendData(const Data& data)
 {
+  ++getMutableCounters().getNOutDatas();
   onSendData(data);
 }
 
@@ -143,6 +145,7 @@ InternalFace::setInterestFilter(const Name& filter,
 void
 InternalFace::put(const Data& data)
 {
+  ++getMutableCounters().getNInDatas();
   onReceiveData(data);
 }
 
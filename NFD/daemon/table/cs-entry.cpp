@@ -29,6 +29,7 @@
 
 #include "ns3/ndnSIM/NFD/daemon/table/cs-entry.hpp"
 #include "ns3/ndnSIM/NFD/core/logger.hpp"
+#include "ns3/ndn-time.h"
 
 namespace nfd {
 namespace cs {
@@ -55,7 +56,7 @@ Entry::setData(const Data& data, bool isUnsolicited)
 void
 Entry::updateStaleTime()
 {
-  m_staleAt = time::steady_clock::now() + m_dataPacket->getFreshnessPeriod();
+  m_staleAt = ns3::ndn::time::steadyNow() + m_dataPacket->getFreshnessPeriod();
 }
 
 void
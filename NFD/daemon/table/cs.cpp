@@ -30,6 +30,7 @@
 #include "ns3/ndnSIM/NFD/daemon/table/cs.hpp"
 #include "ns3/ndnSIM/NFD/core/logger.hpp"
 #include "ns3/ndnSIM/NFD/core/random.hpp"
+#include "ns3/ndn-time.h"
 
 #include <ndn-cxx/util/crypto.hpp>
 #include <ndn-cxx/security/signature-sha256-with-rsa.hpp>
@@ -368,7 +369,7 @@ Cs::evictItem()
   }
 
   if (!m_cleanupIndex.get<byStaleness>().empty() &&
-      (*m_cleanupIndex.get<byStaleness>().begin())->getStaleTime() < time::steady_clock::now())
+      (*m_cleanupIndex.get<byStaleness>().begin())->getStaleTime() < ns3::ndn::time::steadyNow())
   {
     NFD_LOG_TRACE("Evict from staleness queue");
 
@@ -652,7 +653,7 @@ Cs::doesComplyWithSelectors(const Interest& interest,
         }
     }
 
-  if (interest.getMustBeFresh() && entry->getStaleTime() < time::steady_clock::now())
+  if (interest.getMustBeFresh() && entry->getStaleTime() < ns3::ndn::time::steadyNow())
     {
       NFD_LOG_TRACE("violates mustBeFresh");
       return false;
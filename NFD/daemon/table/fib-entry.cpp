@@ -33,24 +33,24 @@ Entry::Entry(const Name& prefix)
 }
 
 static inline bool
-predicate_NextHop_eq_Face(const NextHop& nexthop, shared_ptr<Face> face)
+predicate_NextHop_eq_Face(const NextHop& nexthop, const Face* face)
 {
-  return nexthop.getFace() == face;
+  return nexthop.getFace().get() == face;
 }
 
 bool
-Entry::hasNextHop(shared_ptr<Face> face) const
+Entry::hasNextHop(const shared_ptr<Face>& face) const
 {
   NextHopList::const_iterator it = std::find_if(m_nextHops.begin(), m_nextHops.end(),
-    bind(&predicate_NextHop_eq_Face, _1, face));
+    bind(&predicate_NextHop_eq_Face, _1, face.get()));
   return it != m_nextHops.end();
 }
 
 void
-Entry::addNextHop(shared_ptr<Face> face, uint64_t cost)
+Entry::addNextHop(const shared_ptr<Face>& face, uint64_t cost)
 {
   NextHopList::iterator it = std::find_if(m_nextHops.begin(), m_nextHops.end(),
-    bind(&predicate_NextHop_eq_Face, _1, face));
+    bind(&predicate_NextHop_eq_Face, _1, face.get()));
   if (it == m_nextHops.end()) {
     m_nextHops.push_back(fib::NextHop(face));
     it = m_nextHops.end() - 1;
@@ -63,10 +63,10 @@ Entry::addNextHop(shared_ptr<Face> face, uint64_t cost)
 }
 
 void
-Entry::removeNextHop(shared_ptr<Face> face)
+Entry::removeNextHop(const shared_ptr<Face>& face)
 {
   NextHopList::iterator it = std::find_if(m_nextHops.begin(), m_nextHops.end(),
-    bind(&predicate_NextHop_eq_Face, _1, face));
+    bind(&predicate_NextHop_eq_Face, _1, face.get()));
   if (it == m_nextHops.end()) {
     return;
   }
@@ -65,15 +65,15 @@ public:
   hasNextHops() const;
 
   bool
-  hasNextHop(shared_ptr<Face> face) const;
+  hasNextHop(const shared_ptr<Face>& face) const;
 
   /// adds a nexthop
   void
-  addNextHop(shared_ptr<Face> face, uint64_t cost);
+  addNextHop(const shared_ptr<Face>& face, uint64_t cost);
 
   /// removes a nexthop
   void
-  removeNextHop(shared_ptr<Face> face);
+  removeNextHop(const shared_ptr<Face>& face);
 
 private:
   /// sorts the nexthop list
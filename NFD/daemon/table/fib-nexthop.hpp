@@ -38,11 +38,11 @@ class NextHop
 {
 public:
   explicit
-  NextHop(shared_ptr<Face> face);
+  NextHop(const shared_ptr<Face>& face);
 
   NextHop(const NextHop& other);
 
-  shared_ptr<Face>
+  const shared_ptr<Face>&
   getFace() const;
 
   void
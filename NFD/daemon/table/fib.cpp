@@ -54,6 +54,30 @@ Fib::insert(const Name& prefix)
   return std::make_pair(entry, true);
 }
 
+void
+Fib::addNextHops(const std::vector<std::pair<Name, fib::NextHop> >& nextHops)
+{
+  typedef std::vector<std::pair<Name, fib::NextHop> >::const_iterator Iterator;
+
+  size_t nPrefixes = 0;
+  const Name* lastPrefix = 0;
+  for (Iterator it = nextHops.begin(); it != nextHops.end(); ++it) {
+    if (lastPrefix == 0 || *lastPrefix != it->first) {
+      ++nPrefixes;
+      lastPrefix = &it->first;
+    }
+  }
+  m_nameTree.reserve(m_nameTree.size() + nPrefixes);
+
+  shared_ptr<fib::Entry> entry;
+  for (Iterator it = nextHops.begin(); it != nextHops.end(); ++it) {
+    if (!static_cast<bool>(entry) || entry->getPrefix() != it->first) {
+      entry = this->insert(it->first).first;
+    }
+    entry->addNextHop(it->second.getFace(), it->second.getCost());
+  }
+}
+
 shared_ptr<fib::Entry>
 Fib::findLongestPrefixMatch(const Name& prefix) const
 {
@@ -66,15 +90,15 @@ Fib::findLongestPrefixMatch(const Name& prefix) const
 }
 
 shared_ptr<fib::Entry>
-Fib::findLongestPrefixMatch(shared_ptr<name_tree::Entry> nameTreeEntry) const
+Fib::findLongestPrefixMatch(const shared_ptr<name_tree::Entry>& nameTreeEntry) const
 {
-  shared_ptr<fib::Entry> entry = nameTreeEntry->getFibEntry();
+  const shared_ptr<fib::Entry>& entry = nameTreeEntry->getFibEntry();
   if (static_cast<bool>(entry))
     return entry;
-  nameTreeEntry = m_nameTree.findLongestPrefixMatch(nameTreeEntry,
-                                                    &predicate_NameTreeEntry_hasFibEntry);
-  if (static_cast<bool>(nameTreeEntry)) {
-    return nameTreeEntry->getFibEntry();
+  shared_ptr<name_tree::Entry> match =
+    m_nameTree.findLongestPrefixMatch(nameTreeEntry, &predicate_NameTreeEntry_hasFibEntry);
+  if (static_cast<bool>(match)) {
+    return match->getFibEntry();
   }
   return s_emptyEntry;
 }
@@ -82,7 +106,7 @@ Fib::findLongestPrefixMatch(shared_ptr<name_tree::Entry> nameTreeEntry) const
 shared_ptr<fib::Entry>
 Fib::findLongestPrefixMatch(const pit::Entry& pitEntry) const
 {
-  shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.get(pitEntry);
+  const shared_ptr<name_tree::Entry>& nameTreeEntry = m_nameTree.get(pitEntry);
 
   BOOST_ASSERT(static_cast<bool>(nameTreeEntry));
 
@@ -92,7 +116,7 @@ Fib::findLongestPrefixMatch(const pit::Entry& pitEntry) const
 shared_ptr<fib::Entry>
 Fib::findLongestPrefixMatch(const measurements::Entry& measurementsEntry) const
 {
-  shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.get(measurementsEntry);
+  const shared_ptr<name_tree::Entry>& nameTreeEntry = m_nameTree.get(measurementsEntry);
 
   BOOST_ASSERT(static_cast<bool>(nameTreeEntry));
 
@@ -135,7 +159,7 @@ Fib::erase(const fib::Entry& entry)
 }
 
 void
-Fib::removeNextHopFromAllEntries(shared_ptr<Face> face)
+Fib::removeNextHopFromAllEntries(const shared_ptr<Face>& face)
 {
   for (NameTree::const_iterator it = m_nameTree.fullEnumerate(
        &predicate_NameTreeEntry_hasFibEntry); it != m_nameTree.end();) {
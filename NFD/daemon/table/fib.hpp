@@ -58,6 +58,15 @@ public:
   std::pair<shared_ptr<fib::Entry>, bool>
   insert(const Name& prefix);
 
+  /** \brief inserts FIB entries and adds nexthops to them in one pass
+   *
+   *  Equivalent to insert(prefix).first->addNextHop(face, cost) for every item.
+   *  NameTree is resized upfront, and consecutive items with the same prefix
+   *  share one lookup.
+   */
+  void
+  addNextHops(const std::vector<std::pair<Name, fib::NextHop> >& nextHops);
+
   /// performs a longest prefix match
   shared_ptr<fib::Entry>
   findLongestPrefixMatch(const Name& prefix) const;
@@ -84,7 +93,7 @@ public:
    *  Removing all NextHops in a FIB entry will not remove the FIB entry.
    */
   void
-  removeNextHopFromAllEntries(shared_ptr<Face> face);
+  removeNextHopFromAllEntries(const shared_ptr<Face>& face);
 
   size_t
   size() const;
@@ -127,7 +136,7 @@ public:
 
 private:
   shared_ptr<fib::Entry>
-  findLongestPrefixMatch(shared_ptr<name_tree::Entry> nameTreeEntry) const;
+  findLongestPrefixMatch(const shared_ptr<name_tree::Entry>& nameTreeEntry) const;
 
   void
   erase(shared_ptr<name_tree::Entry> nameTreeEntry);
@@ -27,6 +27,7 @@
 #include "ns3/ndnSIM/NFD/daemon/table/name-tree.hpp"
 #include "ns3/ndnSIM/NFD/daemon/table/pit-entry.hpp"
 #include "ns3/ndnSIM/NFD/daemon/table/fib-entry.hpp"
+#include "ns3/ndn-time.h"
 
 namespace nfd {
 
@@ -57,7 +58,7 @@ Measurements::get(shared_ptr<name_tree::Entry> nameTreeEntry)
   nameTreeEntry->setMeasurementsEntry(entry);
   ++m_nItems;
 
-  entry->m_expiry = time::steady_clock::now() + getInitialLifetime();
+  entry->m_expiry = ns3::ndn::time::steadyNow() + getInitialLifetime();
   entry->m_cleanup = scheduler::schedule(getInitialLifetime(),
                                          bind(&Measurements::cleanup, this, entry));
 
@@ -92,7 +93,7 @@ Measurements::get(const pit::Entry& pitEntry)
 }
 
 shared_ptr<measurements::Entry>
-Measurements::getParent(shared_ptr<measurements::Entry> child)
+Measurements::getParent(const shared_ptr<measurements::Entry>& child)
 {
   BOOST_ASSERT(child);
 
@@ -100,8 +101,8 @@ Measurements::getParent(shared_ptr<measurements::Entry> child)
     return shared_ptr<measurements::Entry>();
   }
 
-  shared_ptr<name_tree::Entry> nameTreeChild = m_nameTree.get(*child);
-  shared_ptr<name_tree::Entry> nameTreeEntry = nameTreeChild->getParent();
+  const shared_ptr<name_tree::Entry>& nameTreeChild = m_nameTree.get(*child);
+  const shared_ptr<name_tree::Entry>& nameTreeEntry = nameTreeChild->getParent();
   if (static_cast<bool>(nameTreeEntry)) {
     return this->get(nameTreeEntry);
   }
@@ -132,17 +133,17 @@ Measurements::findExactMatch(const Name& name) const
 }
 
 void
-Measurements::extendLifetime(shared_ptr<measurements::Entry> entry,
+Measurements::extendLifetime(const shared_ptr<measurements::Entry>& entry,
                              const time::nanoseconds& lifetime)
 {
-  shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.get(*entry);
+  const shared_ptr<name_tree::Entry>& nameTreeEntry = m_nameTree.get(*entry);
   if (!static_cast<bool>(nameTreeEntry) ||
       nameTreeEntry->getMeasurementsEntry().get() != entry.get()) {
     // entry is already gone; it is a dangling reference
     return;
   }
 
-  time::steady_clock::TimePoint expiry = time::steady_clock::now() + lifetime;
+  time::steady_clock::TimePoint expiry = ns3::ndn::time::steadyNow() + lifetime;
   if (entry->m_expiry >= expiry) {
     // has longer lifetime, not extending
     return;
@@ -68,7 +68,7 @@ public:
    *  If child is the root entry, returns null.
    */
   shared_ptr<measurements::Entry>
-  getParent(shared_ptr<measurements::Entry> child);
+  getParent(const shared_ptr<measurements::Entry>& child);
 
   /// perform a longest prefix match
   shared_ptr<measurements::Entry>
@@ -86,7 +86,7 @@ public:
    *  The entry will be kept until at least now()+lifetime.
    */
   void
-  extendLifetime(shared_ptr<measurements::Entry> entry, const time::nanoseconds& lifetime);
+  extendLifetime(const shared_ptr<measurements::Entry>& entry, const time::nanoseconds& lifetime);
 
   size_t
   size() const;
@@ -82,7 +82,7 @@ public:
   void
   setParent(shared_ptr<Entry> parent);
 
-  shared_ptr<Entry>
+  const shared_ptr<Entry>&
   getParent() const;
 
   std::vector<shared_ptr<Entry> >&
@@ -98,7 +98,7 @@ public: // attached table entries
   void
   setFibEntry(shared_ptr<fib::Entry> fibEntry);
 
-  shared_ptr<fib::Entry>
+  const shared_ptr<fib::Entry>&
   getFibEntry() const;
 
   void
@@ -116,13 +116,13 @@ public: // attached table entries
   void
   setMeasurementsEntry(shared_ptr<measurements::Entry> measurementsEntry);
 
-  shared_ptr<measurements::Entry>
+  const shared_ptr<measurements::Entry>&
   getMeasurementsEntry() const;
 
   void
   setStrategyChoiceEntry(shared_ptr<strategy_choice::Entry> strategyChoiceEntry);
 
-  shared_ptr<strategy_choice::Entry>
+  const shared_ptr<strategy_choice::Entry>&
   getStrategyChoiceEntry() const;
 
 private:
@@ -163,7 +163,7 @@ Entry::setHash(size_t hash)
   m_hash = hash;
 }
 
-inline shared_ptr<Entry>
+inline const shared_ptr<Entry>&
 Entry::getParent() const
 {
   return m_parent;
@@ -187,7 +187,7 @@ Entry::hasChildren() const
   return !m_children.empty();
 }
 
-inline shared_ptr<fib::Entry>
+inline const shared_ptr<fib::Entry>&
 Entry::getFibEntry() const
 {
   return m_fibEntry;
@@ -205,13 +205,13 @@ Entry::getPitEntries() const
   return m_pitEntries;
 }
 
-inline shared_ptr<measurements::Entry>
+inline const shared_ptr<measurements::Entry>&
 Entry::getMeasurementsEntry() const
 {
   return m_measurementsEntry;
 }
 
-inline shared_ptr<strategy_choice::Entry>
+inline const shared_ptr<strategy_choice::Entry>&
 Entry::getStrategyChoiceEntry() const
 {
   return m_strategyChoiceEntry;
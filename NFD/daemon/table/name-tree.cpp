@@ -296,14 +296,16 @@ NameTree::findLongestPrefixMatch(const Name& prefix, const name_tree::EntrySelec
 }
 
 shared_ptr<name_tree::Entry>
-NameTree::findLongestPrefixMatch(shared_ptr<name_tree::Entry> entry,
+NameTree::findLongestPrefixMatch(const shared_ptr<name_tree::Entry>& entry,
                                  const name_tree::EntrySelector& entrySelector) const
 {
-  while (static_cast<bool>(entry))
+  // walk up the parent chain by reference; only the match is copied out
+  const shared_ptr<name_tree::Entry>* current = &entry;
+  while (static_cast<bool>(*current))
     {
-      if (entrySelector(*entry))
-        return entry;
-      entry = entry->getParent();
+      if (entrySelector(**current))
+        return *current;
+      current = &(*current)->getParent();
     }
   return shared_ptr<name_tree::Entry>();
 }
@@ -466,6 +468,17 @@ NameTree::findAllMatches(const Name& prefix,
   return end();
 }
 
+void
+NameTree::reserve(size_t nEntries)
+{
+  size_t newNBuckets = m_nBuckets;
+  while (static_cast<size_t>(m_enlargeLoadFactor * static_cast<double>(newNBuckets)) < nEntries)
+    newNBuckets *= m_enlargeFactor;
+
+  if (newNBuckets != m_nBuckets)
+    resize(newNBuckets);
+}
+
 // Hash Table Resize
 void
 NameTree::resize(size_t newNBuckets)
@@ -108,6 +108,14 @@ public: // information
   dump(std::ostream& output) const;
 
 public: // mutation
+  /**
+   * \brief Make room for nEntries entries without resizing the hash table
+   * \details Useful before inserting many entries at once, e.g., when FIB is
+   * populated by a simulation helper.
+   */
+  void
+  reserve(size_t nEntries);
+
   /**
    * \brief Look for the Name Tree Entry that contains this name prefix.
    * \details Starts from the shortest name prefix, and then increase the
@@ -134,19 +142,19 @@ public: // mutation
 
 public: // shortcut access
   /// get NameTree entry from attached FIB entry
-  shared_ptr<name_tree::Entry>
+  const shared_ptr<name_tree::Entry>&
   get(const fib::Entry& fibEntry) const;
 
   /// get NameTree entry from attached PIT entry
-  shared_ptr<name_tree::Entry>
+  const shared_ptr<name_tree::Entry>&
   get(const pit::Entry& pitEntry) const;
 
   /// get NameTree entry from attached Measurements entry
-  shared_ptr<name_tree::Entry>
+  const shared_ptr<name_tree::Entry>&
   get(const measurements::Entry& measurementsEntry) const;
 
   /// get NameTree entry from attached StrategyChoice entry
-  shared_ptr<name_tree::Entry>
+  const shared_ptr<name_tree::Entry>&
   get(const strategy_choice::Entry& strategyChoiceEntry) const;
 
 public: // matching
@@ -169,7 +177,7 @@ public: // matching
                          name_tree::AnyEntry()) const;
 
   shared_ptr<name_tree::Entry>
-  findLongestPrefixMatch(shared_ptr<name_tree::Entry> entry,
+  findLongestPrefixMatch(const shared_ptr<name_tree::Entry>& entry,
                          const name_tree::EntrySelector& entrySelector =
                          name_tree::AnyEntry()) const;
 
@@ -301,25 +309,25 @@ NameTree::getNBuckets() const
   return m_nBuckets;
 }
 
-inline shared_ptr<name_tree::Entry>
+inline const shared_ptr<name_tree::Entry>&
 NameTree::get(const fib::Entry& fibEntry) const
 {
   return fibEntry.m_nameTreeEntry;
 }
 
-inline shared_ptr<name_tree::Entry>
+inline const shared_ptr<name_tree::Entry>&
 NameTree::get(const pit::Entry& pitEntry) const
 {
   return pitEntry.m_nameTreeEntry;
 }
 
-inline shared_ptr<name_tree::Entry>
+inline const shared_ptr<name_tree::Entry>&
 NameTree::get(const measurements::Entry& measurementsEntry) const
 {
   return measurementsEntry.m_nameTreeEntry;
 }
 
-inline shared_ptr<name_tree::Entry>
+inline const shared_ptr<name_tree::Entry>&
 NameTree::get(const strategy_choice::Entry& strategyChoiceEntry) const
 {
   return strategyChoiceEntry.m_nameTreeEntry;
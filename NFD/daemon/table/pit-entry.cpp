@@ -24,6 +24,7 @@
  */
 
 #include "ns3/ndnSIM/NFD/daemon/table/pit-entry.hpp"
+#include "ns3/ndn-time.h"
 #include <algorithm>
 
 namespace nfd {
@@ -88,15 +89,16 @@ Entry::canForwardTo(const Face& face) const
   OutRecordCollection::const_iterator outIt = std::find_if(
     m_outRecords.begin(), m_outRecords.end(),
     bind(&predicate_FaceRecord_Face, _1, &face));
+  time::steady_clock::TimePoint now = ns3::ndn::time::steadyNow();
   bool hasUnexpiredOutRecord = outIt != m_outRecords.end() &&
-                               outIt->getExpiry() >= time::steady_clock::now();
+                               outIt->getExpiry() >= now;
   if (hasUnexpiredOutRecord) {
     return false;
   }
 
   InRecordCollection::const_iterator inIt = std::find_if(
     m_inRecords.begin(), m_inRecords.end(),
-    bind(&predicate_FaceRecord_ne_Face_and_unexpired, _1, &face, time::steady_clock::now()));
+    bind(&predicate_FaceRecord_ne_Face_and_unexpired, _1, &face, now));
   bool hasUnexpiredOtherInRecord = inIt != m_inRecords.end();
   if (!hasUnexpiredOtherInRecord) {
     return false;
@@ -161,7 +163,7 @@ Entry::findNonce(uint32_t nonce, const Face& face) const
 }
 
 InRecordCollection::iterator
-Entry::insertOrUpdateInRecord(shared_ptr<Face> face, const Interest& interest)
+Entry::insertOrUpdateInRecord(const shared_ptr<Face>& face, const Interest& interest)
 {
   InRecordCollection::iterator it = std::find_if(m_inRecords.begin(),
     m_inRecords.end(), bind(&predicate_FaceRecord_Face, _1, face.get()));
@@ -175,7 +177,7 @@ Entry::insertOrUpdateInRecord(shared_ptr<Face> face, const Interest& interest)
 }
 
 InRecordCollection::const_iterator
-Entry::getInRecord(shared_ptr<Face> face) const
+Entry::getInRecord(const shared_ptr<Face>& face) const
 {
   return std::find_if(m_inRecords.begin(), m_inRecords.end(),
                       bind(&predicate_FaceRecord_Face, _1, face.get()));
@@ -188,7 +190,7 @@ Entry::deleteInRecords()
 }
 
 OutRecordCollection::iterator
-Entry::insertOrUpdateOutRecord(shared_ptr<Face> face, const Interest& interest)
+Entry::insertOrUpdateOutRecord(const shared_ptr<Face>& face, const Interest& interest)
 {
   OutRecordCollection::iterator it = std::find_if(m_outRecords.begin(),
     m_outRecords.end(), bind(&predicate_FaceRecord_Face, _1, face.get()));
@@ -202,14 +204,14 @@ Entry::insertOrUpdateOutRecord(shared_ptr<Face> face, const Interest& interest)
 }
 
 OutRecordCollection::const_iterator
-Entry::getOutRecord(shared_ptr<Face> face) const
+Entry::getOutRecord(const shared_ptr<Face>& face) const
 {
   return std::find_if(m_outRecords.begin(), m_outRecords.end(),
                       bind(&predicate_FaceRecord_Face, _1, face.get()));
 }
 
 void
-Entry::deleteOutRecord(shared_ptr<Face> face)
+Entry::deleteOutRecord(const shared_ptr<Face>& face)
 {
   OutRecordCollection::iterator it = std::find_if(m_outRecords.begin(),
     m_outRecords.end(), bind(&predicate_FaceRecord_Face, _1, face.get()));
@@ -228,7 +230,7 @@ bool
 Entry::hasUnexpiredOutRecords() const
 {
   OutRecordCollection::const_iterator it = std::find_if(m_outRecords.begin(),
-    m_outRecords.end(), bind(&predicate_FaceRecord_unexpired, _1, time::steady_clock::now()));
+    m_outRecords.end(), bind(&predicate_FaceRecord_unexpired, _1, ns3::ndn::time::steadyNow()));
   return it != m_outRecords.end();
 }
 
@@ -125,13 +125,13 @@ public: // InRecord
    *  \return an iterator to the InRecord
    */
   InRecordCollection::iterator
-  insertOrUpdateInRecord(shared_ptr<Face> face, const Interest& interest);
+  insertOrUpdateInRecord(const shared_ptr<Face>& face, const Interest& interest);
 
   /** \brief get the InRecord for face
    *  \return an iterator to the InRecord, or .end if it does not exist
    */
   InRecordCollection::const_iterator
-  getInRecord(shared_ptr<Face> face) const;
+  getInRecord(const shared_ptr<Face>& face) const;
 
   /// deletes all InRecords
   void
@@ -147,17 +147,17 @@ public: // OutRecord
    *  \return an iterator to the OutRecord
    */
   OutRecordCollection::iterator
-  insertOrUpdateOutRecord(shared_ptr<Face> face, const Interest& interest);
+  insertOrUpdateOutRecord(const shared_ptr<Face>& face, const Interest& interest);
 
   /** \brief get the OutRecord for face
    *  \return an iterator to the OutRecord, or .end if it does not exist
    */
   OutRecordCollection::const_iterator
-  getOutRecord(shared_ptr<Face> face) const;
+  getOutRecord(const shared_ptr<Face>& face) const;
 
   /// deletes one OutRecord for face if exists
   void
-  deleteOutRecord(shared_ptr<Face> face);
+  deleteOutRecord(const shared_ptr<Face>& face);
 
   /** \return true if there is one or more unexpired OutRecords
    */
@@ -23,11 +23,12 @@
  **/
 
 #include "ns3/ndnSIM/NFD/daemon/table/pit-face-record.hpp"
+#include "ns3/ndn-time.h"
 
 namespace nfd {
 namespace pit {
 
-FaceRecord::FaceRecord(shared_ptr<Face> face)
+FaceRecord::FaceRecord(const shared_ptr<Face>& face)
   : m_face(face)
   , m_lastNonce(0)
   , m_lastRenewed(time::steady_clock::TimePoint::min())
@@ -39,7 +40,7 @@ void
 FaceRecord::update(const Interest& interest)
 {
   m_lastNonce = interest.getNonce();
-  m_lastRenewed = time::steady_clock::now();
+  m_lastRenewed = ns3::ndn::time::steadyNow();
 
   static const time::milliseconds DEFAULT_INTEREST_LIFETIME = time::milliseconds(4000);
   time::milliseconds lifetime = interest.getInterestLifetime();
@@ -41,9 +41,9 @@ class FaceRecord : public StrategyInfoHost
 {
 public:
   explicit
-  FaceRecord(shared_ptr<Face> face);
+  FaceRecord(const shared_ptr<Face>& face);
 
-  shared_ptr<Face>
+  const shared_ptr<Face>&
   getFace() const;
 
   uint32_t
@@ -69,7 +69,7 @@ private:
   time::steady_clock::TimePoint m_expiry;
 };
 
-inline shared_ptr<Face>
+inline const shared_ptr<Face>&
 FaceRecord::getFace() const
 {
   return m_face;
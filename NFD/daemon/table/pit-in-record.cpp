@@ -27,7 +27,7 @@
 namespace nfd {
 namespace pit {
 
-InRecord::InRecord(shared_ptr<Face> face)
+InRecord::InRecord(const shared_ptr<Face>& face)
   : FaceRecord(face)
 {
 }
@@ -27,7 +27,7 @@
 namespace nfd {
 namespace pit {
 
-OutRecord::OutRecord(shared_ptr<Face> face)
+OutRecord::OutRecord(const shared_ptr<Face>& face)
   : FaceRecord(face)
 {
 }
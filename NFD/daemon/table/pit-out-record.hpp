@@ -38,7 +38,7 @@ class OutRecord : public FaceRecord
 {
 public:
   explicit
-  OutRecord(shared_ptr<Face> face);
+  OutRecord(const shared_ptr<Face>& face);
 };
 
 } // namespace pit
@@ -75,7 +75,7 @@ public:
    *  \brief Erase a PIT Entry
    */
   void
-  erase(shared_ptr<pit::Entry> pitEntry);
+  erase(const shared_ptr<pit::Entry>& pitEntry);
 
 private:
   NameTree& m_nameTree;
@@ -47,7 +47,8 @@ bool
 StrategyChoice::hasStrategy(const Name& strategyName, bool isExact) const
 {
   if (isExact) {
-    return m_strategyInstances.count(strategyName) > 0;
+    return m_strategyInstances.count(strategyName) > 0 ||
+           m_strategyFactories.count(strategyName) > 0;
   }
   else {
     return static_cast<bool>(this->getStrategy(strategyName));
@@ -69,9 +70,36 @@ StrategyChoice::install(shared_ptr<Strategy> strategy)
   return true;
 }
 
+bool
+StrategyChoice::install(const Name& strategyName, const StrategyFactory& factory)
+{
+  if (this->hasStrategy(strategyName, true)) {
+    NFD_LOG_ERROR("install(" << strategyName << ") duplicate strategyName");
+    return false;
+  }
+
+  m_strategyFactories[strategyName] = factory;
+  return true;
+}
+
 shared_ptr<fw::Strategy>
 StrategyChoice::getStrategy(const Name& strategyName) const
 {
+  // instantiate strategies that can match, so that the lookup below sees them
+  for (StrategyFactoryTable::iterator it = m_strategyFactories.lower_bound(strategyName);
+       it != m_strategyFactories.end() && strategyName.isPrefixOf(it->first);) {
+    if (it->first.size() - strategyName.size() > 1) {
+      ++it;
+      continue;
+    }
+
+    shared_ptr<Strategy> strategy = it->second();
+    BOOST_ASSERT(strategy->getName() == it->first);
+    NFD_LOG_DEBUG("instantiating " << it->first);
+    m_strategyInstances[it->first] = strategy;
+    it = m_strategyFactories.erase(it);
+  }
+
   shared_ptr<fw::Strategy> candidate;
   for (StrategyInstanceTable::const_iterator it = m_strategyInstances.lower_bound(strategyName);
        it != m_strategyInstances.end() && strategyName.isPrefixOf(it->first); ++it) {
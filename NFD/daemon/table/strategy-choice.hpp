@@ -61,6 +61,15 @@ public: // available Strategy types
   bool
   install(shared_ptr<fw::Strategy> strategy);
 
+  typedef function<shared_ptr<fw::Strategy>()> StrategyFactory;
+
+  /** \brief install a strategy that is instantiated on first use
+   *  \param strategyName versioned strategyName of strategies created by factory
+   *  \return true if installed; false if not installed due to duplicate strategyName
+   */
+  bool
+  install(const Name& strategyName, const StrategyFactory& factory);
+
 public: // Strategy Choice table
   /** \brief set strategy of prefix to be strategyName
    *  \param strategyName the strategy to be used
@@ -165,7 +174,9 @@ private:
   size_t m_nItems;
 
   typedef std::map<Name, shared_ptr<fw::Strategy> > StrategyInstanceTable;
-  StrategyInstanceTable m_strategyInstances;
+  mutable StrategyInstanceTable m_strategyInstances;
+  typedef std::map<Name, StrategyFactory> StrategyFactoryTable;
+  mutable StrategyFactoryTable m_strategyFactories; // strategies not instantiated yet
 };
 
 inline size_t
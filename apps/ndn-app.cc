@@ -20,6 +20,7 @@
 
 #include "ndn-app.h"
 #include "ns3/log.h"
+#include "ns3/ndn-log-level.h"
 #include "ns3/assert.h"
 #include "ns3/packet.h"
 
@@ -28,6 +28,7 @@
 
 #include "ns3/ndn-common.h"
 #include "ns3/ndn-face.h"
+#include "ns3/ndn-app-face.h"
 
 namespace ns3 {
 
@@ -102,7 +103,7 @@ protected:
 
 protected:
   bool m_active;  ///< @brief Flag to indicate that application is active (set by StartApplication and StopApplication)
-  Ptr<Face> m_face;   ///< @brief automatically created application face through which application communicates
+  Ptr<AppFace> m_face; ///< @brief automatically created application face through which application communicates
 
   TracedCallback< shared_ptr<const Interest>,
                  Ptr<App>, Ptr<Face> > m_receivedInterests; ///< @brief App-level trace of received Interests
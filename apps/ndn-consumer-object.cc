@@ -0,0 +1,353 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#include "ndn-consumer-object.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+
+#include "ns3/ndn-app-face.h"
+#include "ns3/ndn-interest.h"
+#include "ns3/ndn-data.h"
+#include "ns3/ndn-rtt-mean-deviation.h"
+#include "ns3/ndnSIM/utils/ndn-fw-hop-count-tag.h"
+#include "ns3/ndnSIM/utils/ndn-virtual-payload-tag.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.ConsumerObject");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED (ConsumerObject);
+
+TypeId
+ConsumerObject::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ndn::ConsumerObject")
+    .SetGroupName ("Ndn")
+    .SetParent<App> ()
+    .AddConstructor<ConsumerObject> ()
+
+    .AddAttribute ("Prefix", "Name prefix of objects",
+                   StringValue ("/"),
+                   MakeNameAccessor (&ConsumerObject::m_prefix),
+                   MakeNameChecker ())
+
+    .AddAttribute ("NumberOfObjects", "Number of objects to fetch, 0 means unlimited",
+                   StringValue ("1"),
+                   MakeUintegerAccessor (&ConsumerObject::m_nObjects),
+                   MakeUintegerChecker<uint32_t> ())
+
+    .AddAttribute ("ObjectRate", "Object request rate (Poisson process)",
+                   StringValue ("1.0"),
+                   MakeDoubleAccessor (&ConsumerObject::m_objectRate),
+                   MakeDoubleChecker<double> (0.0))
+
+    .AddAttribute ("Window", "Maximum number of outstanding Interests per object",
+                   StringValue ("8"),
+                   MakeUintegerAccessor (&ConsumerObject::m_window),
+                   MakeUintegerChecker<uint32_t> (1))
+
+    .AddAttribute ("LifeTime", "LifeTime for interest packet",
+                   StringValue ("2s"),
+                   MakeTimeAccessor (&ConsumerObject::m_interestLifeTime),
+                   MakeTimeChecker ())
+
+    .AddTraceSource ("ObjectFetched",
+                     "All segments of an object are received: object name, completion time, size in bytes and goodput in bits per second",
+                     MakeTraceSourceAccessor (&ConsumerObject::m_objectFetched))
+    ;
+
+  return tid;
+}
+
+ConsumerObject::ConsumerObject ()
+  : m_serial (0)
+  , m_nextObjectId (0)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  m_rtt = CreateObject<RttMeanDeviation> ();
+}
+
+ConsumerObject::~ConsumerObject ()
+{
+}
+
+void
+ConsumerObject::StartApplication ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  App::StartApplication ();
+
+  if (m_objectRate <= 0)
+    NS_FATAL_ERROR ("ObjectRate of ConsumerObject must be positive");
+
+  RequestObject ();
+}
+
+void
+ConsumerObject::StopApplication ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  Simulator::Cancel (m_requestEvent);
+  Simulator::Cancel (m_timeoutEvent);
+
+  App::StopApplication ();
+}
+
+void
+ConsumerObject::RequestObject ()
+{
+  uint32_t objectId = m_nextObjectId++;
+  NS_LOG_INFO ("Requesting object " << objectId);
+
+  Object& object = m_objects[objectId];
+  object.start = Simulator::Now ();
+  object.nSegments = 0;
+  object.nextSegment = 0;
+  object.nReceived = 0;
+  object.nBytes = 0;
+
+  if (m_nObjects == 0 || m_nextObjectId < m_nObjects)
+    {
+      Time next = Seconds (-std::log (1.0 - m_rand.GetValue ()) / m_objectRate);
+      m_requestEvent = Simulator::Schedule (next, &ConsumerObject::RequestObject, this);
+    }
+
+  SendSegments (objectId);
+}
+
+void
+ConsumerObject::SendSegments (uint32_t objectId)
+{
+  while (true)
+    {
+      // look up every time, as the object is only referenced by id
+      std::unordered_map<uint32_t, Object>::iterator found = m_objects.find (objectId);
+      if (found == m_objects.end ())
+        break;
+      Object& object = found->second;
+
+      // only segment 0 until the number of segments is known
+      uint32_t window = object.nSegments == 0 ? 1 : m_window;
+      if (object.outstanding.size () >= window)
+        break;
+
+      if (!object.retx.empty ())
+        {
+          uint32_t segment = object.retx.front ();
+          object.retx.pop_front ();
+          bool isReceived = segment < object.received.size () && object.received[segment];
+          if (!isReceived && object.outstanding.find (segment) == object.outstanding.end ())
+            SendInterest (objectId, segment, true);
+        }
+      else if (object.nSegments == 0 ? object.nextSegment == 0 : object.nextSegment < object.nSegments)
+        {
+          SendInterest (objectId, object.nextSegment++, false);
+        }
+      else
+        break;
+    }
+
+  ScheduleTimeoutEvent ();
+}
+
+void
+ConsumerObject::SendInterest (uint32_t objectId, uint32_t segment, bool isRetx)
+{
+  // register before sending, as Data can be returned from the local cache right away
+  Outstanding& outstanding = m_objects[objectId].outstanding[segment];
+  outstanding.serial = ++m_serial;
+  outstanding.sent = Simulator::Now ();
+  outstanding.isRetx = isRetx;
+
+  SegmentTimeout timeout;
+  timeout.objectId = objectId;
+  timeout.segment = segment;
+  timeout.serial = outstanding.serial;
+  timeout.sent = outstanding.sent;
+  m_timeouts.push_back (timeout);
+
+  shared_ptr<Name> name = make_shared<Name> (m_prefix);
+  name->appendNumber (objectId);
+  name->appendSegment (segment);
+
+  shared_ptr<Interest> interest = make_shared<Interest> ();
+  interest->setNonce (m_rand.GetInteger (0, std::numeric_limits<uint32_t>::max ()));
+  interest->setName (*name);
+  interest->setInterestLifetime (::ndn::time::milliseconds (m_interestLifeTime.GetMilliSeconds ()));
+
+  NS_LOG_INFO ("> Interest for " << objectId << "/" << segment << (isRetx ? " (retransmission)" : ""));
+
+  FwHopCountTag hopCountTag;
+  interest->getPacket ()->AddPacketTag (hopCountTag);
+
+  m_transmittedInterests ((dynamic_cast<::ndn::Interest&>(*interest)).shared_from_this (), this, m_face);
+  m_face->ReceiveInterest (dynamic_cast<::ndn::Interest&>(*interest));
+}
+
+void
+ConsumerObject::OnData (shared_ptr<const ::ndn::Data> data)
+{
+  if (!m_active) return;
+
+  App::OnData (data); // tracing inside
+
+  const Name& name = data->getName ();
+  uint32_t objectId = name.at (-2).toNumber ();
+  uint32_t segment = name.at (-1).toSegment ();
+  NS_LOG_INFO ("< DATA for " << objectId << "/" << segment);
+
+  std::unordered_map<uint32_t, Object>::iterator found = m_objects.find (objectId);
+  if (found == m_objects.end ())
+    return; // object already fetched
+  Object& object = found->second;
+
+  std::unordered_map<uint32_t, Outstanding>::iterator outstanding = object.outstanding.find (segment);
+  if (outstanding != object.outstanding.end ())
+    {
+      if (!outstanding->second.isRetx)
+        {
+          m_rtt->Measurement (Simulator::Now () - outstanding->second.sent);
+          m_rtt->ResetMultiplier ();
+        }
+      object.outstanding.erase (outstanding); // the entry in m_timeouts becomes stale
+    }
+  // otherwise, Data for an Interest that already timed out is still accepted
+
+  if (object.nSegments == 0)
+    {
+      const ::ndn::name::Component& finalBlockId = data->getFinalBlockId ();
+      object.nSegments = finalBlockId.empty () ? segment + 1 : finalBlockId.toSegment () + 1;
+      object.received.resize (object.nSegments, false);
+      NS_LOG_DEBUG ("Object " << objectId << " has " << object.nSegments << " segments");
+    }
+
+  if (segment >= object.nSegments || object.received[segment])
+    return;
+
+  object.received[segment] = true;
+  object.nReceived++;
+
+  const Data& d = static_cast<const Data&>(*data);
+  VirtualPayloadTag virtualPayload;
+  if (d.getPacket ()->PeekPacketTag (virtualPayload))
+    object.nBytes += virtualPayload.Get ();
+  else
+    object.nBytes += data->getContent ().value_size ();
+
+  if (object.nReceived == object.nSegments)
+    {
+      Time completionTime = Simulator::Now () - object.start;
+      double goodput = completionTime.IsStrictlyPositive () ? object.nBytes * 8.0 / completionTime.GetSeconds () : 0.0;
+      NS_LOG_INFO ("Object " << objectId << " fetched in " << completionTime.GetSeconds () << "s");
+
+      uint64_t nBytes = object.nBytes;
+      m_objects.erase (found); // timeouts of the object become stale
+      m_objectFetched (this, name.getPrefix (-1), completionTime, nBytes, goodput);
+      return;
+    }
+
+  SendSegments (objectId);
+}
+
+void
+ConsumerObject::ProcessTimeouts ()
+{
+  Time now = Simulator::Now ();
+  Time retxTimeout = GetRetxTimeout ();
+
+  std::vector<uint32_t> objectIds;
+  while (!m_timeouts.empty ())
+    {
+      const SegmentTimeout& timeout = m_timeouts.front ();
+      if (IsPending (timeout.objectId, timeout.segment, timeout.serial))
+        {
+          if (timeout.sent + retxTimeout > now)
+            break;
+
+          NS_LOG_DEBUG ("Timeout for " << timeout.objectId << "/" << timeout.segment);
+          Object& object = m_objects[timeout.objectId];
+          object.outstanding.erase (timeout.segment);
+          object.retx.push_back (timeout.segment);
+          objectIds.push_back (timeout.objectId);
+
+          m_rtt->IncreaseMultiplier (); // Double the next RTO
+        }
+
+      m_timeouts.pop_front ();
+    }
+
+  for (std::vector<uint32_t>::const_iterator objectId = objectIds.begin (); objectId != objectIds.end (); ++objectId)
+    SendSegments (*objectId);
+
+  ScheduleTimeoutEvent ();
+}
+
+void
+ConsumerObject::ScheduleTimeoutEvent ()
+{
+  // drop timeouts of received segments, so they do not cause useless events
+  while (!m_timeouts.empty () &&
+         !IsPending (m_timeouts.front ().objectId, m_timeouts.front ().segment, m_timeouts.front ().serial))
+    m_timeouts.pop_front ();
+
+  if (m_timeouts.empty ())
+    return;
+
+  Time time = std::max (Simulator::Now (), m_timeouts.front ().sent + GetRetxTimeout ());
+  if (m_timeoutEvent.IsRunning ())
+    {
+      if (Simulator::Now () + Simulator::GetDelayLeft (m_timeoutEvent) <= time)
+        return;
+
+      Simulator::Remove (m_timeoutEvent);
+    }
+
+  m_timeoutEvent = Simulator::Schedule (time - Simulator::Now (), &ConsumerObject::ProcessTimeouts, this);
+}
+
+bool
+ConsumerObject::IsPending (uint32_t objectId, uint32_t segment, uint32_t serial) const
+{
+  std::unordered_map<uint32_t, Object>::const_iterator object = m_objects.find (objectId);
+  if (object == m_objects.end ())
+    return false;
+
+  std::unordered_map<uint32_t, Outstanding>::const_iterator outstanding = object->second.outstanding.find (segment);
+  return outstanding != object->second.outstanding.end () && outstanding->second.serial == serial;
+}
+
+Time
+ConsumerObject::GetRetxTimeout () const
+{
+  return std::min (m_rtt->RetransmitTimeout (), m_interestLifeTime);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#ifndef NDN_CONSUMER_OBJECT_H
+#define NDN_CONSUMER_OBJECT_H
+
+#include "ndn-app.h"
+#include "ns3/random-variable.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/traced-callback.h"
+#include "ns3/ndn-common.h"
+#include "ns3/ndn-rtt-estimator.h"
+
+#include <vector>
+#include <deque>
+#include <unordered_map>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief NDN application fetching segmented objects (e.g., files)
+ *
+ * Objects are requested as a Poisson process with rate ObjectRate (the first one when the
+ * application starts), until NumberOfObjects objects are requested.  Object i is fetched
+ * as segments /Prefix/<i>/<segment> (number and segment components), as served by
+ * ProducerObject.
+ *
+ * The size of an object is not known in advance: segment 0 is requested alone, and its
+ * FinalBlockId gives the number of segments (Data without FinalBlockId is taken as the
+ * last segment).  The remaining segments are pipelined with up to Window outstanding
+ * Interests per object.  Objects are fetched concurrently and independently.
+ *
+ * Segments are retransmitted after the retransmission timeout, estimated from segments
+ * that were not retransmitted (RttMeanDeviation shared by all objects), but not later
+ * than LifeTime.
+ *
+ * When all segments of an object are received, ObjectFetched trace source is fired with
+ * the completion time (since the object was requested) and goodput.
+ */
+class ConsumerObject: public App
+{
+public:
+  static TypeId GetTypeId ();
+
+  ConsumerObject ();
+  virtual ~ConsumerObject ();
+
+  virtual void
+  OnData (shared_ptr<const Data> data);
+
+protected:
+  // from App
+  virtual void
+  StartApplication ();
+
+  virtual void
+  StopApplication ();
+
+private:
+  /**
+   * @brief Start fetching a new object and schedule request of the next one
+   */
+  void
+  RequestObject ();
+
+  /**
+   * @brief Send Interests for segments of the object while its window allows
+   */
+  void
+  SendSegments (uint32_t objectId);
+
+  void
+  SendInterest (uint32_t objectId, uint32_t segment, bool isRetx);
+
+  /**
+   * @brief Retransmit segments whose retransmission timeout expired
+   */
+  void
+  ProcessTimeouts ();
+
+  /**
+   * @brief Arm timeout event for the earliest outstanding segment, if not yet armed for an earlier time
+   */
+  void
+  ScheduleTimeoutEvent ();
+
+  /**
+   * @brief Check that the segment is still waiting for Data of the Interest with this serial
+   */
+  bool
+  IsPending (uint32_t objectId, uint32_t segment, uint32_t serial) const;
+
+  Time
+  GetRetxTimeout () const;
+
+private:
+  Name m_prefix;
+  uint32_t m_nObjects;       ///< @brief 0 means unlimited
+  double m_objectRate;       ///< @brief object request rate (in hertz)
+  uint32_t m_window;         ///< @brief maximum number of outstanding Interests per object
+  Time m_interestLifeTime;
+
+  UniformVariable m_rand;
+  Ptr<RttEstimator> m_rtt;
+
+  struct Outstanding
+  {
+    uint32_t serial;
+    Time sent;
+    bool isRetx;
+  };
+
+  struct Object
+  {
+    Time start;
+    uint32_t nSegments;      ///< @brief 0 until the final segment is known
+    uint32_t nextSegment;    ///< @brief first segment not requested yet
+    uint32_t nReceived;
+    uint64_t nBytes;
+    std::vector<bool> received;
+    std::unordered_map<uint32_t, Outstanding> outstanding; ///< @brief by segment
+    std::deque<uint32_t> retx; ///< @brief segments to request again
+  };
+
+  struct SegmentTimeout
+  {
+    uint32_t objectId;
+    uint32_t segment;
+    uint32_t serial;
+    Time sent;
+  };
+
+  std::unordered_map<uint32_t, Object> m_objects; ///< @brief objects being fetched, by id
+  std::deque<SegmentTimeout> m_timeouts;          ///< @brief ordered by time, may contain stale entries
+  uint32_t m_serial;
+  uint32_t m_nextObjectId;
+
+  EventId m_requestEvent;
+  EventId m_timeoutEvent;
+
+  TracedCallback<Ptr<App> /* app */, const Name& /* object */, Time /* completion time */,
+                 uint64_t /* bytes */, double /* goodput, bits per second */> m_objectFetched;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONSUMER_OBJECT_H
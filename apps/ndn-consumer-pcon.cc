@@ -0,0 +1,258 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#include "ndn-consumer-pcon.h"
+#include "ns3/log.h"
+#include "ns3/ndn-log-level.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.ConsumerPcon");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED (ConsumerPcon);
+
+static const double MIN_WINDOW = 1.0;
+
+TypeId
+ConsumerPcon::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ndn::ConsumerPcon")
+    .SetGroupName ("Ndn")
+    .SetParent<ConsumerWindow> ()
+    .AddConstructor<ConsumerPcon> ()
+
+    .AddAttribute ("CcAlgorithm", "Congestion control algorithm: AIMD (default) or CUBIC",
+                   StringValue ("AIMD"),
+                   MakeStringAccessor (&ConsumerPcon::SetCcAlgorithm, &ConsumerPcon::GetCcAlgorithm),
+                   MakeStringChecker ())
+
+    .AddAttribute ("Beta", "Multiplicative decrease factor of AIMD",
+                   DoubleValue (0.5),
+                   MakeDoubleAccessor (&ConsumerPcon::m_beta),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+
+    .AddAttribute ("CubicBeta", "Multiplicative decrease factor of CUBIC",
+                   DoubleValue (0.7),
+                   MakeDoubleAccessor (&ConsumerPcon::m_cubicBeta),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+
+    .AddAttribute ("CubicC", "Scaling constant of CUBIC (in packets per second cubed)",
+                   DoubleValue (0.4),
+                   MakeDoubleAccessor (&ConsumerPcon::m_cubicC),
+                   MakeDoubleChecker<double> (0.0))
+
+    .AddAttribute ("UseCubicFastConvergence", "Release bandwidth faster when window before decrease keeps shrinking (CUBIC)",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&ConsumerPcon::m_useCubicFastConvergence),
+                   MakeBooleanChecker ())
+
+    .AddAttribute ("UseCwa", "Conservative window adaptation: decrease window at most once per RTT",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&ConsumerPcon::m_useCwa),
+                   MakeBooleanChecker ())
+
+    .AddTraceSource ("CongestionWindow",
+                     "Congestion window in packets (fractional)",
+                     MakeTraceSourceAccessor (&ConsumerPcon::m_cwnd))
+    .AddTraceSource ("Rtt",
+                     "Last RTT sample (Interests that were not retransmitted)",
+                     MakeTraceSourceAccessor (&ConsumerPcon::m_lastRtt))
+    ;
+
+  return tid;
+}
+
+ConsumerPcon::ConsumerPcon ()
+  : m_ccAlgorithm (AIMD)
+  , m_ssthresh (std::numeric_limits<double>::max ())
+  , m_cubicWmax (0)
+  , m_cubicLastWmax (0)
+  , m_recoveryPoint (0)
+  , m_cwnd (MIN_WINDOW)
+{
+}
+
+void
+ConsumerPcon::SetCcAlgorithm (const std::string& value)
+{
+  if (value == "AIMD")
+    m_ccAlgorithm = AIMD;
+  else if (value == "CUBIC")
+    m_ccAlgorithm = CUBIC;
+  else
+    NS_FATAL_ERROR ("Unknown congestion control algorithm [" << value << "], should be AIMD or CUBIC");
+}
+
+std::string
+ConsumerPcon::GetCcAlgorithm () const
+{
+  return m_ccAlgorithm == CUBIC ? "CUBIC" : "AIMD";
+}
+
+void
+ConsumerPcon::StartApplication ()
+{
+  m_cwnd = std::max<double> (MIN_WINDOW, m_initialWindow);
+  m_ssthresh = std::numeric_limits<double>::max ();
+  m_cubicWmax = 0;
+  m_cubicLastWmax = 0;
+  m_cubicLastDecrease = Simulator::Now ();
+  m_recoveryPoint = m_seq;
+  UpdateWindow ();
+
+  ConsumerWindow::StartApplication ();
+}
+
+void
+ConsumerPcon::OnData (shared_ptr<const ::ndn::Data> data)
+{
+  if (!m_active) return;
+
+  uint32_t seq = data->getName ().at (-1).toSequenceNumber ();
+
+  // Karn's algorithm: no samples from retransmitted Interests
+  const SeqState* state = m_seqStates.Find (seq);
+  if (state != 0 && state->sent && state->retxCount == 1)
+    m_lastRtt = Simulator::Now () - state->firstSent;
+
+  bool isMarked = IsCongestionMarked (*data);
+
+  // bypass ConsumerWindow, which would grow the window by one
+  Consumer::OnData (data);
+
+  if (m_inFlight > static_cast<uint32_t> (0)) m_inFlight--;
+
+  if (isMarked)
+    WindowDecrease (seq);
+  else
+    WindowIncrease ();
+
+  NS_LOG_DEBUG ("Window: " << m_cwnd << ", InFlight: " << m_inFlight);
+
+  ScheduleNextPacket ();
+}
+
+void
+ConsumerPcon::OnTimeout (uint32_t sequenceNumber)
+{
+  if (m_inFlight > static_cast<uint32_t> (0)) m_inFlight--;
+
+  WindowDecrease (sequenceNumber);
+
+  NS_LOG_DEBUG ("Window: " << m_cwnd << ", InFlight: " << m_inFlight);
+
+  // bypass ConsumerWindow, which would reset the window
+  Consumer::OnTimeout (sequenceNumber);
+}
+
+void
+ConsumerPcon::OnCongestionSignal (uint32_t sequenceNumber)
+{
+  if (!m_active) return;
+
+  WindowDecrease (sequenceNumber);
+  ScheduleNextPacket ();
+}
+
+bool
+ConsumerPcon::IsCongestionMarked (const ::ndn::Data& data) const
+{
+  return false;
+}
+
+void
+ConsumerPcon::WindowIncrease ()
+{
+  if (m_cwnd < m_ssthresh)
+    {
+      m_cwnd = m_cwnd + 1.0; // slow start
+    }
+  else if (m_ccAlgorithm == AIMD)
+    {
+      m_cwnd = m_cwnd + 1.0 / m_cwnd;
+    }
+  else
+    {
+      // W_cubic (t) = C * (t - K)^3 + W_max, K = cbrt (W_max * (1 - beta) / C)  (RFC 8312)
+      double t = (Simulator::Now () - m_cubicLastDecrease).ToDouble (Time::S);
+      double k = std::cbrt (m_cubicWmax * (1.0 - m_cubicBeta) / m_cubicC);
+      double target = m_cubicC * std::pow (t - k, 3) + m_cubicWmax;
+
+      // the window is never decreased on Data
+      m_cwnd = m_cwnd + std::max (0.0, target - m_cwnd) / m_cwnd;
+    }
+
+  UpdateWindow ();
+}
+
+void
+ConsumerPcon::WindowDecrease (uint32_t sequenceNumber)
+{
+  if (m_useCwa && sequenceNumber < m_recoveryPoint)
+    {
+      NS_LOG_DEBUG ("Ignoring congestion signal for " << sequenceNumber << " (sent before last decrease)");
+      return;
+    }
+  m_recoveryPoint = m_seq;
+
+  if (m_ccAlgorithm == AIMD)
+    {
+      m_ssthresh = m_cwnd * m_beta;
+    }
+  else
+    {
+      if (m_useCubicFastConvergence && m_cwnd < m_cubicLastWmax)
+        {
+          m_cubicLastWmax = m_cwnd;
+          m_cubicWmax = m_cwnd * (1.0 + m_cubicBeta) / 2.0;
+        }
+      else
+        {
+          m_cubicLastWmax = m_cwnd;
+          m_cubicWmax = m_cwnd;
+        }
+
+      m_ssthresh = m_cwnd * m_cubicBeta;
+      m_cubicLastDecrease = Simulator::Now ();
+    }
+
+  m_ssthresh = std::max (MIN_WINDOW, m_ssthresh);
+  m_cwnd = m_ssthresh;
+
+  UpdateWindow ();
+}
+
+void
+ConsumerPcon::UpdateWindow ()
+{
+  m_window = static_cast<uint32_t> (std::max (MIN_WINDOW, std::floor (m_cwnd.Get ())));
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#ifndef NDN_CONSUMER_PCON_H
+#define NDN_CONSUMER_PCON_H
+
+#include "ndn-consumer-window.h"
+#include "ns3/traced-value.h"
+#include "ns3/nstime.h"
+
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Window-based NDN consumer with congestion control
+ *
+ * The window is grown in slow start (by one per Data) until it reaches the slow start
+ * threshold, and in congestion avoidance afterwards: by 1/window per Data with AIMD, or
+ * following the cubic function of the time since the last decrease (RFC 8312) with CUBIC.
+ *
+ * A timeout is taken as a congestion signal and decreases the window multiplicatively (by
+ * Beta with AIMD, CubicBeta with CUBIC).  Timeouts are derived from RTT samples by the
+ * RttMeanDeviation estimator of Consumer.  With UseCwa (conservative window adaptation),
+ * the window is decreased at most once per RTT: signals for Interests sent before the
+ * last decrease are ignored.
+ *
+ * The forwarder does not mark or NACK packets yet.  IsCongestionMarked can be overridden
+ * to recognize congestion marks on Data, and OnCongestionSignal can be called for NACKs or
+ * other explicit signals.
+ *
+ * The window in packets (WindowTrace of ConsumerWindow) is the integer part of the
+ * CongestionWindow, which is never less than one.
+ */
+class ConsumerPcon: public ConsumerWindow
+{
+public:
+  static TypeId GetTypeId ();
+
+  ConsumerPcon ();
+
+  virtual void
+  OnData (shared_ptr<const ::ndn::Data> data);
+
+  virtual void
+  OnTimeout (uint32_t sequenceNumber);
+
+  /**
+   * @brief Explicit congestion signal (e.g., a congestion NACK) for a sequence number
+   *
+   * Only the window is decreased: the Interest stays outstanding and is retransmitted
+   * on timeout as usual.
+   */
+  virtual void
+  OnCongestionSignal (uint32_t sequenceNumber);
+
+protected:
+  // from App
+  virtual void
+  StartApplication ();
+
+  /**
+   * @brief Check whether Data carries a congestion mark
+   *
+   * Marked Data decreases the window instead of increasing it.  Always false by default.
+   * Data received by applications is ns3::ndn::Data, so packet tags can be checked.
+   */
+  virtual bool
+  IsCongestionMarked (const ::ndn::Data& data) const;
+
+  void
+  WindowIncrease ();
+
+  void
+  WindowDecrease (uint32_t sequenceNumber);
+
+private:
+  void
+  SetCcAlgorithm (const std::string& value);
+
+  std::string
+  GetCcAlgorithm () const;
+
+  /**
+   * @brief Set window in packets used by ConsumerWindow from CongestionWindow
+   */
+  void
+  UpdateWindow ();
+
+private:
+  enum CcAlgorithm
+  {
+    AIMD,
+    CUBIC
+  };
+
+  CcAlgorithm m_ccAlgorithm;
+  double m_beta;             ///< @brief AIMD multiplicative decrease factor
+  double m_cubicBeta;        ///< @brief CUBIC multiplicative decrease factor
+  double m_cubicC;           ///< @brief CUBIC scaling constant
+  bool m_useCubicFastConvergence;
+  bool m_useCwa;
+
+  double m_ssthresh;
+  double m_cubicWmax;        ///< @brief window before the last decrease, after fast convergence
+  double m_cubicLastWmax;    ///< @brief window before the last decrease
+  Time m_cubicLastDecrease;
+
+  uint32_t m_recoveryPoint;  ///< @brief with UseCwa, signals for lower sequence numbers are ignored
+
+  TracedValue<double> m_cwnd;
+  TracedValue<Time> m_lastRtt;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONSUMER_PCON_H
@@ -0,0 +1,429 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#include "ndn-consumer-population.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+
+#include "ns3/ndn-app-face.h"
+#include "ns3/ndn-interest.h"
+#include "ns3/ndn-data.h"
+#include "ns3/ndnSIM/utils/ndn-fw-hop-count-tag.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.ConsumerPopulation");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED (ConsumerPopulation);
+
+TypeId
+ConsumerPopulation::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ndn::ConsumerPopulation")
+    .SetGroupName ("Ndn")
+    .SetParent<App> ()
+    .AddConstructor<ConsumerPopulation> ()
+
+    .AddAttribute ("NumberOfUsers", "Number of emulated users",
+                   StringValue ("1000"),
+                   MakeUintegerAccessor (&ConsumerPopulation::m_nUsers),
+                   MakeUintegerChecker<uint32_t> ())
+
+    .AddAttribute ("Frequency", "Request rate of a user in session (Poisson process)",
+                   StringValue ("1.0"),
+                   MakeDoubleAccessor (&ConsumerPopulation::m_frequency),
+                   MakeDoubleChecker<double> (0.0))
+
+    .AddAttribute ("MeanSessionLength", "Mean length of a user session, 0 for users always in session",
+                   StringValue ("0s"),
+                   MakeTimeAccessor (&ConsumerPopulation::m_meanSessionLength),
+                   MakeTimeChecker ())
+
+    .AddAttribute ("MeanOffTime", "Mean time between sessions of a user",
+                   StringValue ("60s"),
+                   MakeTimeAccessor (&ConsumerPopulation::m_meanOffTime),
+                   MakeTimeChecker ())
+
+    .AddAttribute ("NumberOfContents", "Number of the Contents in total",
+                   StringValue ("100"),
+                   MakeUintegerAccessor (&ConsumerPopulation::m_nContents),
+                   MakeUintegerChecker<uint32_t> ())
+
+    .AddAttribute ("q", "parameter of improve rank",
+                   StringValue ("0.7"),
+                   MakeDoubleAccessor (&ConsumerPopulation::m_q),
+                   MakeDoubleChecker<double> ())
+
+    .AddAttribute ("s", "parameter of power",
+                   StringValue ("0.7"),
+                   MakeDoubleAccessor (&ConsumerPopulation::m_s),
+                   MakeDoubleChecker<double> ())
+
+    .AddAttribute ("Prefix", "Name of the Interest",
+                   StringValue ("/"),
+                   MakeNameAccessor (&ConsumerPopulation::m_interestName),
+                   MakeNameChecker ())
+
+    .AddAttribute ("LifeTime", "LifeTime for interest packet",
+                   StringValue ("2s"),
+                   MakeTimeAccessor (&ConsumerPopulation::m_interestLifeTime),
+                   MakeTimeChecker ())
+
+    .AddAttribute ("DelayBinWidth", "Width of a bin of the delay histogram",
+                   StringValue ("10ms"),
+                   MakeTimeAccessor (&ConsumerPopulation::m_delayBinWidth),
+                   MakeTimeChecker ())
+
+    .AddAttribute ("NumberOfDelayBins", "Number of bins of the delay histogram",
+                   StringValue ("100"),
+                   MakeUintegerAccessor (&ConsumerPopulation::m_nDelayBins),
+                   MakeUintegerChecker<uint32_t> (1))
+    ;
+
+  return tid;
+}
+
+ConsumerPopulation::ConsumerPopulation ()
+  : m_nUsers (1000)
+  , m_frequency (1.0)
+  , m_nContents (100)
+  , m_q (0.7)
+  , m_s (0.7)
+  , m_nDelayBins (100)
+  , m_rand (0.0, 1.0)
+  , m_serial (0)
+  , m_nRequests (0)
+  , m_nSatisfied (0)
+  , m_nTimedOut (0)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+ConsumerPopulation::~ConsumerPopulation ()
+{
+}
+
+uint64_t
+ConsumerPopulation::GetNRequests () const
+{
+  return m_nRequests;
+}
+
+uint64_t
+ConsumerPopulation::GetNSatisfied () const
+{
+  return m_nSatisfied;
+}
+
+uint64_t
+ConsumerPopulation::GetNTimedOut () const
+{
+  return m_nTimedOut;
+}
+
+const std::vector<uint64_t>&
+ConsumerPopulation::GetDelayHistogram () const
+{
+  return m_delayHistogram;
+}
+
+std::vector<uint64_t>
+ConsumerPopulation::GetSatisfactionHistogram (uint32_t nBins) const
+{
+  std::vector<uint64_t> histogram (nBins);
+  if (nBins == 0)
+    return histogram;
+
+  for (std::vector<User>::const_iterator user = m_users.begin (); user != m_users.end (); ++user)
+    {
+      if (user->nRequests == 0)
+        continue;
+
+      uint32_t bin = static_cast<uint64_t> (user->nSatisfied) * nBins / user->nRequests;
+      histogram[std::min (bin, nBins - 1)]++;
+    }
+  return histogram;
+}
+
+void
+ConsumerPopulation::StartApplication ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  App::StartApplication ();
+
+  if (m_frequency <= 0)
+    NS_FATAL_ERROR ("Frequency of ConsumerPopulation must be positive");
+
+  m_distribution = ZipfMandelbrotDistribution::Get (m_nContents, m_q, m_s);
+  m_delayHistogram.assign (m_nDelayBins, 0);
+
+  Time now = Simulator::Now ();
+  double sessionShare = 1.0;
+  if (!m_meanSessionLength.IsZero ())
+    {
+      sessionShare = m_meanSessionLength.GetSeconds () /
+        (m_meanSessionLength.GetSeconds () + m_meanOffTime.GetSeconds ());
+    }
+
+  // start in the stationary state: a user is in session with probability proportional to
+  // mean session length, and (as all durations are exponential) remaining times are fresh samples
+  User initial = User ();
+  m_users.assign (m_nUsers, initial);
+  m_userEvents.clear ();
+  m_userEvents.reserve (m_nUsers);
+  for (uint32_t userId = 0; userId < m_nUsers; userId++)
+    {
+      User& user = m_users[userId];
+      UserEvent event;
+      event.userId = userId;
+
+      if (m_meanSessionLength.IsZero ())
+        {
+          user.sessionEnd = Time::Max ();
+          event.time = now + GetExponential (Seconds (1.0 / m_frequency));
+        }
+      else if (m_rand.GetValue () < sessionShare)
+        {
+          user.sessionEnd = now + GetExponential (m_meanSessionLength);
+          event.time = std::min (now + GetExponential (Seconds (1.0 / m_frequency)), user.sessionEnd);
+        }
+      else
+        {
+          event.time = now + GetExponential (m_meanOffTime);
+        }
+      m_userEvents.push_back (event);
+    }
+  std::make_heap (m_userEvents.begin (), m_userEvents.end (), LaterEvent ());
+
+  ScheduleNextEvent ();
+}
+
+void
+ConsumerPopulation::StopApplication ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  Simulator::Cancel (m_event);
+
+  App::StopApplication ();
+}
+
+void
+ConsumerPopulation::ProcessEvents ()
+{
+  Time now = Simulator::Now ();
+
+  ExpireRequests ();
+
+  while (!m_userEvents.empty () && m_userEvents.front ().time <= now)
+    {
+      uint32_t userId = m_userEvents.front ().userId;
+      std::pop_heap (m_userEvents.begin (), m_userEvents.end (), LaterEvent ());
+      m_userEvents.pop_back ();
+
+      ProcessUser (userId);
+    }
+
+  ScheduleNextEvent ();
+}
+
+void
+ConsumerPopulation::ProcessUser (uint32_t userId)
+{
+  Time now = Simulator::Now ();
+  User& user = m_users[userId];
+
+  if (user.sessionEnd.IsZero ())
+    {
+      // idle period is over, start a session
+      user.sessionEnd = now + GetExponential (m_meanSessionLength);
+    }
+  else if (user.sessionEnd <= now)
+    {
+      // session is over
+      user.sessionEnd = Time ();
+      ScheduleUser (userId, now + GetExponential (m_meanOffTime));
+      return;
+    }
+  else
+    {
+      Request (userId);
+    }
+
+  ScheduleUser (userId, std::min (now + GetExponential (Seconds (1.0 / m_frequency)), user.sessionEnd));
+}
+
+void
+ConsumerPopulation::Request (uint32_t userId)
+{
+  m_users[userId].nRequests++;
+  m_nRequests++;
+
+  uint32_t rank = m_distribution->GetRank (1.0 - m_rand.GetValue ()); // uniform in (0, 1]
+
+  Waiting waiting;
+  waiting.userId = userId;
+  waiting.time = Simulator::Now ();
+
+  std::unordered_map<uint32_t, PendingRequest>::iterator pending = m_pending.find (rank);
+  if (pending != m_pending.end ())
+    {
+      NS_LOG_DEBUG ("User " << userId << " joins request for " << rank);
+      pending->second.users.push_back (waiting);
+      return;
+    }
+
+  // register before sending, as Data can be returned from the local cache right away
+  PendingRequest& request = m_pending[rank];
+  request.serial = ++m_serial;
+  request.users.push_back (waiting);
+
+  RequestTimeout timeout;
+  timeout.rank = rank;
+  timeout.serial = request.serial;
+  timeout.time = waiting.time + m_interestLifeTime;
+  m_timeouts.push_back (timeout);
+
+  NS_LOG_INFO ("> Interest for " << rank << " from user " << userId);
+  SendInterest (rank);
+}
+
+void
+ConsumerPopulation::SendInterest (uint32_t rank)
+{
+  shared_ptr<Name> nameWithSequence = make_shared<Name> (m_interestName);
+  nameWithSequence->appendSequenceNumber (rank);
+
+  shared_ptr<Interest> interest = make_shared<Interest> ();
+  interest->setNonce (m_rand.GetInteger (0, std::numeric_limits<uint32_t>::max ()));
+  interest->setName (*nameWithSequence);
+  interest->setInterestLifetime (::ndn::time::milliseconds (m_interestLifeTime.GetMilliSeconds ()));
+
+  FwHopCountTag hopCountTag;
+  interest->getPacket ()->AddPacketTag (hopCountTag);
+
+  m_transmittedInterests ((dynamic_cast<::ndn::Interest&>(*interest)).shared_from_this (), this, m_face);
+  m_face->ReceiveInterest (dynamic_cast<::ndn::Interest&>(*interest));
+}
+
+void
+ConsumerPopulation::OnData (shared_ptr<const Data> data)
+{
+  if (!m_active) return;
+
+  App::OnData (data); // tracing inside
+
+  uint32_t rank = data->getName ().at (-1).toSequenceNumber ();
+  NS_LOG_INFO ("< DATA for " << rank);
+
+  std::unordered_map<uint32_t, PendingRequest>::iterator pending = m_pending.find (rank);
+  if (pending == m_pending.end ())
+    return; // timed out or unsolicited
+
+  Time now = Simulator::Now ();
+  const std::vector<Waiting>& users = pending->second.users;
+  for (std::vector<Waiting>::const_iterator waiting = users.begin (); waiting != users.end (); ++waiting)
+    {
+      m_users[waiting->userId].nSatisfied++;
+
+      uint64_t bin = m_delayBinWidth.IsStrictlyPositive () ?
+        (now - waiting->time).GetTimeStep () / m_delayBinWidth.GetTimeStep () : 0;
+      m_delayHistogram[std::min<uint64_t> (bin, m_delayHistogram.size () - 1)]++;
+    }
+  m_nSatisfied += users.size ();
+
+  // the entry in m_timeouts becomes stale
+  m_pending.erase (pending);
+}
+
+void
+ConsumerPopulation::ExpireRequests ()
+{
+  Time now = Simulator::Now ();
+
+  while (!m_timeouts.empty () && m_timeouts.front ().time <= now)
+    {
+      const RequestTimeout& timeout = m_timeouts.front ();
+
+      std::unordered_map<uint32_t, PendingRequest>::iterator pending = m_pending.find (timeout.rank);
+      if (pending != m_pending.end () && pending->second.serial == timeout.serial)
+        {
+          NS_LOG_DEBUG ("Request for " << timeout.rank << " timed out");
+          m_nTimedOut += pending->second.users.size ();
+          m_pending.erase (pending);
+        }
+
+      m_timeouts.pop_front ();
+    }
+}
+
+void
+ConsumerPopulation::ScheduleUser (uint32_t userId, Time time)
+{
+  UserEvent event;
+  event.time = time;
+  event.userId = userId;
+
+  m_userEvents.push_back (event);
+  std::push_heap (m_userEvents.begin (), m_userEvents.end (), LaterEvent ());
+}
+
+void
+ConsumerPopulation::ScheduleNextEvent ()
+{
+  // drop timeouts of satisfied requests, so they do not cause useless events
+  while (!m_timeouts.empty ())
+    {
+      std::unordered_map<uint32_t, PendingRequest>::iterator pending = m_pending.find (m_timeouts.front ().rank);
+      if (pending != m_pending.end () && pending->second.serial == m_timeouts.front ().serial)
+        break;
+
+      m_timeouts.pop_front ();
+    }
+
+  if (m_userEvents.empty () && m_timeouts.empty ())
+    return;
+
+  Time next = Time::Max ();
+  if (!m_userEvents.empty ())
+    next = m_userEvents.front ().time;
+  if (!m_timeouts.empty ())
+    next = std::min (next, m_timeouts.front ().time);
+
+  m_event = Simulator::Schedule (next - Simulator::Now (),
+                                 &ConsumerPopulation::ProcessEvents, this);
+}
+
+Time
+ConsumerPopulation::GetExponential (Time mean)
+{
+  return Seconds (-mean.GetSeconds () * std::log (1.0 - m_rand.GetValue ()));
+}
+
+} // namespace ndn
+} // namespace ns3
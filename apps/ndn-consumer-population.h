@@ -0,0 +1,219 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#ifndef NDN_CONSUMER_POPULATION_H
+#define NDN_CONSUMER_POPULATION_H
+
+#include "ndn-app.h"
+#include "ns3/random-variable.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/ndn-common.h"
+#include "ns3/ndnSIM/utils/ndn-zipf-mandelbrot-distribution.h"
+
+#include <vector>
+#include <deque>
+#include <unordered_map>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief NDN application emulating a population of independent users behind one AppFace
+ *
+ * Each user alternates between sessions (exponentially distributed length with mean
+ * MeanSessionLength) and idle periods (exponentially distributed with mean MeanOffTime).
+ * During a session, the user requests contents as a Poisson process with rate Frequency,
+ * choosing contents /Prefix/<rank> following Zipf-Mandelbrot distribution.  If
+ * MeanSessionLength is zero, users are always in session.
+ *
+ * Instead of one App, AppFace and timer per user, all users share the face and one event:
+ * next events of all users are kept in a heap, and the application schedules a simulator
+ * event only for the earliest of them.  A user costs a few tens of bytes, so millions of
+ * users can be emulated on one node.
+ *
+ * Requests of different users for a content that is already requested are aggregated, as
+ * the forwarder would do with Interests from separate consumers: no Interest is sent, and
+ * the Data satisfies all of them.  Requests are not retransmitted; a request not satisfied
+ * within LifeTime is counted as timed out.
+ *
+ * Statistics are aggregated rather than traced per user: see GetDelayHistogram and
+ * GetSatisfactionHistogram.
+ */
+class ConsumerPopulation: public App
+{
+public:
+  static TypeId GetTypeId ();
+
+  ConsumerPopulation ();
+  virtual ~ConsumerPopulation ();
+
+  virtual void
+  OnData (shared_ptr<const Data> data);
+
+  /**
+   * @brief Get number of requests made by all users
+   */
+  uint64_t
+  GetNRequests () const;
+
+  /**
+   * @brief Get number of requests satisfied with Data
+   */
+  uint64_t
+  GetNSatisfied () const;
+
+  /**
+   * @brief Get number of requests not satisfied within Interest lifetime
+   */
+  uint64_t
+  GetNTimedOut () const;
+
+  /**
+   * @brief Get histogram of delays between requests and Data
+   *
+   * Bin i counts requests satisfied with delay in [i * DelayBinWidth, (i + 1) * DelayBinWidth),
+   * the last bin also counts all larger delays.
+   */
+  const std::vector<uint64_t>&
+  GetDelayHistogram () const;
+
+  /**
+   * @brief Get histogram of per-user fraction of satisfied requests
+   * @param nBins number of bins
+   *
+   * Bin i counts users that got Data for a fraction in [i / nBins, (i + 1) / nBins) of their
+   * requests (the last bin includes 1).  Users that made no requests are not counted.
+   */
+  std::vector<uint64_t>
+  GetSatisfactionHistogram (uint32_t nBins = 10) const;
+
+protected:
+  // from App
+  virtual void
+  StartApplication ();
+
+  virtual void
+  StopApplication ();
+
+private:
+  /**
+   * @brief Process all user events and Interest timeouts due now, and schedule the next event
+   */
+  void
+  ProcessEvents ();
+
+  void
+  ProcessUser (uint32_t userId);
+
+  void
+  Request (uint32_t userId);
+
+  void
+  ExpireRequests ();
+
+  void
+  ScheduleUser (uint32_t userId, Time time);
+
+  void
+  ScheduleNextEvent ();
+
+  void
+  SendInterest (uint32_t rank);
+
+  Time
+  GetExponential (Time mean);
+
+private:
+  uint32_t m_nUsers;
+  double m_frequency;        ///< @brief request rate of a user in session (in hertz)
+  Time m_meanSessionLength;  ///< @brief 0 means users are always in session
+  Time m_meanOffTime;
+  uint32_t m_nContents;
+  double m_q;
+  double m_s;
+  Name m_interestName;
+  Time m_interestLifeTime;
+  Time m_delayBinWidth;
+  uint32_t m_nDelayBins;
+
+  UniformVariable m_rand;    ///< @brief source of all randomness (request times, contents, nonces)
+  std::shared_ptr<const ZipfMandelbrotDistribution> m_distribution;
+
+  struct User
+  {
+    Time sessionEnd;         ///< @brief end of current session, zero when idle
+    uint32_t nRequests;
+    uint32_t nSatisfied;
+  };
+
+  struct UserEvent
+  {
+    Time time;
+    uint32_t userId;
+  };
+
+  struct LaterEvent
+  {
+    bool
+    operator() (const UserEvent& a, const UserEvent& b) const
+    {
+      return a.time > b.time;
+    }
+  };
+
+  std::vector<User> m_users;
+  std::vector<UserEvent> m_userEvents; ///< @brief min-heap of next event of each user
+  EventId m_event;                     ///< @brief the only scheduled event of the application
+
+  struct Waiting
+  {
+    uint32_t userId;
+    Time time;
+  };
+
+  struct PendingRequest
+  {
+    uint32_t serial;
+    std::vector<Waiting> users;
+  };
+
+  struct RequestTimeout
+  {
+    uint32_t rank;
+    uint32_t serial;
+    Time time;
+  };
+
+  std::unordered_map<uint32_t, PendingRequest> m_pending; ///< @brief requested contents by rank
+  std::deque<RequestTimeout> m_timeouts;                  ///< @brief ordered by time, may contain satisfied requests
+  uint32_t m_serial;
+
+  uint64_t m_nRequests;
+  uint64_t m_nSatisfied;
+  uint64_t m_nTimedOut;
+  std::vector<uint64_t> m_delayHistogram;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONSUMER_POPULATION_H
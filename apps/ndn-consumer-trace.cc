@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#include "ndn-consumer-trace.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+
+#include "ns3/ndn-app-face.h"
+#include "ns3/ndn-interest.h"
+#include "ns3/ndnSIM/utils/ndn-fw-hop-count-tag.h"
+
+#include <algorithm>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.ConsumerTrace");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED (ConsumerTrace);
+
+TypeId
+ConsumerTrace::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ndn::ConsumerTrace")
+    .SetGroupName ("Ndn")
+    .SetParent<App> ()
+    .AddConstructor<ConsumerTrace> ()
+
+    .AddAttribute ("TraceFile", "Request trace to replay (binary or text)",
+                   StringValue (""),
+                   MakeStringAccessor (&ConsumerTrace::m_traceFile),
+                   MakeStringChecker ())
+
+    .AddAttribute ("ShardCount", "Number of applications sharing the trace",
+                   StringValue ("1"),
+                   MakeUintegerAccessor (&ConsumerTrace::m_shardCount),
+                   MakeUintegerChecker<uint32_t> (1))
+
+    .AddAttribute ("ShardIndex", "Index of the application among those sharing the trace (from 0 to ShardCount - 1)",
+                   StringValue ("0"),
+                   MakeUintegerAccessor (&ConsumerTrace::m_shardIndex),
+                   MakeUintegerChecker<uint32_t> ())
+
+    .AddAttribute ("LifeTime", "LifeTime for interest packet",
+                   StringValue ("2s"),
+                   MakeTimeAccessor (&ConsumerTrace::m_interestLifeTime),
+                   MakeTimeChecker ())
+    ;
+
+  return tid;
+}
+
+ConsumerTrace::ConsumerTrace ()
+  : m_nRequests (0)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+ConsumerTrace::~ConsumerTrace ()
+{
+  CloseTrace ();
+}
+
+uint64_t
+ConsumerTrace::GetNRequests () const
+{
+  return m_nRequests;
+}
+
+void
+ConsumerTrace::StartApplication ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  App::StartApplication ();
+
+  if (m_shardIndex >= m_shardCount)
+    NS_FATAL_ERROR ("ShardIndex of ConsumerTrace must be less than ShardCount");
+
+  m_trace = ShardedRequestTraceReader::Open (m_traceFile, m_shardCount, m_shardIndex,
+                                             Simulator::Now ().GetNanoSeconds ());
+  if (m_trace == 0)
+    NS_FATAL_ERROR ("Cannot open shard " << m_shardIndex << " of request trace [" << m_traceFile
+                    << "] with " << m_shardCount << " shards (or the shard is already replayed)");
+
+  // shards replay the trace on one timeline, started by the first of them
+  m_startTime = NanoSeconds (m_trace->GetStartTime ());
+  ScheduleNextRequest ();
+}
+
+void
+ConsumerTrace::StopApplication ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  Simulator::Cancel (m_event);
+  CloseTrace ();
+
+  App::StopApplication ();
+}
+
+void
+ConsumerTrace::ScheduleNextRequest ()
+{
+  int64_t time = 0;
+  bool hasNext = false;
+  try
+    {
+      hasNext = m_trace->Next (m_shardIndex, time, m_nextName);
+    }
+  catch (::ndn::tlv::Error& error)
+    {
+      NS_FATAL_ERROR ("Malformed request in trace [" << m_traceFile << "]: " << error.what ());
+    }
+
+  if (!hasNext)
+    {
+      NS_LOG_INFO ("End of request trace, " << m_nRequests << " Interests sent");
+      CloseTrace ();
+      return;
+    }
+
+  Time delay = std::max (Seconds (0), m_startTime + NanoSeconds (time) - Simulator::Now ());
+  m_event = Simulator::Schedule (delay, &ConsumerTrace::SendRequest, this);
+}
+
+void
+ConsumerTrace::CloseTrace ()
+{
+  if (m_trace == 0)
+    return;
+
+  m_trace->Close (m_shardIndex);
+  m_trace.reset ();
+}
+
+void
+ConsumerTrace::SendRequest ()
+{
+  if (!m_active) return;
+
+  shared_ptr<Interest> interest = make_shared<Interest> ();
+  interest->setNonce (m_rand.GetInteger (0, std::numeric_limits<uint32_t>::max ()));
+  interest->setName (m_nextName);
+  interest->setInterestLifetime (::ndn::time::milliseconds (m_interestLifeTime.GetMilliSeconds ()));
+
+  NS_LOG_INFO ("> Interest for " << m_nextName);
+  m_nRequests++;
+
+  FwHopCountTag hopCountTag;
+  interest->getPacket ()->AddPacketTag (hopCountTag);
+
+  m_transmittedInterests ((dynamic_cast<::ndn::Interest&>(*interest)).shared_from_this (), this, m_face);
+  m_face->ReceiveInterest (dynamic_cast<::ndn::Interest&>(*interest));
+
+  ScheduleNextRequest ();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#ifndef NDN_CONSUMER_TRACE_H
+#define NDN_CONSUMER_TRACE_H
+
+#include "ndn-app.h"
+#include "ns3/random-variable.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/ndn-common.h"
+#include "ns3/ndnSIM/utils/ndn-request-trace.h"
+
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief NDN application replaying a request trace
+ *
+ * Sends an Interest for every request of the TraceFile (binary or text, see
+ * RequestTraceReader) at the request time, counted from the start of the application.
+ *
+ * The trace is read while the simulation runs: only the next request is kept in memory,
+ * and only one event is scheduled at a time, so traces of any length can be replayed.
+ *
+ * A trace can be shared by ShardCount applications (e.g., one per node): the application
+ * with ShardIndex i replays requests i, i + ShardCount, i + 2 * ShardCount, ... of the trace.
+ * The applications read the trace together, once, on the timeline started by the first of
+ * them; an application started later skips the requests of its shard that are already past
+ * (see ShardedRequestTraceReader).
+ *
+ * Interests are not retransmitted.
+ */
+class ConsumerTrace: public App
+{
+public:
+  static TypeId GetTypeId ();
+
+  ConsumerTrace ();
+  virtual ~ConsumerTrace ();
+
+  /**
+   * @brief Get number of Interests sent so far
+   */
+  uint64_t
+  GetNRequests () const;
+
+protected:
+  // from App
+  virtual void
+  StartApplication ();
+
+  virtual void
+  StopApplication ();
+
+private:
+  /**
+   * @brief Read the next request of this shard and schedule it
+   */
+  void
+  ScheduleNextRequest ();
+
+  /**
+   * @brief Release the trace, requests of this shard are not read anymore
+   */
+  void
+  CloseTrace ();
+
+  void
+  SendRequest ();
+
+private:
+  std::string m_traceFile;
+  uint32_t m_shardCount;
+  uint32_t m_shardIndex;
+  Time m_interestLifeTime;
+
+  UniformVariable m_rand; ///< @brief nonce generator
+
+  shared_ptr<ShardedRequestTraceReader> m_trace;
+  Time m_startTime;
+  Name m_nextName;        ///< @brief name of the scheduled request
+  EventId m_event;        ///< @brief the only scheduled event of the application
+
+  uint64_t m_nRequests;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONSUMER_TRACE_H
@@ -21,6 +21,7 @@
 #include "ndn-consumer-window.h"
 #include "ns3/ptr.h"
 #include "ns3/log.h"
+#include "ns3/ndn-log-level.h"
 #include "ns3/simulator.h"
 #include "ns3/packet.h"
 #include "ns3/callback.h"
@@ -97,6 +97,7 @@ private:
   uint32_t m_payloadSize; // expected payload size
   double   m_maxSize; // max size to request
 
+protected:
   uint32_t m_initialWindow;
   bool m_setInitialWindowOnTimeout;
 
@@ -22,11 +22,10 @@
 
 #include "ns3/ndn-app-face.h"
 #include "ns3/ndn-interest.h"
+#include "ns3/ndn-log-level.h"
 
 #include "ns3/ndnSIM/utils/ndn-fw-hop-count-tag.h"
 
-#include <math.h>
-
 
 NS_LOG_COMPONENT_DEFINE ("ndn.ConsumerZipfMandelbrot");
 
@@ -83,19 +82,7 @@ ConsumerZipfMandelbrot::SetNumberOfContents (uint32_t numOfContents)
 
   NS_LOG_DEBUG (m_q << " and " << m_s << " and " << m_N);
 
-  m_Pcum = std::vector<double> (m_N + 1);
-
-  m_Pcum[0] = 0.0;
-  for (uint32_t i=1; i<=m_N; i++)
-    {
-      m_Pcum[i] = m_Pcum[i-1] + 1.0 / std::pow(i+m_q, m_s);
-    }
-
-  for (uint32_t i=1; i<=m_N; i++)
-    {
-      m_Pcum[i] = m_Pcum[i] / m_Pcum[m_N];
-      NS_LOG_LOGIC ("Cumulative probability [" << i << "]=" << m_Pcum[i]);
-  }
+  m_distribution.reset ();
 }
 
 uint32_t
@@ -108,7 +95,7 @@ void
 ConsumerZipfMandelbrot::SetQ (double q)
 {
   m_q = q;
-  SetNumberOfContents (m_N);
+  m_distribution.reset ();
 }
 
 double
@@ -121,7 +108,7 @@ void
 ConsumerZipfMandelbrot::SetS (double s)
 {
   m_s = s;
-  SetNumberOfContents (m_N);
+  m_distribution.reset ();
 }
 
 double
@@ -140,24 +127,11 @@ ConsumerZipfMandelbrot::SendPacket() {
 
   // std::cout << Simulator::Now ().ToDouble (Time::S) << "s max -> " << m_seqMax << "\n";
 
-  while (m_retxSeqs.size ())
+  if (PopRetxSeq (seq))
     {
-      seq = *m_retxSeqs.begin ();
-      m_retxSeqs.erase (m_retxSeqs.begin ());
-
-      // NS_ASSERT (m_seqLifetimes.find (seq) != m_seqLifetimes.end ());
-      // if (m_seqLifetimes.find (seq)->time <= Simulator::Now ())
-      //   {
-
-      //     NS_LOG_DEBUG ("Expire " << seq);
-      //     m_seqLifetimes.erase (seq); // lifetime expired. Trying to find another unexpired sequence number
-      //     continue;
-      //   }
       NS_LOG_DEBUG("=interest seq "<<seq<<" from m_retxSeqs");
-      break;
     }
-
-  if (seq == std::numeric_limits<uint32_t>::max ()) //no retransmission
+  else //no retransmission
     {
       if (m_seqMax != std::numeric_limits<uint32_t>::max ())
         {
@@ -184,23 +158,14 @@ ConsumerZipfMandelbrot::SendPacket() {
 
   // NS_LOG_INFO ("Requesting Interest: \n" << *interest);
   NS_LOG_INFO ("> Interest for " << seq<<", Total: "<<m_seq<<", face: "<<m_face->GetId());
-  NS_LOG_DEBUG ("Trying to add " << seq << " with " << Simulator::Now () << ". already " << m_seqTimeouts.size () << " items");
 
-  m_seqTimeouts.insert (SeqTimeout (seq, Simulator::Now ()));
-  m_seqFullDelay.insert (SeqTimeout (seq, Simulator::Now ()));
-
-  m_seqLastDelay.erase (seq);
-  m_seqLastDelay.insert (SeqTimeout (seq, Simulator::Now ()));
-
-  m_seqRetxCounts[seq] ++;
-
-  m_rtt->SentSeq (SequenceNumber32 (seq), 1);
+  WillSendOutInterest (seq);
 
   FwHopCountTag hopCountTag;
   interest->getPacket ()->AddPacketTag (hopCountTag);
 
   m_transmittedInterests ((dynamic_cast<::ndn::Interest&>(*interest)).shared_from_this (), this, m_face);
-  m_face->onReceiveInterest (dynamic_cast<::ndn::Interest&>(*interest));
+  m_face->ReceiveInterest (dynamic_cast<::ndn::Interest&>(*interest));
 
   ConsumerZipfMandelbrot::ScheduleNextPacket ();
 }
@@ -209,8 +174,10 @@ ConsumerZipfMandelbrot::SendPacket() {
 uint32_t
 ConsumerZipfMandelbrot::GetNextSeq()
 {
-  uint32_t content_index = 1; //[1, m_N]
-  double p_sum = 0;
+  if (m_distribution == nullptr)
+    {
+      m_distribution = ZipfMandelbrotDistribution::Get (m_N, m_q, m_s);
+    }
 
   double p_random = m_SeqRng.GetValue();
   while (p_random == 0)
@@ -219,16 +186,9 @@ ConsumerZipfMandelbrot::GetNextSeq()
     }
   //if (p_random == 0)
   NS_LOG_LOGIC("p_random="<<p_random);
-  for (uint32_t i=1; i<=m_N; i++)
-    {
-      p_sum = m_Pcum[i];   //m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1], p_cum[2] = p[1] + p[2]
-      if (p_random <= p_sum)
-        {
-          content_index = i;
-          break;
-        } //if
-    } //for
-  //content_index = 1;
+
+  // smallest content_index in [1, m_N] with cumulative probability >= p_random
+  uint32_t content_index = m_distribution->GetRank (p_random);
   NS_LOG_DEBUG("RandomNumber="<<content_index);
   return content_index;
 }
@@ -33,6 +33,7 @@
 #include "ns3/double.h"
 #include "ndn-consumer-cbr.h"
 #include "ns3/random-variable.h"
+#include "ns3/ndnSIM/utils/ndn-zipf-mandelbrot-distribution.h"
 
 namespace ns3 {
 namespace ndn {
@@ -43,6 +44,8 @@ namespace ndn {
  *
  * The class implements an app which requests contents following Zipf-Mandelbrot Distribution
  * Here is the explaination of Zipf-Mandelbrot Distribution: http://en.wikipedia.org/wiki/Zipf%E2%80%93Mandelbrot_law
+ *
+ * All consumers with the same NumberOfContents, q and s share one ZipfMandelbrotDistribution.
  */
 class ConsumerZipfMandelbrot: public ConsumerCbr
 {
@@ -87,7 +90,7 @@ private:
   uint32_t m_N;  //number of the contents
   double m_q;  //q in (k+q)^s
   double m_s;  //s in (k+q)^s
-  std::vector<double> m_Pcum;  //cumulative probability
+  std::shared_ptr<const ZipfMandelbrotDistribution> m_distribution; // built on first use
 
   UniformVariable m_SeqRng; //RNG
 };
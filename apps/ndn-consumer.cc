@@ -21,6 +21,7 @@
 #include "ndn-consumer.h"
 #include "ns3/ptr.h"
 #include "ns3/log.h"
+#include "ns3/ndn-log-level.h"
 #include "ns3/simulator.h"
 #include "ns3/packet.h"
 #include "ns3/callback.h"
@@ -38,6 +39,9 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/ref.hpp>
 
+#include <algorithm>
+#include <functional>
+
 NS_LOG_COMPONENT_DEFINE ("ndn.Consumer");
 
 namespace ns3 {
@@ -66,7 +70,7 @@ Consumer::GetTypeId (void)
                    MakeTimeChecker ())
 
     .AddAttribute ("RetxTimer",
-                   "Timeout defining how frequent retransmission timeouts should be checked",
+                   "Timeout defining how frequent retransmission timeouts can be checked",
                    StringValue ("50ms"),
                    MakeTimeAccessor (&Consumer::GetRetxTimer, &Consumer::SetRetxTimer),
                    MakeTimeChecker ())
@@ -85,6 +89,9 @@ Consumer::Consumer ()
   : m_rand (0, std::numeric_limits<uint32_t>::max ())
   , m_seq (0)
   , m_seqMax (0) // don't request anything
+  , m_seqTimeoutsHead (0)
+  , m_seqTimeoutSerial (0)
+  , m_nOutstanding (0)
 {
   NS_LOG_FUNCTION_NOARGS ();
 
@@ -95,6 +102,7 @@ void
 Consumer::SetRetxTimer (Time retxTimer)
 {
   m_retxTimer = retxTimer;
+  m_retxTimerOrigin = Simulator::Now ();
   if (m_retxEvent.IsRunning ())
     {
       // m_retxEvent.Cancel (); // cancel any scheduled cleanup events
@@ -102,8 +110,7 @@ Consumer::SetRetxTimer (Time retxTimer)
     }
 
   // schedule even with new timeout
-  m_retxEvent = Simulator::Schedule (m_retxTimer,
-                                     &Consumer::CheckRetxTimeout, this);
+  ScheduleRetxTimeout ();
 }
 
 Time
@@ -112,6 +119,27 @@ Consumer::GetRetxTimer () const
   return m_retxTimer;
 }
 
+bool
+Consumer::PopRetxSeq (uint32_t& sequenceNumber)
+{
+  while (!m_retxSeqs.empty ())
+    {
+      std::pop_heap (m_retxSeqs.begin (), m_retxSeqs.end (), std::greater<uint32_t> ());
+      uint32_t seq = m_retxSeqs.back ();
+      m_retxSeqs.pop_back ();
+
+      // skip sequence numbers satisfied or already taken after being queued
+      SeqState* state = m_seqStates.Find (seq);
+      if (state == 0 || !state->pendingRetx)
+        continue;
+
+      state->pendingRetx = false;
+      sequenceNumber = seq;
+      return true;
+    }
+  return false;
+}
+
 void
 Consumer::CheckRetxTimeout ()
 {
@@ -120,21 +148,79 @@ Consumer::CheckRetxTimeout ()
   Time rto = m_rtt->RetransmitTimeout ();
   // NS_LOG_DEBUG ("Current RTO: " << rto.ToDouble (Time::S) << "s");
 
-  while (!m_seqTimeouts.empty ())
+  while (m_seqTimeoutsHead < m_seqTimeouts.size ())
     {
-      SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry =
-        m_seqTimeouts.get<i_timestamp> ().begin ();
-      if (entry->time + rto <= now) // timeout expired?
+      // copy, as OnTimeout may append to m_seqTimeouts
+      SeqTimeout entry = m_seqTimeouts[m_seqTimeoutsHead];
+
+      SeqState* state = m_seqStates.Find (entry.seq);
+      if (state == 0 || !state->outstanding || state->timeoutSerial != entry.serial)
+        {
+          m_seqTimeoutsHead++; // stale entry
+          continue;
+        }
+
+      if (entry.time + rto <= now) // timeout expired?
         {
-          uint32_t seqNo = entry->seq;
-          m_seqTimeouts.get<i_timestamp> ().erase (entry);
-          OnTimeout (seqNo);
+          m_seqTimeoutsHead++;
+          state->outstanding = false;
+          m_nOutstanding--;
+          OnTimeout (entry.seq);
         }
       else
         break; // nothing else to do. All later packets need not be retransmitted
     }
 
-  m_retxEvent = Simulator::Schedule (m_retxTimer,
+  ScheduleRetxTimeout ();
+}
+
+void
+Consumer::ScheduleRetxTimeout ()
+{
+  // skip entries of sequence numbers that got Data or were resent after timeout
+  while (m_seqTimeoutsHead < m_seqTimeouts.size ())
+    {
+      const SeqTimeout& entry = m_seqTimeouts[m_seqTimeoutsHead];
+      SeqState* state = m_seqStates.Find (entry.seq);
+      if (state != 0 && state->outstanding && state->timeoutSerial == entry.serial)
+        break;
+
+      m_seqTimeoutsHead++;
+    }
+
+  // reclaim space of processed entries, keeping the amortized cost constant
+  if (m_seqTimeoutsHead == m_seqTimeouts.size ())
+    {
+      m_seqTimeouts.clear ();
+      m_seqTimeoutsHead = 0;
+      return; // nothing outstanding, leave the timer disarmed
+    }
+  else if (2 * m_seqTimeoutsHead > m_seqTimeouts.size ())
+    {
+      m_seqTimeouts.erase (m_seqTimeouts.begin (), m_seqTimeouts.begin () + m_seqTimeoutsHead);
+      m_seqTimeoutsHead = 0;
+    }
+
+  Time now = Simulator::Now ();
+  Time deadline = std::max (now, m_seqTimeouts[m_seqTimeoutsHead].time + m_rtt->RetransmitTimeout ());
+
+  // fire at the same moments as a check running every m_retxTimer would
+  if (m_retxTimer.IsStrictlyPositive ())
+    {
+      int64_t period = m_retxTimer.GetTimeStep ();
+      int64_t ticks = ((deadline - m_retxTimerOrigin).GetTimeStep () + period - 1) / period;
+      deadline = m_retxTimerOrigin + TimeStep (std::max<int64_t> (ticks, 1) * period);
+    }
+
+  if (m_retxEvent.IsRunning ())
+    {
+      if (now + Simulator::GetDelayLeft (m_retxEvent) <= deadline)
+        return; // CheckRetxTimeout will re-arm the timer if needed
+
+      Simulator::Remove (m_retxEvent);
+    }
+
+  m_retxEvent = Simulator::Schedule (deadline - now,
                                      &Consumer::CheckRetxTimeout, this);
 }
 
@@ -171,14 +257,7 @@ Consumer::SendPacket ()
 
   uint32_t seq=std::numeric_limits<uint32_t>::max (); //invalid
 
-  while (m_retxSeqs.size ())
-    {
-      seq = *m_retxSeqs.begin ();
-      m_retxSeqs.erase (m_retxSeqs.begin ());
-      break;
-    }
-
-  if (seq == std::numeric_limits<uint32_t>::max ())
+  if (!PopRetxSeq (seq))
     {
       if (m_seqMax != std::numeric_limits<uint32_t>::max ())
         {
@@ -212,7 +291,7 @@ Consumer::SendPacket ()
   interest->getPacket ()->AddPacketTag (hopCountTag);
 
   m_transmittedInterests ((dynamic_cast<::ndn::Interest&>(*interest)).shared_from_this (), this, m_face);
-  m_face->onReceiveInterest (dynamic_cast<::ndn::Interest&>(*interest));
+  m_face->ReceiveInterest (dynamic_cast<::ndn::Interest&>(*interest));
 
   ScheduleNextPacket ();
 }
@@ -245,26 +324,26 @@ Consumer::OnData (shared_ptr<const ::ndn::Data> data)
       // NS_LOG_DEBUG ("Hop count: " << hopCountTag.Get() << "\n");
     }
 
-  SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find (seq);
-  if (entry != m_seqLastDelay.end ())
+  SeqState* state = m_seqStates.Find (seq);
+  if (state != 0)
     {
-      m_lastRetransmittedInterestDataDelay (this, seq, Simulator::Now () - entry->time, hopCount);
-    }
-
-  entry = m_seqFullDelay.find (seq);
-  if (entry != m_seqFullDelay.end ())
-    {
-      m_firstInterestDataDelay (this, seq, Simulator::Now () - entry->time, m_seqRetxCounts[seq], hopCount);
-    }
+      // copy, as the state is removed before firing the traces
+      SeqState entry = *state;
 
-  m_seqRetxCounts.erase (seq);
-  m_seqFullDelay.erase (seq);
-  m_seqLastDelay.erase (seq);
+      if (entry.outstanding)
+        m_nOutstanding--;
+      m_seqStates.Erase (seq); // any queued timeout or retransmission becomes stale
 
-  m_seqTimeouts.erase (seq);
-  m_retxSeqs.erase (seq);
+      if (entry.sent)
+        {
+          m_lastRetransmittedInterestDataDelay (this, seq, Simulator::Now () - entry.lastSent, hopCount);
+          m_firstInterestDataDelay (this, seq, Simulator::Now () - entry.firstSent, entry.retxCount, hopCount);
+        }
+    }
 
   m_rtt->AckSeq (SequenceNumber32 (seq));
+
+  ScheduleRetxTimeout (); // retransmission timeout may have been reduced
 }
 
 // void
@@ -302,22 +381,43 @@ Consumer::OnTimeout (uint32_t sequenceNumber)
 
   m_rtt->IncreaseMultiplier ();             // Double the next RTO
   m_rtt->SentSeq (SequenceNumber32 (sequenceNumber), 1); // make sure to disable RTT calculation for this sample
-  m_retxSeqs.insert (sequenceNumber);
+
+  SeqState& state = m_seqStates.Insert (sequenceNumber);
+  if (!state.pendingRetx)
+    {
+      state.pendingRetx = true;
+      m_retxSeqs.push_back (sequenceNumber);
+      std::push_heap (m_retxSeqs.begin (), m_retxSeqs.end (), std::greater<uint32_t> ());
+    }
   ScheduleNextPacket ();
 }
 
 void
 Consumer::WillSendOutInterest (uint32_t sequenceNumber)
 {
-  NS_LOG_DEBUG ("Trying to add " << sequenceNumber << " with " << Simulator::Now () << ". already " << m_seqTimeouts.size () << " items");
+  NS_LOG_DEBUG ("Trying to add " << sequenceNumber << " with " << Simulator::Now () << ". already " << m_nOutstanding << " items");
 
-  m_seqTimeouts.insert (SeqTimeout (sequenceNumber, Simulator::Now ()));
-  m_seqFullDelay.insert (SeqTimeout (sequenceNumber, Simulator::Now ()));
+  Time now = Simulator::Now ();
+  SeqState& state = m_seqStates.Insert (sequenceNumber);
+
+  if (!state.outstanding) // otherwise, keep the earlier timeout
+    {
+      state.outstanding = true;
+      state.timeoutSerial = ++m_seqTimeoutSerial;
+      m_seqTimeouts.push_back (SeqTimeout (sequenceNumber, state.timeoutSerial, now));
+      m_nOutstanding++;
 
-  m_seqLastDelay.erase (sequenceNumber);
-  m_seqLastDelay.insert (SeqTimeout (sequenceNumber, Simulator::Now ()));
+      if (!m_retxEvent.IsRunning ())
+        ScheduleRetxTimeout ();
+    }
 
-  m_seqRetxCounts[sequenceNumber] ++;
+  if (!state.sent)
+    {
+      state.sent = true;
+      state.firstSent = now;
+    }
+  state.lastSent = now;
+  state.retxCount++;
 
   m_rtt->SentSeq (SequenceNumber32 (sequenceNumber), 1);
 }
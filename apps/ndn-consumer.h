@@ -29,14 +29,9 @@
 #include "ns3/ndn-rtt-estimator.h"
 #include "ns3/ndn-fw-hop-count-tag.h"
 #include "ns3/ndn-common.h"
+#include "ns3/ndnSIM/utils/ndn-seq-state-table.h"
 
-#include <set>
-#include <map>
-
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/tag.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/member.hpp>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -111,19 +106,38 @@ protected:
   CheckRetxTimeout ();
 
   /**
-   * \brief Modifies the frequency of checking the retransmission timeouts
-   * \param retxTimer Timeout defining how frequent retransmission timeouts should be checked
+   * \brief Arms the retransmission timer for the earliest outstanding Interest
+   *
+   * The timer fires at the first multiple of RetxTimer (counting from when it was set) at which
+   * the earliest timeout expires.  It is re-armed only if that moment becomes earlier than the
+   * scheduled one; otherwise, CheckRetxTimeout re-arms it when it fires.  Nothing is scheduled
+   * when no Interest is outstanding.
+   */
+  void
+  ScheduleRetxTimeout ();
+
+  /**
+   * \brief Modifies the granularity of retransmission timeouts
+   * \param retxTimer Timeout defining how frequent retransmission timeouts can be checked
    */
   void
   SetRetxTimer (Time retxTimer);
 
   /**
-   * \brief Returns the frequency of checking the retransmission timeouts
-   * \return Timeout defining how frequent retransmission timeouts should be checked
+   * \brief Returns the granularity of retransmission timeouts
+   * \return Timeout defining how frequent retransmission timeouts can be checked
    */
   Time
   GetRetxTimer () const;
 
+  /**
+   * \brief Take the smallest sequence number waiting for retransmission
+   * \param[out] sequenceNumber the sequence number
+   * \return false if there is nothing to retransmit
+   */
+  bool
+  PopRetxSeq (uint32_t& sequenceNumber);
+
 protected:
   UniformVariable m_rand; ///< @brief nonce generator
 
@@ -131,6 +145,7 @@ protected:
   uint32_t        m_seqMax;    ///< @brief maximum number of sequence number
   EventId         m_sendEvent; ///< @brief EventId of pending "send packet" event
   Time            m_retxTimer; ///< @brief Currently estimated retransmission timer
+  Time            m_retxTimerOrigin; ///< @brief Time when m_retxTimer was set, retransmission timeouts are checked at multiples of m_retxTimer since then
   EventId         m_retxEvent; ///< @brief Event to check whether or not retransmission should be performed
 
   Ptr<RttEstimator> m_rtt; ///< @brief RTT estimator
@@ -141,54 +156,29 @@ protected:
 
 /// @cond include_hidden
   /**
-   * \struct This struct contains sequence numbers of packets to be retransmitted
-   */
-  struct RetxSeqsContainer :
-    public std::set<uint32_t> { };
-
-  RetxSeqsContainer m_retxSeqs;             ///< \brief ordered set of sequence numbers to be retransmitted
-
-  /**
-   * \struct This struct contains a pair of packet sequence number and its timeout
+   * \brief Retransmission timeout of an outstanding sequence number
+   *
+   * Entries are appended in the order of sending, so the queue is also ordered by time.
+   * An entry is stale when its serial differs from SeqState::timeoutSerial, i.e., Data
+   * was received or the timeout was already processed.
    */
   struct SeqTimeout
   {
-    SeqTimeout (uint32_t _seq, Time _time) : seq (_seq), time (_time) { }
+    SeqTimeout (uint32_t _seq, uint32_t _serial, Time _time) : seq (_seq), serial (_serial), time (_time) { }
 
     uint32_t seq;
+    uint32_t serial;
     Time time;
   };
-/// @endcond
 
-/// @cond include_hidden
-  class i_seq { };
-  class i_timestamp { };
-/// @endcond
+  SeqStateTable m_seqStates;             ///< \brief state of sent and to be retransmitted sequence numbers
 
-/// @cond include_hidden
-  /**
-   * \struct This struct contains a multi-index for the set of SeqTimeout structs
-   */
-  struct SeqTimeoutsContainer :
-    public boost::multi_index::multi_index_container<
-    SeqTimeout,
-    boost::multi_index::indexed_by<
-      boost::multi_index::ordered_unique<
-        boost::multi_index::tag<i_seq>,
-        boost::multi_index::member<SeqTimeout, uint32_t, &SeqTimeout::seq>
-        >,
-      boost::multi_index::ordered_non_unique<
-        boost::multi_index::tag<i_timestamp>,
-        boost::multi_index::member<SeqTimeout, Time, &SeqTimeout::time>
-        >
-      >
-    > { } ;
-
-  SeqTimeoutsContainer m_seqTimeouts;       ///< \brief multi-index for the set of SeqTimeout structs
-
-  SeqTimeoutsContainer m_seqLastDelay;
-  SeqTimeoutsContainer m_seqFullDelay;
-  std::map<uint32_t, uint32_t> m_seqRetxCounts;
+  std::vector<SeqTimeout> m_seqTimeouts; ///< \brief FIFO of retransmission timeouts (starting at m_seqTimeoutsHead)
+  size_t m_seqTimeoutsHead;
+  uint32_t m_seqTimeoutSerial;           ///< \brief serial of the last SeqTimeout
+  size_t m_nOutstanding;                 ///< \brief number of sequence numbers waiting for Data or timeout
+
+  std::vector<uint32_t> m_retxSeqs;      ///< \brief min-heap of sequence numbers to be retransmitted (may contain stale ones)
 
   TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */,
                  Time /* delay */, int32_t /*hop count*/> m_lastRetransmittedInterestDataDelay;
@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#include "ndn-producer-object.h"
+#include "ns3/log.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/packet.h"
+
+#include "ns3/ndn-app-face.h"
+#include "ns3/ndn-fib-helper.h"
+#include "ns3/ndn-fw-hop-count-tag.h"
+#include "ns3/ndn-interest.h"
+#include "ns3/ndn-data.h"
+#include "ns3/ndn-virtual-payload-tag.h"
+
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.ProducerObject");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED (ProducerObject);
+
+TypeId
+ProducerObject::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ndn::ProducerObject")
+    .SetGroupName ("Ndn")
+    .SetParent<App> ()
+    .AddConstructor<ProducerObject> ()
+    .AddAttribute ("Prefix", "Prefix, for which producer has the objects",
+                   StringValue ("/"),
+                   MakeNameAccessor (&ProducerObject::m_prefix),
+                   MakeNameChecker ())
+    .AddAttribute ("ObjectSize", "Size of every object in bytes",
+                   StringValue ("1048576"),
+                   MakeUintegerAccessor (&ProducerObject::m_objectSize),
+                   MakeUintegerChecker<uint64_t> ())
+    .AddAttribute ("SegmentSize", "Size of content of a segment in bytes",
+                   StringValue ("1024"),
+                   MakeUintegerAccessor (&ProducerObject::m_segmentSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("VirtualPayload", "If true, Data has empty content, but is sent over links as if it had the content",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&ProducerObject::m_isPayloadVirtual),
+                   MakeBooleanChecker ())
+    .AddAttribute ("Freshness", "Freshness of data packets, if 0, then unlimited freshness",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&ProducerObject::m_freshness),
+                   MakeTimeChecker ())
+    ;
+  return tid;
+}
+
+ProducerObject::ProducerObject ()
+  : m_isPayloadVirtual (false)
+  , m_nSegments (1)
+  , m_lastSegmentSize (0)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+void
+ProducerObject::StartApplication ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  App::StartApplication ();
+
+  // an empty object still has one (empty) segment
+  uint64_t nSegments = m_objectSize / m_segmentSize + (m_objectSize % m_segmentSize != 0 ? 1 : 0);
+  if (nSegments > std::numeric_limits<uint32_t>::max ())
+    NS_FATAL_ERROR ("ObjectSize of ProducerObject must not exceed 2^32-1 segments of SegmentSize");
+
+  m_nSegments = nSegments == 0 ? 1 : nSegments;
+  m_lastSegmentSize = m_objectSize - static_cast<uint64_t> (m_nSegments - 1) * m_segmentSize;
+  m_finalBlockId = Name ().appendSegment (m_nSegments - 1).at (0);
+
+  m_segmentTemplate.clear ();
+  if (m_nSegments > 1)
+    PrepareDataTemplate (m_segmentSize, m_segmentTemplate);
+  PrepareDataTemplate (m_lastSegmentSize, m_lastSegmentTemplate);
+
+  FibHelper::AddRoutes (GetNode (), std::vector<FibHelper::Route> (1, FibHelper::Route (m_prefix, m_face, 0)));
+}
+
+void
+ProducerObject::StopApplication ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  App::StopApplication ();
+}
+
+void
+ProducerObject::PrepareDataTemplate (uint32_t contentSize, std::vector<uint8_t>& dataTemplate) const
+{
+  Data data;
+  data.setFreshnessPeriod (::ndn::time::milliseconds (m_freshness.GetMilliSeconds ()));
+  data.setFinalBlockId (m_finalBlockId);
+
+  if (!m_isPayloadVirtual)
+    data.setContent (make_shared< ::ndn::Buffer> (contentSize));
+
+  Signature signature;
+  SignatureInfo signatureInfo (static_cast< ::ndn::tlv::SignatureTypeValue> (255));
+  signature.setInfo (signatureInfo);
+  uint32_t signatureValue = 0;
+  signature.setValue (Block (&signatureValue, sizeof (signatureValue)));
+  data.setSignature (signature);
+
+  // everything after the Name is the same in all replies
+  dataTemplate = data.getWireAfterName ();
+}
+
+void
+ProducerObject::OnInterest (shared_ptr<const ::ndn::Interest> interest)
+{
+  App::OnInterest (interest); // tracing inside
+
+  NS_LOG_FUNCTION (this << interest);
+
+  if (!m_active)
+    return;
+
+  const Name& name = interest->getName ();
+  uint64_t segment = 0;
+  try
+    {
+      segment = name.at (-1).toSegment ();
+    }
+  catch (::ndn::tlv::Error&)
+    {
+      NS_LOG_DEBUG ("Ignoring Interest without segment number: " << name);
+      return;
+    }
+
+  if (segment >= m_nSegments)
+    {
+      NS_LOG_DEBUG ("Ignoring Interest for segment beyond the last one: " << name);
+      return;
+    }
+
+  bool isLast = segment == m_nSegments - 1;
+  uint32_t contentSize = isLast ? m_lastSegmentSize : m_segmentSize;
+  const std::vector<uint8_t>& dataTemplate = isLast ? m_lastSegmentTemplate : m_segmentTemplate;
+
+  // splice the name into the prepared encoding, as Producer does
+  shared_ptr<Data> data = Data::createWithName (name, dataTemplate);
+
+  NS_LOG_INFO ("node(" << GetNode ()->GetId () << ") responding with Data: " << data->getName ());
+
+  if (m_isPayloadVirtual)
+    {
+      VirtualPayloadTag virtualPayload;
+      virtualPayload.Set (contentSize);
+      data->getPacket ()->AddPacketTag (virtualPayload);
+    }
+
+  // Echo back FwHopCountTag if exists
+  FwHopCountTag hopCountTag;
+  const Interest& i = reinterpret_cast<const Interest&> (*interest);
+  if (i.getPacket ()->PeekPacketTag (hopCountTag))
+    {
+      hopCountTag.Set (0);
+      data->getPacket ()->AddPacketTag (hopCountTag);
+    }
+
+  m_transmittedDatas ((dynamic_cast< ::ndn::Data&> (*data)).shared_from_this (), this, m_face);
+  m_face->ReceiveData (dynamic_cast< ::ndn::Data&> (*data));
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,86 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#ifndef NDN_PRODUCER_OBJECT_H
+#define NDN_PRODUCER_OBJECT_H
+
+#include "ndn-app.h"
+#include "ns3/ndn-common.h"
+#include "ns3/nstime.h"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Producer of segmented objects of the same size
+ *
+ * Replies to Interests for /Prefix/<object>/<segment> (the last component is a segment
+ * number) with segments of an ObjectSize-byte object: every segment has SegmentSize bytes
+ * of content, except for the last one, which has the remainder.  Every segment carries
+ * FinalBlockId with the number of the last segment.  Interests for segments beyond the
+ * last one or without a segment number are not answered.
+ */
+class ProducerObject : public App
+{
+public:
+  static TypeId
+  GetTypeId (void);
+
+  ProducerObject ();
+
+  // inherited from NdnApp
+  virtual void OnInterest (shared_ptr<const Interest> interest);
+
+protected:
+  // inherited from Application base class.
+  virtual void
+  StartApplication ();
+
+  virtual void
+  StopApplication ();
+
+private:
+  /**
+   * @brief Encode the part of Data after the Name, which is the same in all replies with the
+   *        given content size
+   */
+  void
+  PrepareDataTemplate (uint32_t contentSize, std::vector<uint8_t>& dataTemplate) const;
+
+  Name m_prefix;
+  uint64_t m_objectSize;
+  uint32_t m_segmentSize;
+  bool m_isPayloadVirtual;
+  Time m_freshness;
+
+  uint32_t m_nSegments;
+  uint32_t m_lastSegmentSize;
+  ::ndn::name::Component m_finalBlockId;
+  std::vector<uint8_t> m_segmentTemplate;     ///< @brief encoding after the Name of all but the last segment
+  std::vector<uint8_t> m_lastSegmentTemplate; ///< @brief encoding after the Name of the last segment
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_PRODUCER_OBJECT_H
@@ -22,8 +22,10 @@
 #include "ns3/object.h"
 #include "ndn-producer.h"
 #include "ns3/log.h"
+#include "ns3/ndn-log-level.h"
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
@@ -35,6 +37,7 @@
 #include "ns3/ndn-fw-hop-count-tag.h"
 #include "ns3/ndn-interest.h"
 #include "ns3/ndn-data.h"
+#include "ns3/ndn-virtual-payload-tag.h"
 
 #include <boost/ref.hpp>
 #include <boost/lambda/lambda.hpp>
@@ -72,6 +75,10 @@ Producer::GetTypeId (void)
                    UintegerValue (1024),
                    MakeUintegerAccessor (&Producer::m_virtualPayloadSize),
                    MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("VirtualPayload", "If true, Data has empty content, but is sent over links as if it had PayloadSize bytes of content",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&Producer::m_isPayloadVirtual),
+                   MakeBooleanChecker ())
     .AddAttribute ("Freshness", "Freshness of data packets, if 0, then unlimited freshness",
                     TimeValue (Seconds (0)),
                     MakeTimeAccessor (&Producer::m_freshness),
@@ -89,6 +96,7 @@ Producer::GetTypeId (void)
 }
 
 Producer::Producer ()
+  : m_isPayloadVirtual (false)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
@@ -104,18 +112,13 @@ Producer::StartApplication ()
 
   NS_LOG_DEBUG ("NodeID: " << GetNode ()->GetId ());
 
+  PrepareDataTemplate ();
+
   // ::ndn::shared_ptr< ::nfd::fib::Entry> entry =
   //    GetNode ()->GetObject<L3Protocol> ()->GetForwarder ()->getFib ().insert (m_prefix).first;
   // entry->addNextHop (m_face->shared_from_this (), 0);
 
-  ControlParameters parameters;
-  parameters.setName(m_prefix);
-  parameters.setFaceId(m_face->getId ());
-  parameters.setCost (0);
-
-  FibHelper fibHelper;
-  Ptr<Node> node = GetNode();
-  fibHelper.AddNextHop(parameters, node);
+  FibHelper::AddRoutes (GetNode (), std::vector<FibHelper::Route> (1, FibHelper::Route (m_prefix, m_face, 0)));
 
   // fibEntry->UpdateStatus (m_face, fib::FaceMetric::NDN_FIB_GREEN);
 
@@ -136,24 +139,13 @@ Producer::StopApplication ()
 
 
 void
-Producer::OnInterest(shared_ptr<const ::ndn::Interest> interest)
+Producer::PrepareDataTemplate ()
 {
-  App::OnInterest(interest); // tracing inside
-
-  NS_LOG_FUNCTION(this << interest);
-
-  if (!m_active)
-    return;
-
-  Name dataName(interest->getName());
-  // dataName.append(m_postfix);
-  // dataName.appendVersion();
-
-  auto data = make_shared<Data>();
-  data->setName (dataName);
-  data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
+  Data data;
+  data.setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
 
-  data->setContent(make_shared<::ndn::Buffer>(m_virtualPayloadSize));
+  if (!m_isPayloadVirtual)
+    data.setContent(make_shared<::ndn::Buffer>(m_virtualPayloadSize));
 
   Signature signature;
   SignatureInfo signatureInfo(static_cast<::ndn::tlv::SignatureTypeValue>(255));
@@ -165,10 +157,34 @@ Producer::OnInterest(shared_ptr<const ::ndn::Interest> interest)
   signature.setInfo (signatureInfo);
   signature.setValue(Block(&m_signature, sizeof(m_signature)));
 
-  data->setSignature(signature);
+  data.setSignature(signature);
+
+  // everything after the Name is the same in all replies
+  m_dataTemplate = data.getWireAfterName();
+}
+
+void
+Producer::OnInterest(shared_ptr<const ::ndn::Interest> interest)
+{
+  App::OnInterest(interest); // tracing inside
+
+  NS_LOG_FUNCTION(this << interest);
+
+  if (!m_active)
+    return;
+
+  // splice the name into the prepared encoding, instead of building and encoding Data
+  shared_ptr<Data> data = Data::createWithName(interest->getName(), m_dataTemplate);
 
   NS_LOG_INFO ("node("<< GetNode()->GetId() <<") respodning with Data: " << data->getName ());
 
+  if (m_isPayloadVirtual)
+   {
+     VirtualPayloadTag virtualPayload;
+     virtualPayload.Set(m_virtualPayloadSize);
+     data->getPacket ()->AddPacketTag (virtualPayload);
+   }
+
   // Echo back FwHopCountTag if exists
   FwHopCountTag hopCountTag;
   const Interest& i = reinterpret_cast<const Interest&>(*interest);
@@ -179,11 +195,8 @@ Producer::OnInterest(shared_ptr<const ::ndn::Interest> interest)
      data->getPacket ()->AddPacketTag (hopCountTag);
    }
 
-  // to create real wire encoding
-  data->wireEncode();
-
   m_transmittedDatas ((dynamic_cast<::ndn::Data&>(*data)).shared_from_this (), this, m_face);
-  m_face->onReceiveData (dynamic_cast<::ndn::Data&>(*data));
+  m_face->ReceiveData (dynamic_cast<::ndn::Data&>(*data));
 }
 
 } // namespace ndn
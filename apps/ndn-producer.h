@@ -29,6 +29,8 @@
 #include "ns3/ptr.h"
 #include <ndn-cxx/util/time.hpp>
 
+#include <vector>
+
 namespace ns3 {
 namespace ndn {
 
@@ -60,14 +62,24 @@ protected:
   virtual void
   StopApplication ();     // Called at time specified by Stop
 
+private:
+  /**
+   * @brief Encode everything in Data replies that does not depend on the Interest
+   */
+  void
+  PrepareDataTemplate ();
+
 private:
   Name m_prefix;
   Name m_postfix;
   uint32_t m_virtualPayloadSize;
+  bool m_isPayloadVirtual;
   Time m_freshness;
 
   uint32_t m_signature;
   Name m_keyLocator;
+
+  std::vector<uint8_t> m_dataTemplate; ///< @brief encoded MetaInfo, Content, SignatureInfo and SignatureValue
 };
 
 } // namespace ndn
@@ -113,7 +113,7 @@ CustomApp::SendInterest ()
   // Call trace (for logging purposes)
   m_transmittedInterests (interest, this, m_face);
 
-  m_face->onReceiveInterest (*interest);
+  m_face->ReceiveInterest (*interest);
 }
 
 // Callback that will be called when Interest arrives
@@ -151,7 +151,7 @@ CustomApp::OnInterest (shared_ptr<const Interest> interest)
   // Call trace (for logging purposes)
   m_transmittedDatas (data, this, m_face);
 
-  m_face->onReceiveData (*data);
+  m_face->ReceiveData (*data);
 }
 
 // Callback that will be called when Data arrives
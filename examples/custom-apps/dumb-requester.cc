@@ -107,7 +107,7 @@ DumbRequester::SendInterest ()
   m_transmittedInterests ((dynamic_cast<::ndn::Interest&>(*interest).shared_from_this()), this, m_face);
 
   // Forward packet to lower (network) layer
-  m_face->onReceiveInterest (dynamic_cast<::ndn::Interest&>(*interest));
+  m_face->ReceiveInterest (dynamic_cast<::ndn::Interest&>(*interest));
 
   Simulator::Schedule (Seconds (1.0), &DumbRequester::SendInterest, this);
 }
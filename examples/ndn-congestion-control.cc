@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+// ndn-congestion-control.cc
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+
+using namespace ns3;
+
+using ns3::ndn::StackHelper;
+using ns3::ndn::AppHelper;
+using ns3::ndn::GlobalRoutingHelper;
+using ns3::ndn::AppDelayTracer;
+using ns3::AnnotatedTopologyReader;
+
+static void
+CwndChange (Ptr<OutputStreamWrapper> stream, std::string context, double oldCwnd, double newCwnd)
+{
+  *stream->GetStream () << Simulator::Now ().ToDouble (Time::S) << "\t"
+                        << context << "\t" << newCwnd << "\n";
+}
+
+/**
+ * This scenario simulates four congestion-controlled consumers sharing two bottlenecks
+ * (see src/ndnSIM/examples/topologies/topo-11-node-two-bottlenecks.txt): consumer ci fetches
+ * /pi from producer pi.
+ *
+ * Congestion windows are written to cwnd-trace.txt and delays to app-delays-trace.txt.
+ * To run scenario with CUBIC instead of AIMD, use the following command:
+ *
+ *     ./waf --run="ndn-congestion-control --cc=CUBIC"
+ */
+
+int
+main (int argc, char *argv[])
+{
+  std::string cc = "AIMD";
+
+  CommandLine cmd;
+  cmd.AddValue ("cc", "Congestion control algorithm of consumers (AIMD or CUBIC)", cc);
+  cmd.Parse (argc, argv);
+
+  AnnotatedTopologyReader topologyReader ("", 1);
+  topologyReader.SetFileName ("src/ndnSIM/examples/topologies/topo-11-node-two-bottlenecks.txt");
+  topologyReader.Read ();
+
+  // Install NDN stack on all nodes
+  StackHelper ndnHelper;
+  ndnHelper.InstallAll ();
+
+  // Installing global routing interface on all nodes
+  GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll ();
+
+  AppHelper consumerHelper ("ns3::ndn::ConsumerPcon");
+  consumerHelper.SetAttribute ("CcAlgorithm", StringValue (cc));
+
+  AppHelper producerHelper ("ns3::ndn::Producer");
+  producerHelper.SetAttribute ("PayloadSize", StringValue ("1024"));
+
+  for (int i = 1; i <= 4; i++)
+    {
+      std::string id = std::to_string (i);
+      Ptr<Node> consumer = Names::Find<Node> ("c" + id);
+      Ptr<Node> producer = Names::Find<Node> ("p" + id);
+
+      consumerHelper.SetPrefix ("/p" + id);
+      consumerHelper.Install (consumer);
+
+      ndnGlobalRoutingHelper.AddOrigins ("/p" + id, producer);
+      producerHelper.SetPrefix ("/p" + id);
+      producerHelper.Install (producer);
+    }
+
+  // Calculate and install FIBs
+  GlobalRoutingHelper::CalculateRoutes ();
+
+  AsciiTraceHelper asciiTraceHelper;
+  Ptr<OutputStreamWrapper> cwndStream = asciiTraceHelper.CreateFileStream ("cwnd-trace.txt");
+  Config::Connect ("/NodeList/*/ApplicationList/*/$ns3::ndn::ConsumerPcon/CongestionWindow",
+                   MakeBoundCallback (&CwndChange, cwndStream));
+
+  AppDelayTracer::InstallAll ("app-delays-trace.txt");
+
+  Simulator::Stop (Seconds (20.0));
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  return 0;
+}
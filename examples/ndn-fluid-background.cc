@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+// ndn-fluid-background.cc
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <ctime>
+#include <iostream>
+
+using namespace ns3;
+
+using ns3::ndn::StackHelper;
+using ns3::ndn::AppHelper;
+using ns3::ndn::GlobalRoutingHelper;
+using ns3::ndn::FluidTrafficHelper;
+using ns3::ndn::AppDelayTracer;
+using ns3::AnnotatedTopologyReader;
+
+/**
+ * This scenario compares packet-level and fluid background traffic on the topology of
+ * ndn-congestion-topo-plugin (see src/ndnSIM/examples/topologies/topo-6-node.txt).
+ *
+ * Src1 requests /dst1 from Dst1 (foreground traffic), while Src2 runs nFlows background CBR
+ * flows requesting /dst2/<i> from Dst2, which share the Rtr1-Rtr2 bottleneck.  Background
+ * flows are ConsumerCbr applications, or fluid flows of FluidTrafficHelper with --fluid.
+ *
+ * Delays of the foreground consumer are written to app-delays-trace.txt, so packet-level and
+ * fluid runs can be compared; the wall-clock time of the simulation is printed:
+ *
+ *     ./waf --run="ndn-fluid-background --nFlows=50"
+ *     ./waf --run="ndn-fluid-background --nFlows=50 --fluid"
+ */
+
+int
+main (int argc, char *argv[])
+{
+  bool fluid = false;
+  uint32_t nFlows = 50;
+  double frequency = 1.0;
+
+  CommandLine cmd;
+  cmd.AddValue ("fluid", "Represent background flows as fluid load", fluid);
+  cmd.AddValue ("nFlows", "Number of background flows", nFlows);
+  cmd.AddValue ("frequency", "Number of Interests per second of each background flow", frequency);
+  cmd.Parse (argc, argv);
+
+  AnnotatedTopologyReader topologyReader ("", 25);
+  topologyReader.SetFileName ("src/ndnSIM/examples/topologies/topo-6-node.txt");
+  topologyReader.Read ();
+
+  // Install NDN stack on all nodes
+  StackHelper ndnHelper;
+  ndnHelper.InstallAll ();
+
+  // Installing global routing interface on all nodes
+  GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll ();
+
+  Ptr<Node> consumer1 = Names::Find<Node> ("Src1");
+  Ptr<Node> consumer2 = Names::Find<Node> ("Src2");
+  Ptr<Node> producer1 = Names::Find<Node> ("Dst1");
+  Ptr<Node> producer2 = Names::Find<Node> ("Dst2");
+
+  AppHelper consumerHelper ("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetAttribute ("Frequency", StringValue ("50"));
+  consumerHelper.SetPrefix ("/dst1");
+  consumerHelper.Install (consumer1);
+
+  AppHelper producerHelper ("ns3::ndn::Producer");
+  producerHelper.SetAttribute ("PayloadSize", StringValue ("1024"));
+  producerHelper.SetPrefix ("/dst1");
+  producerHelper.Install (producer1);
+  producerHelper.SetPrefix ("/dst2");
+  producerHelper.Install (producer2);
+
+  ndnGlobalRoutingHelper.AddOrigins ("/dst1", producer1);
+  ndnGlobalRoutingHelper.AddOrigins ("/dst2", producer2);
+
+  // Calculate and install FIBs
+  GlobalRoutingHelper::CalculateRoutes ();
+
+  // Background flows, fluid flows need FIBs and end at the origin of /dst2
+  FluidTrafficHelper fluidHelper;
+
+  AppHelper backgroundHelper ("ns3::ndn::ConsumerCbr");
+  backgroundHelper.SetAttribute ("Frequency", DoubleValue (frequency));
+
+  for (uint32_t i = 0; i < nFlows; i++)
+    {
+      std::string prefix = "/dst2/" + std::to_string (i);
+      if (fluid)
+        {
+          fluidHelper.AddFlow (consumer2, prefix, frequency);
+        }
+      else
+        {
+          backgroundHelper.SetPrefix (prefix);
+          backgroundHelper.Install (consumer2);
+        }
+    }
+
+  AppDelayTracer::Install (consumer1, "app-delays-trace.txt");
+
+  Simulator::Stop (Seconds (20.0));
+
+  std::clock_t start = std::clock ();
+  Simulator::Run ();
+  std::clock_t end = std::clock ();
+
+  std::cout << (fluid ? "Fluid" : "Packet-level") << " background traffic, " << nFlows << " flows: "
+            << static_cast<double> (end - start) / CLOCKS_PER_SEC << " s" << std::endl;
+
+  Simulator::Destroy ();
+
+  return 0;
+}
@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+// ndn-request-trace-convert.cc
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndnSIM/utils/ndn-request-trace.h"
+
+#include <iostream>
+#include <fstream>
+
+using namespace ns3;
+
+using ns3::ndn::RequestTraceReader;
+using ns3::ndn::RequestTraceWriter;
+
+/**
+ * This program converts a text request trace (lines "<time in seconds> <name>" or
+ * "<time in seconds>,<name>") into the binary format replayed by ns3::ndn::ConsumerTrace,
+ * which is faster to read and does not need name parsing:
+ *
+ *     ./waf --run="ndn-request-trace-convert --input=requests.txt --output=requests.trace"
+ *
+ * Requests are expected to be ordered by time; the number of requests out of order is reported.
+ */
+
+int
+main (int argc, char *argv[])
+{
+  std::string input;
+  std::string output;
+
+  CommandLine cmd;
+  cmd.AddValue ("input", "Text request trace", input);
+  cmd.AddValue ("output", "Binary request trace to create", output);
+  cmd.Parse (argc, argv);
+
+  std::ifstream text (input.c_str ());
+  if (!text.is_open ())
+    {
+      std::cerr << "Cannot open " << input << std::endl;
+      return 1;
+    }
+
+  RequestTraceWriter writer;
+  if (!writer.Open (output))
+    {
+      std::cerr << "Cannot create " << output << std::endl;
+      return 1;
+    }
+
+  uint64_t nRequests = 0;
+  uint64_t nInvalid = 0;
+  uint64_t nOutOfOrder = 0;
+  int64_t lastTime = 0;
+
+  std::string line;
+  std::string uri;
+  while (std::getline (text, line))
+    {
+      int64_t time = 0;
+      if (!RequestTraceReader::ParseLine (line, time, uri))
+        continue;
+
+      Name name;
+      try
+        {
+          name = Name (uri);
+        }
+      catch (::ndn::tlv::Error&)
+        {
+          nInvalid++;
+          continue;
+        }
+
+      if (nRequests > 0 && time < lastTime)
+        nOutOfOrder++;
+      lastTime = time;
+
+      writer.Write (time, name);
+      nRequests++;
+    }
+
+  if (!writer.Close ())
+    {
+      std::cerr << "Cannot write " << output << std::endl;
+      return 1;
+    }
+
+  std::cout << nRequests << " requests written, "
+            << nInvalid << " invalid names skipped, "
+            << nOutOfOrder << " requests out of order" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,123 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+// ndn-routing-benchmark.cc
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+
+using ns3::ndn::StackHelper;
+using ns3::ndn::GlobalRoutingHelper;
+
+/**
+ * This program times GlobalRoutingHelper::CalculateRoutes on a random connected topology:
+ * every node is linked to a random node created before it, and random links are added until
+ * nodes have meanDegree links on average.  Each of the first nOrigins nodes (all nodes by
+ * default) originates its own prefix.
+ *
+ * The wall-clock time of the route calculation is printed, e.g., for 1k, 10k and 50k nodes:
+ *
+ *     ./waf --run="ndn-routing-benchmark --nNodes=1000"
+ *     ./waf --run="ndn-routing-benchmark --nNodes=10000 --nThreads=1"
+ *     ./waf --run="ndn-routing-benchmark --nNodes=50000 --nOrigins=1000"
+ */
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nNodes = 1000;
+  uint32_t nOrigins = 0;
+  double meanDegree = 4.0;
+  uint32_t nThreads = 0;
+
+  CommandLine cmd;
+  cmd.AddValue ("nNodes", "Number of nodes", nNodes);
+  cmd.AddValue ("nOrigins", "Number of nodes originating a prefix, 0 for all nodes", nOrigins);
+  cmd.AddValue ("meanDegree", "Mean number of links of a node", meanDegree);
+  cmd.AddValue ("nThreads", "Number of threads calculating routes, 0 for all hardware threads", nThreads);
+  cmd.Parse (argc, argv);
+
+  if (nOrigins == 0 || nOrigins > nNodes)
+    nOrigins = nNodes;
+
+  NodeContainer nodes;
+  nodes.Create (nNodes);
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  std::set< std::pair<uint32_t, uint32_t> > links;
+  for (uint32_t node = 1; node < nNodes; node++)
+    {
+      links.insert (std::make_pair (random->GetInteger (0, node - 1), node));
+    }
+
+  uint64_t nLinks = std::max<uint64_t> (links.size (), meanDegree * nNodes / 2);
+  while (nNodes > 1 && links.size () < nLinks)
+    {
+      uint32_t node1 = random->GetInteger (0, nNodes - 1);
+      uint32_t node2 = random->GetInteger (0, nNodes - 1);
+      if (node1 != node2)
+        links.insert (std::make_pair (std::min (node1, node2), std::max (node1, node2)));
+    }
+
+  PointToPointHelper p2p;
+  for (std::set< std::pair<uint32_t, uint32_t> >::iterator link = links.begin (); link != links.end (); link++)
+    {
+      p2p.Install (nodes.Get (link->first), nodes.Get (link->second));
+    }
+
+  // Install NDN stack on all nodes, without management which is not needed here
+  StackHelper ndnHelper;
+  ndnHelper.SetHeadless (true);
+  ndnHelper.InstallAll ();
+
+  // Installing global routing interface on all nodes
+  GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll ();
+
+  for (uint32_t node = 0; node < nOrigins; node++)
+    {
+      std::ostringstream prefix;
+      prefix << "/node" << node;
+      ndnGlobalRoutingHelper.AddOrigin (prefix.str (), nodes.Get (node));
+    }
+
+  GlobalRoutingHelper::SetNThreads (nThreads);
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+  GlobalRoutingHelper::CalculateRoutes ();
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now ();
+
+  std::cout << nNodes << " nodes, " << links.size () << " links, " << nOrigins << " origins, "
+            << (nThreads == 0 ? std::string ("all") : std::to_string (nThreads)) << " threads: "
+            << std::chrono::duration<double> (end - start).count () << " s" << std::endl;
+
+  Simulator::Destroy ();
+
+  return 0;
+}
@@ -40,6 +40,7 @@
 #include "ns3/data-rate.h"
 
 #include "ns3/ndnSIM/NFD/daemon/mgmt/fib-manager.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
 
 namespace ns3 {
 namespace ndn {
@@ -60,6 +61,23 @@ FibHelper::~FibHelper ()
 void
 FibHelper::AddNextHop (const ControlParameters& parameters, Ptr<Node> node)
 {
+  Ptr<L3Protocol> L3protocol = node->GetObject<L3Protocol> ();
+  if (L3protocol->IsHeadless ())
+    {
+      // no fib manager, the command is applied directly
+      shared_ptr<Forwarder> forwarder = L3protocol->GetForwarder ();
+      shared_ptr< ::nfd::Face> face = forwarder->getFace (parameters.getFaceId ());
+      if (!static_cast<bool> (face))
+        {
+          NS_LOG_WARN ("Face " << parameters.getFaceId () << " is not registered, skipping next hop for "
+                       << parameters.getName ());
+          return;
+        }
+
+      forwarder->getFib ().insert (parameters.getName ()).first->addNextHop (face, parameters.getCost ());
+      return;
+    }
+
   NS_LOG_DEBUG ("Add Next Hop command was initialized");
   Block encodedParameters(parameters.wireEncode());
 
@@ -70,7 +88,6 @@ FibHelper::AddNextHop (const ControlParameters& parameters, Ptr<Node> node)
   shared_ptr<Interest> command(make_shared<Interest>(commandName));
   StackHelper::getKeyChain().signWithSha256(*command);
 
-  Ptr<L3Protocol> L3protocol = node->GetObject<L3Protocol> ();
   shared_ptr<FibManager> fibManager = L3protocol->GetFibManager ();
   fibManager->onFibRequest(*command);
 }
@@ -78,6 +95,22 @@ FibHelper::AddNextHop (const ControlParameters& parameters, Ptr<Node> node)
 void
 FibHelper::RemoveNextHop (const ControlParameters& parameters, Ptr<Node> node)
 {
+  Ptr<L3Protocol> L3protocol = node->GetObject<L3Protocol> ();
+  if (L3protocol->IsHeadless ())
+    {
+      // no fib manager, the command is applied directly
+      shared_ptr<Forwarder> forwarder = L3protocol->GetForwarder ();
+      shared_ptr< ::nfd::Face> face = forwarder->getFace (parameters.getFaceId ());
+      shared_ptr< ::nfd::fib::Entry> entry = forwarder->getFib ().findExactMatch (parameters.getName ());
+      if (!static_cast<bool> (face) || !static_cast<bool> (entry))
+        return;
+
+      entry->removeNextHop (face);
+      if (!entry->hasNextHops ())
+        forwarder->getFib ().erase (*entry);
+      return;
+    }
+
   NS_LOG_DEBUG ("Remove Next Hop command was initialized");
   Block encodedParameters(parameters.wireEncode());
 
@@ -88,28 +121,69 @@ FibHelper::RemoveNextHop (const ControlParameters& parameters, Ptr<Node> node)
   shared_ptr<Interest> command(make_shared<Interest>(commandName));
   StackHelper::getKeyChain().signWithSha256(*command);
 
-  Ptr<L3Protocol> L3protocol = node->GetObject<L3Protocol> ();
   shared_ptr<FibManager> fibManager = L3protocol->GetFibManager ();
   // fibManager->addInterestRule(commandName.toUri(), key, *keyChain.getPublicKey (key));
   fibManager->onFibRequest(*command);
 }
 
 void
-FibHelper::AddRoute (Ptr<Node> node, const std::string &prefix, Ptr<Face> face, int32_t metric)
+FibHelper::AddRoutes (Ptr<Node> node, const std::vector<Route>& routes)
 {
-  NS_LOG_LOGIC ("[" << node->GetId () << "]$ route add " << prefix << " via " << *face << " metric " << metric);
+  Ptr<L3Protocol> L3protocol = node->GetObject<L3Protocol> ();
+  NS_ASSERT_MSG (L3protocol != 0, "Ndn stack should be installed on the node");
+  shared_ptr<Forwarder> forwarder = L3protocol->GetForwarder();
+
+  std::vector<std::pair<Name, ::nfd::fib::NextHop> > nextHops;
+  nextHops.reserve (routes.size ());
+  for (std::vector<Route>::const_iterator route = routes.begin (); route != routes.end (); route++)
+    {
+      NS_LOG_LOGIC ("[" << node->GetId () << "]$ route add " << route->prefix << " via " << *route->face
+                    << " metric " << route->metric);
 
-  //Get L3Protocol object
+      // same as fib manager: face must be registered with the forwarder
+      shared_ptr< ::nfd::Face> face = forwarder->getFace (route->face->getId ());
+      if (!static_cast<bool> (face))
+        {
+          NS_LOG_WARN ("Face " << route->face->getId () << " is not registered, skipping route to "
+                       << route->prefix);
+          continue;
+        }
+
+      ::nfd::fib::NextHop nextHop (face);
+      nextHop.setCost (route->metric);
+      nextHops.push_back (std::make_pair (route->prefix, nextHop));
+    }
+
+  forwarder->getFib ().addNextHops (nextHops);
+}
+
+void
+FibHelper::RemoveRoutes (Ptr<Node> node, const std::vector<Route>& routes)
+{
   Ptr<L3Protocol> L3protocol = node->GetObject<L3Protocol> ();
-  //Get the forwarder instance
-  shared_ptr<Forwarder> m_forwarder = L3protocol->GetForwarder();
+  NS_ASSERT_MSG (L3protocol != 0, "Ndn stack should be installed on the node");
+  shared_ptr<Forwarder> forwarder = L3protocol->GetForwarder();
+  ::nfd::Fib& fib = forwarder->getFib ();
 
-  ControlParameters parameters;
-  parameters.setName(prefix);
-  parameters.setFaceId(face->getId ());
-  parameters.setCost (metric);
+  for (std::vector<Route>::const_iterator route = routes.begin (); route != routes.end (); route++)
+    {
+      NS_LOG_LOGIC ("[" << node->GetId () << "]$ route del " << route->prefix << " via " << *route->face);
+
+      shared_ptr< ::nfd::Face> face = forwarder->getFace (route->face->getId ());
+      shared_ptr< ::nfd::fib::Entry> entry = fib.findExactMatch (route->prefix);
+      if (!static_cast<bool> (face) || !static_cast<bool> (entry))
+        continue;
 
-  AddNextHop(parameters, node);
+      entry->removeNextHop (face);
+      if (!entry->hasNextHops ())
+        fib.erase (*entry);
+    }
+}
+
+void
+FibHelper::AddRoute (Ptr<Node> node, const std::string &prefix, Ptr<Face> face, int32_t metric)
+{
+  AddRoutes (node, std::vector<Route> (1, Route (prefix, face, metric)));
 }
 
 void
@@ -50,6 +50,22 @@ using ::ndn::nfd::ControlParameters;
 class FibHelper
 {
 public:
+  /**
+   * \brief Forwarding entry to be added with AddRoutes
+   */
+  struct Route
+  {
+    Route (const Name& prefix, Ptr<Face> face, int32_t metric)
+      : prefix (prefix)
+      , face (face)
+      , metric (metric)
+    {
+    }
+
+    Name prefix;
+    Ptr<Face> face;
+    int32_t metric;
+  };
 
   /**
    * \brief Default constructor
@@ -79,6 +95,31 @@ public:
   static void
   RemoveNextHop(const ControlParameters& parameters, Ptr<Node> node);
 
+  /**
+   * \brief Add forwarding entries directly to FIB of the node
+   *
+   * Unlike AddNextHop, entries do not go through signed commands to the fib manager
+   * of NFD, which makes this method suitable for installing a large number of routes
+   * at scenario setup.  Routes with the same prefix should be adjacent in the list.
+   *
+   * \param node   Node
+   * \param routes Forwarding entries
+   */
+  static void
+  AddRoutes (Ptr<Node> node, const std::vector<Route>& routes);
+
+  /**
+   * \brief Remove forwarding entries directly from FIB of the node
+   *
+   * Counterpart of AddRoutes: metrics of the routes are ignored, and FIB entries that are
+   * left without next hops are erased.
+   *
+   * \param node   Node
+   * \param routes Forwarding entries
+   */
+  static void
+  RemoveRoutes (Ptr<Node> node, const std::vector<Route>& routes);
+
   /**
    * \brief Add forwarding entry to FIB
    *
@@ -0,0 +1,262 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#include "ndn-fluid-traffic-helper.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/point-to-point-channel.h"
+
+#include "ns3/ndn-l3-protocol.h"
+#include "ns3/ndn-net-device-face.h"
+#include "ns3/ndn-app-face.h"
+#include "../model/ndn-global-router.h"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/fib.hpp"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.FluidTrafficHelper");
+
+namespace ns3 {
+namespace ndn {
+
+// point-to-point header added to every packet
+static const uint32_t PPP_HEADER_SIZE = 2;
+
+// guard against forwarding loops in FIBs
+static const uint32_t MAX_PATH_LENGTH = 64;
+
+// whether the node is an origin of the prefix for GlobalRoutingHelper
+static bool
+IsOrigin (Ptr<Node> node, const Name& prefix)
+{
+  Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
+  if (router == 0)
+    return false;
+
+  const GlobalRouter::LocalPrefixList& localPrefixes = router->GetLocalPrefixes ();
+  for (GlobalRouter::LocalPrefixList::const_iterator localPrefix = localPrefixes.begin ();
+       localPrefix != localPrefixes.end (); localPrefix++)
+    {
+      if ((*localPrefix)->isPrefixOf (prefix))
+        return true;
+    }
+  return false;
+}
+
+FluidTrafficHelper::FluidTrafficHelper ()
+  : m_minShare (0.01)
+{
+}
+
+void
+FluidTrafficHelper::SetMinShare (double minShare)
+{
+  if (minShare <= 0 || minShare > 1)
+    NS_FATAL_ERROR ("MinShare of FluidTrafficHelper must be in (0, 1]");
+
+  m_minShare = minShare;
+}
+
+uint32_t
+FluidTrafficHelper::AddFlow (Ptr<Node> consumer, const std::string& prefix, double frequency, uint32_t payloadSize)
+{
+  NS_LOG_FUNCTION (consumer << prefix << frequency << payloadSize);
+  NS_ASSERT (consumer != 0);
+
+  if (frequency < 0)
+    NS_FATAL_ERROR ("Frequency of a fluid flow must not be negative");
+
+  Flow flow;
+  flow.consumer = consumer;
+  flow.prefix = Name (prefix);
+  flow.frequency = frequency;
+
+  // sizes of packets as sent by ConsumerCbr and Producer with default attributes
+  Name name (flow.prefix);
+  name.appendSequenceNumber (0);
+
+  ::ndn::Interest interest (name);
+  interest.setNonce (0);
+  interest.setInterestLifetime (::ndn::time::seconds (2));
+  flow.interestSize = interest.wireEncode ().size () + PPP_HEADER_SIZE;
+
+  ::ndn::Data data (name);
+  data.setContent (make_shared< ::ndn::Buffer> (payloadSize));
+
+  uint32_t fakeSignature = 0;
+  ::ndn::Signature signature;
+  signature.setInfo (::ndn::SignatureInfo (static_cast< ::ndn::tlv::SignatureTypeValue> (255)));
+  signature.setValue (Block (reinterpret_cast<const uint8_t*> (&fakeSignature), sizeof (fakeSignature)));
+  data.setSignature (signature);
+  flow.dataSize = data.wireEncode ().size () + PPP_HEADER_SIZE;
+
+  FindPath (flow);
+  ApplyLoad (flow, 1);
+
+  m_flows.push_back (flow);
+  return m_flows.size () - 1;
+}
+
+void
+FluidTrafficHelper::SetFrequency (uint32_t flowId, double frequency)
+{
+  NS_LOG_FUNCTION (flowId << frequency);
+  NS_ASSERT (flowId < m_flows.size ());
+
+  if (frequency < 0)
+    NS_FATAL_ERROR ("Frequency of a fluid flow must not be negative");
+
+  Flow& flow = m_flows[flowId];
+  ApplyLoad (flow, -1);
+  flow.frequency = frequency;
+  ApplyLoad (flow, 1);
+}
+
+void
+FluidTrafficHelper::UpdatePaths ()
+{
+  NS_LOG_FUNCTION (this);
+
+  for (std::vector<Flow>::iterator flow = m_flows.begin (); flow != m_flows.end (); flow++)
+    {
+      ApplyLoad (*flow, -1);
+      FindPath (*flow);
+      ApplyLoad (*flow, 1);
+    }
+}
+
+double
+FluidTrafficHelper::GetLoad (Ptr<PointToPointNetDevice> device) const
+{
+  std::map<Ptr<PointToPointNetDevice>, Link>::const_iterator link = m_links.find (device);
+  if (link == m_links.end ())
+    return 0;
+
+  return link->second.load;
+}
+
+void
+FluidTrafficHelper::FindPath (Flow& flow) const
+{
+  flow.interestDevices.clear ();
+  flow.dataDevices.clear ();
+
+  std::vector<Ptr<PointToPointNetDevice> > dataDevices;
+
+  Ptr<Node> node = flow.consumer;
+  for (uint32_t hop = 0; hop < MAX_PATH_LENGTH; hop++)
+    {
+      // the producer's route is installed only when its application starts, so before the
+      // simulation runs the path ends at the origin node
+      if (IsOrigin (node, flow.prefix))
+        {
+          flow.dataDevices.swap (dataDevices);
+          return;
+        }
+
+      Ptr<L3Protocol> ndn = node->GetObject<L3Protocol> ();
+      NS_ASSERT_MSG (ndn != 0, "NDN stack should be installed on all nodes on the path of a fluid flow");
+
+      shared_ptr< ::nfd::fib::Entry> entry = ndn->GetForwarder ()->getFib ().findLongestPrefixMatch (flow.prefix);
+      if (!entry->hasNextHops ())
+        {
+          NS_LOG_DEBUG ("No route for " << flow.prefix << " on node " << node->GetId ());
+          break;
+        }
+
+      // next hops are ordered by cost
+      ::nfd::Face* nextHop = entry->getNextHops ().front ().getFace ().get ();
+      if (dynamic_cast<AppFace*> (nextHop) != 0)
+        {
+          // producer reached, Data returns on the reverse path
+          flow.dataDevices.swap (dataDevices);
+          return;
+        }
+
+      NetDeviceFace* face = dynamic_cast<NetDeviceFace*> (nextHop);
+      Ptr<PointToPointNetDevice> device;
+      if (face != 0)
+        device = DynamicCast<PointToPointNetDevice> (face->GetNetDevice ());
+      if (device == 0)
+        {
+          NS_LOG_WARN ("Fluid flow for " << flow.prefix << " can follow only point-to-point links");
+          break;
+        }
+
+      Ptr<PointToPointChannel> channel = DynamicCast<PointToPointChannel> (device->GetChannel ());
+      Ptr<NetDevice> peer = channel->GetDevice (0) == device ? channel->GetDevice (1) : channel->GetDevice (0);
+
+      flow.interestDevices.push_back (device);
+      dataDevices.push_back (DynamicCast<PointToPointNetDevice> (peer));
+      node = peer->GetNode ();
+    }
+
+  // Interests are not satisfied, so only they load the links
+  NS_LOG_WARN ("Fluid flow for " << flow.prefix << " does not reach a producer");
+}
+
+void
+FluidTrafficHelper::ApplyLoad (const Flow& flow, double sign)
+{
+  if (flow.frequency == 0)
+    return;
+
+  for (std::vector<Ptr<PointToPointNetDevice> >::const_iterator device = flow.interestDevices.begin ();
+       device != flow.interestDevices.end (); device++)
+    {
+      AddLoad (*device, sign * flow.frequency * flow.interestSize * 8);
+    }
+
+  for (std::vector<Ptr<PointToPointNetDevice> >::const_iterator device = flow.dataDevices.begin ();
+       device != flow.dataDevices.end (); device++)
+    {
+      AddLoad (*device, sign * flow.frequency * flow.dataSize * 8);
+    }
+}
+
+void
+FluidTrafficHelper::AddLoad (Ptr<PointToPointNetDevice> device, double load)
+{
+  std::map<Ptr<PointToPointNetDevice>, Link>::iterator link = m_links.find (device);
+  if (link == m_links.end ())
+    {
+      DataRateValue capacity;
+      device->GetAttribute ("DataRate", capacity);
+
+      Link newLink = { capacity.Get (), 0 };
+      link = m_links.insert (std::make_pair (device, newLink)).first;
+    }
+
+  link->second.load = std::max (0.0, link->second.load + load);
+
+  double capacity = link->second.capacity.GetBitRate ();
+  double rate = std::max (capacity * m_minShare, capacity - link->second.load);
+
+  NS_LOG_DEBUG ("Device " << device->GetNode ()->GetId () << ":" << device->GetIfIndex ()
+                << " background load " << link->second.load << " bps, data rate " << rate << " bps");
+  device->SetDataRate (DataRate (static_cast<uint64_t> (rate)));
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#ifndef NDN_FLUID_TRAFFIC_HELPER_H
+#define NDN_FLUID_TRAFFIC_HELPER_H
+
+#include "ns3/ptr.h"
+#include "ns3/node.h"
+#include "ns3/data-rate.h"
+#include "ns3/ndn-common.h"
+
+#include <map>
+#include <vector>
+#include <string>
+
+namespace ns3 {
+
+class PointToPointNetDevice;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper to represent background flows as fluid load on links, instead of packets
+ *
+ * A fluid flow stands for a ConsumerCbr application requesting a prefix at a constant
+ * frequency from a Producer.  No packets are generated: the flow follows the best (lowest
+ * cost) FIB next hops from the consumer node until the producer's application face or a node
+ * that is an origin of the prefix for GlobalRoutingHelper (AddOrigins), and
+ * the bit rate of its Interests and Data (sizes of encoded packets plus point-to-point
+ * framing) is subtracted from the data rate of point-to-point devices on the path.
+ * Packet-level (foreground) traffic then sees only the remaining capacity.
+ *
+ * Link rates are updated only when a flow is added, changes frequency (SetFrequency can be
+ * scheduled), or when paths are recomputed with UpdatePaths after FIB changes; nothing is
+ * scheduled per packet.  Links keep at least MinShare of their capacity.
+ *
+ * The model does not account for queueing delay and losses caused by background traffic,
+ * nor for cache state: background CBR flows request names that are never requested again,
+ * so they are never satisfied from caches, but unlike packet-level flows they do not evict
+ * cached Data.  Only links with PointToPointNetDevice are supported.
+ *
+ * The helper should exist until the end of the simulation.
+ */
+class FluidTrafficHelper
+{
+public:
+  FluidTrafficHelper ();
+
+  /**
+   * @brief Set the minimum share of link capacity left for packet-level traffic (default 0.01)
+   */
+  void
+  SetMinShare (double minShare);
+
+  /**
+   * @brief Add background flow
+   * @param consumer node of the consumer
+   * @param prefix requested prefix (a sequence number is appended to Interest names)
+   * @param frequency number of Interests per second
+   * @param payloadSize size of Data payload
+   * @returns flow id
+   *
+   * FIBs should be installed before the flow is added (e.g., with GlobalRoutingHelper::CalculateRoutes).
+   */
+  uint32_t
+  AddFlow (Ptr<Node> consumer, const std::string& prefix, double frequency, uint32_t payloadSize = 1024);
+
+  /**
+   * @brief Change frequency of a flow (0 stops it)
+   */
+  void
+  SetFrequency (uint32_t flowId, double frequency);
+
+  /**
+   * @brief Recompute paths of all flows from the current FIBs
+   */
+  void
+  UpdatePaths ();
+
+  /**
+   * @brief Get background load transmitted by the device, in bits per second
+   */
+  double
+  GetLoad (Ptr<PointToPointNetDevice> device) const;
+
+private:
+  struct Flow
+  {
+    Ptr<Node> consumer;
+    Name prefix;
+    double frequency;
+    uint32_t interestSize;  ///< @brief bytes on the link, including framing
+    uint32_t dataSize;      ///< @brief bytes on the link, including framing
+
+    std::vector<Ptr<PointToPointNetDevice> > interestDevices; ///< @brief devices sending Interests of the flow
+    std::vector<Ptr<PointToPointNetDevice> > dataDevices;     ///< @brief devices sending Data of the flow
+  };
+
+  struct Link
+  {
+    DataRate capacity;      ///< @brief data rate of the device without background load
+    double load;            ///< @brief background load in bits per second
+  };
+
+  /**
+   * @brief Follow FIB from the consumer to the producer
+   */
+  void
+  FindPath (Flow& flow) const;
+
+  /**
+   * @brief Add (sign 1) or remove (sign -1) load of the flow from devices on its path
+   */
+  void
+  ApplyLoad (const Flow& flow, double sign);
+
+  void
+  AddLoad (Ptr<PointToPointNetDevice> device, double load);
+
+private:
+  double m_minShare;
+  std::vector<Flow> m_flows;
+  std::map<Ptr<PointToPointNetDevice>, Link> m_links;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_FLUID_TRAFFIC_HELPER_H
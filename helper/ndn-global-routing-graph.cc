@@ -0,0 +1,511 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 UCLA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author:  Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-global-routing-graph.h"
+
+#include "ns3/ndn-face.h"
+#include "../model/ndn-global-router.h"
+
+#include "ns3/node.h"
+#include "ns3/channel.h"
+#include "ns3/node-list.h"
+#include "ns3/channel-list.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <boost/property_map/property_map.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <queue>
+#include <thread>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.GlobalRoutingGraph");
+
+namespace ns3 {
+namespace ndn {
+
+const uint32_t GlobalRoutingGraph::INFINITE_COST = std::numeric_limits<uint16_t>::max ();
+
+namespace {
+
+typedef GlobalRoutingGraph::Edge Edge;
+typedef GlobalRoutingGraph::Distance Distance;
+
+// Paths are compared by cost, ties are broken by the first-hop face, which makes the
+// selected next hop independent of the order in which vertices are visited
+struct DistanceCompare
+{
+  bool
+  operator () (const Distance& a, const Distance& b) const
+  {
+    return a.cost < b.cost || (a.cost == b.cost && a.face < b.face);
+  }
+
+  bool
+  operator () (const Edge& a, const Distance& b) const
+  {
+    return a.metric < b.cost;
+  }
+};
+
+// Forward computation: the first face on the path from the source is kept
+struct DistanceCombine
+{
+  Distance
+  operator () (const Distance& a, const Edge& b) const
+  {
+    Distance result = { a.face == 0 ? b.face : a.face, a.cost + b.metric };
+    return result;
+  }
+};
+
+// Reverse computation: edges are walked backwards from the destination, so the face of the
+// last walked edge is the first hop of its (original) source.  Channel-to-node edges have no
+// face and keep the one of the node.
+struct ReverseDistanceCombine
+{
+  Distance
+  operator () (const Distance& a, const Edge& b) const
+  {
+    Distance result = { b.face == 0 ? a.face : b.face, a.cost + b.metric };
+    return result;
+  }
+};
+
+template<class Graph, class Combine, class PredecessorMap>
+void
+RunDijkstra (const Graph& graph, const std::vector<Edge>& edges, uint32_t root,
+             GlobalRoutingGraph::DistanceList& distances, Combine combine,
+             PredecessorMap predecessors)
+{
+  // no logging and no ns-3 smart pointers here, as this can run on worker threads
+  const Distance inf = { 0, GlobalRoutingGraph::INFINITE_COST };
+  const Distance zero = { 0, 0 };
+
+  distances.assign (num_vertices (graph), inf);
+
+  boost::dijkstra_shortest_paths (graph, root,
+                                  boost::weight_map (boost::make_iterator_property_map (edges.begin (),
+                                                                                        get (boost::edge_index, graph)))
+                                  .
+                                  predecessor_map (predecessors)
+                                  .
+                                  distance_map (boost::make_iterator_property_map (distances.begin (),
+                                                                                   get (boost::vertex_index, graph)))
+                                  .
+                                  distance_inf (inf)
+                                  .
+                                  distance_zero (zero)
+                                  .
+                                  distance_compare (DistanceCompare ())
+                                  .
+                                  distance_combine (combine)
+                                  );
+}
+
+} // namespace
+
+GlobalRoutingGraph::GlobalRoutingGraph ()
+{
+  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+    {
+      Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter> ();
+      if (gr != 0)
+        m_routers.push_back (gr);
+    }
+
+  for (ChannelList::Iterator channel = ChannelList::Begin (); channel != ChannelList::End (); channel++)
+    {
+      Ptr<GlobalRouter> gr = (*channel)->GetObject<GlobalRouter> ();
+      if (gr != 0)
+        m_routers.push_back (gr);
+    }
+
+  m_vertexById.reserve (m_routers.size ());
+  for (uint32_t vertex = 0; vertex < m_routers.size (); vertex++)
+    {
+      m_vertexById[m_routers[vertex]->GetId ()] = vertex;
+    }
+
+  m_faces.push_back (0);
+  m_faceEdges.push_back (FaceEdge ());
+  std::unordered_map<const Face*, uint32_t> faceIndex;
+
+  std::vector< std::pair<uint32_t, uint32_t> > edges;
+  for (uint32_t vertex = 0; vertex < m_routers.size (); vertex++)
+    {
+      const GlobalRouter::IncidencyList& incidencies = m_routers[vertex]->GetIncidencies ();
+      for (GlobalRouter::IncidencyList::const_iterator i = incidencies.begin ();
+           i != incidencies.end ();
+           i++)
+        {
+          uint32_t target = GetVertex (i->get<2> ());
+          NS_ASSERT_MSG (target < m_routers.size (), "Incidency to a GlobalRouter that is not installed "
+                         "on any node or channel");
+
+          Edge edge = { 0, 0 };
+          const Ptr<Face>& face = i->get<1> ();
+          if (face != 0)
+            {
+              std::pair<std::unordered_map<const Face*, uint32_t>::iterator, bool> inserted =
+                faceIndex.insert (std::make_pair (PeekPointer (face), m_faces.size ()));
+              if (inserted.second)
+                {
+                  m_faces.push_back (face);
+                  m_faceEdges.push_back (FaceEdge ());
+                }
+
+              edge.face = inserted.first->second;
+              edge.metric = GetMetric (face);
+
+              FaceEdge& faceEdge = m_faceEdges[edge.face];
+              faceEdge.source = vertex;
+              faceEdge.target = target;
+              faceEdge.edge = m_edges.size ();
+            }
+
+          edges.push_back (std::make_pair (vertex, target));
+          m_edges.push_back (edge);
+        }
+    }
+
+  // edges are generated vertex by vertex, so they are already sorted by source and CSR
+  // edge indices match positions in m_edges
+  m_graph = Csr (boost::edges_are_sorted, edges.begin (), edges.end (), m_routers.size ());
+
+  std::vector<uint32_t> reverseOrder (edges.size ());
+  for (uint32_t i = 0; i < reverseOrder.size (); i++)
+    {
+      reverseOrder[i] = i;
+    }
+  std::stable_sort (reverseOrder.begin (), reverseOrder.end (),
+                    [&edges] (uint32_t a, uint32_t b) { return edges[a].second < edges[b].second; });
+
+  std::vector< std::pair<uint32_t, uint32_t> > reverseEdges;
+  reverseEdges.reserve (edges.size ());
+  m_reverseEdges.reserve (edges.size ());
+  for (std::vector<uint32_t>::iterator i = reverseOrder.begin (); i != reverseOrder.end (); i++)
+    {
+      reverseEdges.push_back (std::make_pair (edges[*i].second, edges[*i].first));
+      if (m_edges[*i].face != 0)
+        m_faceEdges[m_edges[*i].face].reverseEdge = m_reverseEdges.size ();
+      m_reverseEdges.push_back (m_edges[*i]);
+    }
+  m_reverseGraph = Csr (boost::edges_are_sorted, reverseEdges.begin (), reverseEdges.end (),
+                        m_routers.size ());
+
+  NS_LOG_DEBUG ("Snapshot of " << m_routers.size () << " routers, " << m_edges.size () << " edges, "
+                << m_faces.size () - 1 << " faces");
+}
+
+uint32_t
+GlobalRoutingGraph::GetVertex (const Ptr<GlobalRouter>& router) const
+{
+  std::unordered_map<uint32_t, uint32_t>::const_iterator i = m_vertexById.find (router->GetId ());
+  if (i == m_vertexById.end ())
+    return m_routers.size ();
+
+  return i->second;
+}
+
+uint16_t
+GlobalRoutingGraph::GetMetric (const Ptr<Face>& face)
+{
+  if (!face->IsUp ())
+    return INFINITE_COST;
+
+  return face->GetMetric ();
+}
+
+void
+GlobalRoutingGraph::UpdateFaceMetrics (std::vector<uint32_t>& faces)
+{
+  faces.clear ();
+  for (uint32_t face = 1; face < m_faces.size (); face++)
+    {
+      uint16_t metric = GetMetric (m_faces[face]);
+
+      const FaceEdge& faceEdge = m_faceEdges[face];
+      if (m_edges[faceEdge.edge].metric == metric)
+        continue;
+
+      NS_LOG_DEBUG ("Face " << *m_faces[face] << " metric changed from "
+                    << m_edges[faceEdge.edge].metric << " to " << metric);
+
+      m_edges[faceEdge.edge].metric = metric;
+      m_reverseEdges[faceEdge.reverseEdge].metric = metric;
+      faces.push_back (face);
+    }
+}
+
+bool
+GlobalRoutingGraph::IsAffected (uint32_t face, const DistanceList& distances) const
+{
+  const FaceEdge& faceEdge = m_faceEdges[face];
+  const Distance& current = distances[faceEdge.source];
+  if (current.face == face)
+    return true;
+
+  const Distance& behind = distances[faceEdge.target];
+  if (behind.cost >= INFINITE_COST)
+    return false;
+
+  Distance candidate = ReverseDistanceCombine () (behind, m_edges[faceEdge.edge]);
+  return candidate.cost < INFINITE_COST && DistanceCompare () (candidate, current);
+}
+
+void
+GlobalRoutingGraph::ShortestPaths (uint32_t source, DistanceList& distances) const
+{
+  RunDijkstra (m_graph, m_edges, source, distances, DistanceCombine (), boost::dummy_property_map ());
+}
+
+void
+GlobalRoutingGraph::ReverseShortestPaths (uint32_t destination, DistanceList& distances) const
+{
+  RunDijkstra (m_reverseGraph, m_reverseEdges, destination, distances, ReverseDistanceCombine (),
+               boost::dummy_property_map ());
+}
+
+void
+GlobalRoutingGraph::FaceCosts (uint32_t destination, FaceCostList& costs) const
+{
+  const uint32_t nVertices = m_routers.size ();
+  const uint32_t unvisited = std::numeric_limits<uint32_t>::max ();
+
+  // in the reverse graph, predecessor of a vertex is its next vertex towards the destination
+  DistanceList distances;
+  std::vector<uint32_t> nextVertex (nVertices);
+  RunDijkstra (m_reverseGraph, m_reverseEdges, destination, distances, ReverseDistanceCombine (),
+               boost::make_iterator_property_map (nextVertex.begin (),
+                                                  get (boost::vertex_index, m_reverseGraph)));
+
+  // number the shortest path tree in pre-order: u is on the path from v to the destination
+  // iff order[u] <= order[v] < order[u] + subtreeSize[u]
+  std::vector<uint32_t> firstChild (nVertices, unvisited);
+  std::vector<uint32_t> nextSibling (nVertices, unvisited);
+  for (uint32_t vertex = 0; vertex < nVertices; vertex++)
+    {
+      if (vertex == destination || distances[vertex].cost >= INFINITE_COST)
+        continue;
+
+      nextSibling[vertex] = firstChild[nextVertex[vertex]];
+      firstChild[nextVertex[vertex]] = vertex;
+    }
+
+  std::vector<uint32_t> order (nVertices, unvisited);
+  std::vector<uint32_t> subtreeSize (nVertices, 1);
+  std::vector<uint32_t> preorder;
+  std::vector<uint32_t> stack (1, destination);
+  while (!stack.empty ())
+    {
+      uint32_t vertex = stack.back ();
+      stack.pop_back ();
+
+      order[vertex] = preorder.size ();
+      preorder.push_back (vertex);
+      for (uint32_t child = firstChild[vertex]; child != unvisited; child = nextSibling[child])
+        {
+          stack.push_back (child);
+        }
+    }
+  for (std::vector<uint32_t>::reverse_iterator vertex = preorder.rbegin (); vertex != preorder.rend (); vertex++)
+    {
+      if (*vertex != destination)
+        subtreeSize[nextVertex[*vertex]] += subtreeSize[*vertex];
+    }
+
+  // Neighbors in the subtree of a vertex reach the destination through the vertex itself.
+  // Their distances avoiding the vertex are calculated with a Dijkstra restricted to the
+  // subtree (contiguous in pre-order), seeded with edges leaving the subtree: vertices
+  // outside of the subtree have tree paths that do not contain the vertex.
+  std::vector<uint32_t> avoiding (nVertices, INFINITE_COST);
+  typedef std::pair<uint32_t, uint32_t> QueueItem; // distance, vertex
+  std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem> > queue;
+
+  costs.clear ();
+  for (uint32_t vertex = 0; vertex < nVertices; vertex++)
+    {
+      if (vertex == destination)
+        continue;
+
+      bool inTree = order[vertex] != unvisited;
+      uint32_t subtreeBegin = inTree ? order[vertex] + 1 : 0;
+      uint32_t subtreeEnd = inTree ? order[vertex] + subtreeSize[vertex] : 0;
+      bool hasAvoidingDistances = false;
+
+      boost::graph_traits<Csr>::out_edge_iterator edge, edgeEnd;
+      for (boost::tie (edge, edgeEnd) = out_edges (vertex, m_graph); edge != edgeEnd; edge++)
+        {
+          const Edge& properties = m_edges[get (boost::edge_index, m_graph, *edge)];
+          uint32_t neighbor = target (*edge, m_graph);
+
+          if (properties.face == 0 ||
+              // value reserved to disable a face, see CalculateAllPossibleRoutes
+              properties.metric == std::numeric_limits<uint16_t>::max () - 1)
+            continue;
+
+          uint32_t distance = distances[neighbor].cost;
+          if (inTree && subtreeBegin <= order[neighbor] && order[neighbor] < subtreeEnd)
+            {
+              if (!hasAvoidingDistances)
+                {
+                  CalculateAvoidingDistances (vertex, preorder, subtreeBegin, subtreeEnd, order,
+                                              distances, avoiding, queue);
+                  hasAvoidingDistances = true;
+                }
+              distance = avoiding[neighbor];
+            }
+
+          uint32_t cost = properties.metric + distance;
+          if (distance >= INFINITE_COST || cost >= INFINITE_COST)
+            continue; // unreachable through this face
+
+          FaceCost faceCost = { vertex, properties.face, cost };
+          costs.push_back (faceCost);
+        }
+
+      if (hasAvoidingDistances)
+        {
+          for (uint32_t i = subtreeBegin; i < subtreeEnd; i++)
+            {
+              avoiding[preorder[i]] = INFINITE_COST;
+            }
+        }
+    }
+}
+
+void
+GlobalRoutingGraph::CalculateAvoidingDistances (uint32_t vertex, const std::vector<uint32_t>& preorder,
+                                                uint32_t subtreeBegin, uint32_t subtreeEnd,
+                                                const std::vector<uint32_t>& order,
+                                                const DistanceList& distances,
+                                                std::vector<uint32_t>& avoiding,
+                                                AvoidingQueue& queue) const
+{
+  for (uint32_t i = subtreeBegin; i < subtreeEnd; i++)
+    {
+      uint32_t member = preorder[i];
+
+      boost::graph_traits<Csr>::out_edge_iterator edge, edgeEnd;
+      for (boost::tie (edge, edgeEnd) = out_edges (member, m_graph); edge != edgeEnd; edge++)
+        {
+          uint32_t neighbor = target (*edge, m_graph);
+          if (neighbor == vertex ||
+              (subtreeBegin <= order[neighbor] && order[neighbor] < subtreeEnd) ||
+              distances[neighbor].cost >= INFINITE_COST)
+            continue;
+
+          uint32_t distance = m_edges[get (boost::edge_index, m_graph, *edge)].metric + distances[neighbor].cost;
+          if (distance < avoiding[member])
+            avoiding[member] = distance;
+        }
+
+      if (avoiding[member] < INFINITE_COST)
+        queue.push (std::make_pair (avoiding[member], member));
+    }
+
+  while (!queue.empty ())
+    {
+      uint32_t distance = queue.top ().first;
+      uint32_t member = queue.top ().second;
+      queue.pop ();
+      if (distance != avoiding[member])
+        continue; // stale item
+
+      // edges towards member, from other members of the subtree
+      boost::graph_traits<Csr>::out_edge_iterator edge, edgeEnd;
+      for (boost::tie (edge, edgeEnd) = out_edges (member, m_reverseGraph); edge != edgeEnd; edge++)
+        {
+          uint32_t other = target (*edge, m_reverseGraph);
+          if (!(subtreeBegin <= order[other] && order[other] < subtreeEnd))
+            continue;
+
+          uint32_t otherDistance = distance + m_reverseEdges[get (boost::edge_index, m_reverseGraph, *edge)].metric;
+          if (otherDistance < avoiding[other])
+            {
+              avoiding[other] = otherDistance;
+              queue.push (std::make_pair (otherDistance, other));
+            }
+        }
+    }
+}
+
+void
+GlobalRoutingGraph::ShortestPaths (const std::vector<uint32_t>& sources,
+                                   std::vector<DistanceList>& distances,
+                                   uint32_t nThreads) const
+{
+  RunInParallel (&GlobalRoutingGraph::ShortestPaths, sources, distances, nThreads);
+}
+
+void
+GlobalRoutingGraph::ReverseShortestPaths (const std::vector<uint32_t>& destinations,
+                                          std::vector<DistanceList>& distances,
+                                          uint32_t nThreads) const
+{
+  RunInParallel (&GlobalRoutingGraph::ReverseShortestPaths, destinations, distances, nThreads);
+}
+
+void
+GlobalRoutingGraph::FaceCosts (const std::vector<uint32_t>& destinations,
+                               std::vector<FaceCostList>& costs,
+                               uint32_t nThreads) const
+{
+  RunInParallel (&GlobalRoutingGraph::FaceCosts, destinations, costs, nThreads);
+}
+
+template<class Result>
+void
+GlobalRoutingGraph::RunInParallel (void (GlobalRoutingGraph::*computation) (uint32_t, Result&) const,
+                                   const std::vector<uint32_t>& roots, std::vector<Result>& results,
+                                   uint32_t nThreads) const
+{
+  results.resize (roots.size ());
+
+  std::atomic<size_t> next (0);
+  auto worker = [&] {
+    for (size_t i = next++; i < roots.size (); i = next++)
+      {
+        (this->*computation) (roots[i], results[i]);
+      }
+  };
+
+  nThreads = std::max<uint32_t> (1, std::min<size_t> (nThreads, roots.size ()));
+
+  std::vector<std::thread> threads;
+  for (uint32_t i = 1; i < nThreads; i++)
+    {
+      threads.push_back (std::thread (worker));
+    }
+
+  worker ();
+
+  for (std::vector<std::thread>::iterator thread = threads.begin (); thread != threads.end (); thread++)
+    {
+      thread->join ();
+    }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,293 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 UCLA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author:  Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDN_GLOBAL_ROUTING_GRAPH_H
+#define NDN_GLOBAL_ROUTING_GRAPH_H
+
+/// @cond include_hidden
+
+#include "ns3/ptr.h"
+
+#include <boost/graph/compressed_sparse_row_graph.hpp>
+
+#include <vector>
+#include <queue>
+#include <unordered_map>
+
+namespace ns3 {
+namespace ndn {
+
+class GlobalRouter;
+class Face;
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Flat snapshot of the GlobalRouter graph used for route calculation
+ *
+ * Routers are numbered densely and their incidencies are stored in a compressed sparse
+ * row graph, with faces and metrics copied into plain arrays.  Paths are compared by cost
+ * and equal-cost paths by the index of their first-hop face, so the next hop selected for
+ * a pair of routers does not depend on the direction or order of the computation.
+ *
+ * Faces that are down are given INFINITE_COST metric and are not used by any path.
+ * UpdateFaceMetrics refreshes metrics after faces were brought up or down, without taking a
+ * new snapshot.
+ *
+ * Shortest path computations only read the snapshot and never touch ns-3 objects, so
+ * several of them can run concurrently.
+ */
+class GlobalRoutingGraph
+{
+public:
+  /**
+   * @brief Edge of the snapshot
+   */
+  struct Edge
+  {
+    uint32_t face;   ///< @brief index of the face in the face table, 0 for channel-to-node edges
+    uint16_t metric; ///< @brief routing metric of the face at the time of the snapshot
+  };
+
+  /**
+   * @brief Distance from the source of a shortest path computation
+   */
+  struct Distance
+  {
+    uint32_t face; ///< @brief index of the first-hop face on the source, 0 if none
+    uint32_t cost; ///< @brief sum of face metrics along the path
+  };
+
+  typedef std::vector<Distance> DistanceList;
+
+  /**
+   * @brief Cost of reaching a destination from a vertex through one of its faces
+   */
+  struct FaceCost
+  {
+    uint32_t vertex;
+    uint32_t face; ///< @brief index of the face in the face table
+    uint32_t cost;
+  };
+
+  typedef std::vector<FaceCost> FaceCostList;
+
+  /**
+   * @brief Cost of unreachable vertices (same as WeightInf of NdnGlobalRouterGraph)
+   */
+  static const uint32_t INFINITE_COST;
+
+  /**
+   * @brief Snapshot all GlobalRouter objects installed on nodes and channels
+   */
+  GlobalRoutingGraph ();
+
+  size_t
+  GetNVertices () const;
+
+  /**
+   * @brief Get vertex index of the router, or GetNVertices () if router is not in the snapshot
+   */
+  uint32_t
+  GetVertex (const Ptr<GlobalRouter>& router) const;
+
+  const Ptr<GlobalRouter>&
+  GetRouter (uint32_t vertex) const;
+
+  /**
+   * @brief Get face by its index in the face table (0 corresponds to no face)
+   */
+  const Ptr<Face>&
+  GetFace (uint32_t face) const;
+
+  /**
+   * @brief Get number of entries in the face table, including face 0
+   */
+  size_t
+  GetNFaces () const;
+
+  /**
+   * @brief Refresh face metrics of the snapshot from current metrics and states of the faces
+   * @param faces filled with indices of faces whose metric changed
+   *
+   * Must not be called concurrently with shortest path computations.
+   */
+  void
+  UpdateFaceMetrics (std::vector<uint32_t>& faces);
+
+  /**
+   * @brief Check whether reverse shortest paths towards a destination may change after the
+   *        metric of the face was updated
+   * @param face index of the updated face
+   * @param distances result of ReverseShortestPaths calculated before the update
+   *
+   * Paths change only if the face was the first hop of its vertex, or if the face now gives
+   * its vertex a shorter path; in both cases the vertex is affected first.
+   */
+  bool
+  IsAffected (uint32_t face, const DistanceList& distances) const;
+
+  /**
+   * @brief Run Dijkstra algorithm from the source vertex
+   * @param source vertex index of the source
+   * @param distances resized to GetNVertices () and filled with distances from the source
+   *
+   * Safe to call concurrently from several threads.
+   */
+  void
+  ShortestPaths (uint32_t source, DistanceList& distances) const;
+
+  /**
+   * @brief Run Dijkstra algorithm from each of the sources using up to nThreads threads
+   * @param sources vertex indices of the sources
+   * @param distances resized to the number of sources, distances[i] is filled with distances
+   *                  from sources[i]
+   * @param nThreads maximum number of threads (the calling thread is one of them)
+   */
+  void
+  ShortestPaths (const std::vector<uint32_t>& sources, std::vector<DistanceList>& distances,
+                 uint32_t nThreads) const;
+
+  /**
+   * @brief Run Dijkstra algorithm towards the destination vertex over reversed edges
+   * @param destination vertex index of the destination
+   * @param distances resized to GetNVertices (); distances[v] is filled with the distance
+   *                  from v to the destination and the first-hop face on v
+   *
+   * distances[v] is the same as distances[destination] after ShortestPaths (v, distances).
+   * Safe to call concurrently from several threads.
+   */
+  void
+  ReverseShortestPaths (uint32_t destination, DistanceList& distances) const;
+
+  /**
+   * @brief Run reverse Dijkstra algorithm towards each of the destinations using up to
+   *        nThreads threads
+   */
+  void
+  ReverseShortestPaths (const std::vector<uint32_t>& destinations,
+                        std::vector<DistanceList>& distances, uint32_t nThreads) const;
+
+  /**
+   * @brief Calculate cost of reaching the destination through every face of every vertex
+   * @param destination vertex index of the destination
+   * @param costs filled with costs, ordered by vertex and then by face
+   *
+   * Cost through a face is the face metric plus the distance from the neighbor behind the
+   * face to the destination over paths that do not return through the vertex.  The
+   * distances come from a single reverse shortest path tree; only neighbors whose tree path
+   * leads back through the vertex need an additional search, limited to the vertex's
+   * subtree.  Faces through which the destination is unreachable and faces of the
+   * destination itself are skipped.
+   *
+   * Safe to call concurrently from several threads.
+   */
+  void
+  FaceCosts (uint32_t destination, FaceCostList& costs) const;
+
+  /**
+   * @brief Calculate face costs towards each of the destinations using up to nThreads threads
+   */
+  void
+  FaceCosts (const std::vector<uint32_t>& destinations, std::vector<FaceCostList>& costs,
+             uint32_t nThreads) const;
+
+private:
+  typedef std::priority_queue< std::pair<uint32_t, uint32_t>,
+                               std::vector< std::pair<uint32_t, uint32_t> >,
+                               std::greater< std::pair<uint32_t, uint32_t> > > AvoidingQueue;
+
+  /**
+   * @brief Calculate distances to the destination that avoid the vertex, for all vertices
+   *        of its subtree in the shortest path tree (preorder[subtreeBegin..subtreeEnd))
+   */
+  void
+  CalculateAvoidingDistances (uint32_t vertex, const std::vector<uint32_t>& preorder,
+                              uint32_t subtreeBegin, uint32_t subtreeEnd,
+                              const std::vector<uint32_t>& order,
+                              const DistanceList& distances,
+                              std::vector<uint32_t>& avoiding,
+                              AvoidingQueue& queue) const;
+
+  static uint16_t
+  GetMetric (const Ptr<Face>& face);
+
+  template<class Result>
+  void
+  RunInParallel (void (GlobalRoutingGraph::*computation) (uint32_t, Result&) const,
+                 const std::vector<uint32_t>& roots, std::vector<Result>& results,
+                 uint32_t nThreads) const;
+
+private:
+  /**
+   * @brief Location of the face in the snapshot
+   */
+  struct FaceEdge
+  {
+    uint32_t source;      ///< @brief vertex of the face
+    uint32_t target;      ///< @brief vertex behind the face
+    uint32_t edge;        ///< @brief index of the edge in m_edges
+    uint32_t reverseEdge; ///< @brief index of the edge in m_reverseEdges
+  };
+
+  typedef boost::compressed_sparse_row_graph<boost::directedS,
+                                             boost::no_property, boost::no_property,
+                                             boost::no_property,
+                                             uint32_t, uint32_t> Csr;
+
+  Csr m_graph;
+  std::vector<Edge> m_edges; // indexed by CSR edge index
+  Csr m_reverseGraph;
+  std::vector<Edge> m_reverseEdges; // face and metric of the original edge
+  std::vector< Ptr<GlobalRouter> > m_routers;
+  std::vector< Ptr<Face> > m_faces;
+  std::vector<FaceEdge> m_faceEdges; // indexed by face
+  std::unordered_map<uint32_t, uint32_t> m_vertexById; // GlobalRouter::GetId () -> vertex
+};
+
+inline size_t
+GlobalRoutingGraph::GetNVertices () const
+{
+  return m_routers.size ();
+}
+
+inline const Ptr<GlobalRouter>&
+GlobalRoutingGraph::GetRouter (uint32_t vertex) const
+{
+  return m_routers[vertex];
+}
+
+inline const Ptr<Face>&
+GlobalRoutingGraph::GetFace (uint32_t face) const
+{
+  return m_faces[face];
+}
+
+inline size_t
+GlobalRoutingGraph::GetNFaces () const
+{
+  return m_faces.size ();
+}
+
+} // namespace ndn
+} // namespace ns3
+
+/// @endcond
+
+#endif // NDN_GLOBAL_ROUTING_GRAPH_H
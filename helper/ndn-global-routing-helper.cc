@@ -45,25 +45,30 @@
 #include "ns3/node-list.h"
 #include "ns3/channel-list.h"
 #include "ns3/object-factory.h"
+#include "ns3/simulator.h"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/foreach.hpp>
-#include <boost/concept/assert.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 
 #include "ns3/ndnSIM/NFD/daemon/table/fib-entry.hpp"
 #include "ns3/ndnSIM/NFD/daemon/table/fib-nexthop.hpp"
 
-#include <boost/graph/dijkstra_shortest_paths.hpp>
-
-#include "boost-graph-ndn-global-routing-helper.h"
+#include "ndn-global-routing-graph.h"
 
 #include <math.h>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <set>
+#include <thread>
 
 NS_LOG_COMPONENT_DEFINE ("ndn.GlobalRoutingHelper");
 
 using namespace std;
 using namespace boost;
-using nfd::ControlParameters;
 
 namespace ns3 {
 namespace ndn {
@@ -242,23 +247,242 @@ GlobalRoutingHelper::AddOriginsForAll ()
     }
 }
 
+uint32_t GlobalRoutingHelper::m_nThreads = 0;
+bool GlobalRoutingHelper::m_isIncremental = false;
+
+void
+GlobalRoutingHelper::SetNThreads (uint32_t nThreads)
+{
+  m_nThreads = nThreads;
+}
+
+void
+GlobalRoutingHelper::SetIncrementalUpdates (bool isEnabled)
+{
+  m_isIncremental = isEnabled;
+}
+
+uint32_t
+GlobalRoutingHelper::GetNThreads ()
+{
+  if (m_nThreads != 0)
+    return m_nThreads;
+
+  return std::max (1u, std::thread::hardware_concurrency ());
+}
+
+namespace {
+
+void
+AddRoute (std::vector<FibHelper::Route>& routes, const Name& prefix, const Ptr<Face>& face, uint32_t cost)
+{
+  NS_LOG_DEBUG (" prefix " << prefix << " reachable via face " << *face
+                << " with distance " << cost);
+
+  routes.push_back (FibHelper::Route (prefix, face, cost));
+}
+
+// prefixes routes were installed for by the last CalculateRoutes, CalculateAllPossibleRoutes
+// or LoadRoutes
+std::set<Name> g_routedPrefixes;
+
+/**
+ * Withdraw routes installed for g_routedPrefixes through faces known to GlobalRouter.  Other
+ * routes, such as default routes of StackHelper or routes through application faces, are kept.
+ */
+void
+InvalidateRoutes (const Ptr<Node>& node)
+{
+  if (g_routedPrefixes.empty ())
+    return;
+
+  Ptr<L3Protocol> L3protocol = node->GetObject<L3Protocol> ();
+  shared_ptr<Forwarder> forwarder = L3protocol->GetForwarder();
+  ::nfd::Fib& fib = forwarder->getFib ();
+
+  std::vector< shared_ptr< ::nfd::Face> > faces;
+  const GlobalRouter::IncidencyList& incidencies = node->GetObject<GlobalRouter> ()->GetIncidencies ();
+  for (GlobalRouter::IncidencyList::const_iterator i = incidencies.begin (); i != incidencies.end (); i++)
+    {
+      shared_ptr< ::nfd::Face> face = forwarder->getFace (i->get<1> ()->getId ());
+      if (static_cast<bool> (face))
+        faces.push_back (face);
+    }
+
+  for (std::set<Name>::const_iterator prefix = g_routedPrefixes.begin (); prefix != g_routedPrefixes.end (); prefix++)
+    {
+      shared_ptr< ::nfd::fib::Entry> entry = fib.findExactMatch (*prefix);
+      if (!static_cast<bool> (entry))
+        continue;
+
+      for (std::vector< shared_ptr< ::nfd::Face> >::iterator face = faces.begin (); face != faces.end (); face++)
+        {
+          entry->removeNextHop (*face);
+        }
+      if (!entry->hasNextHops ())
+        fib.erase (*entry);
+    }
+}
+
+/**
+ * Snapshot and reverse shortest path trees used by the last CalculateRoutes, kept to update
+ * routes incrementally (see SetIncrementalUpdates).  Distances take #origins x #vertices x 8
+ * bytes, so they are kept only on request.
+ */
+struct RoutingState
+{
+  GlobalRoutingGraph graph;
+  std::vector< Ptr<Node> > nodes;
+  std::vector<uint32_t> sources; // vertex of nodes[i]
+  std::vector<uint32_t> origins;
+  std::vector<GlobalRoutingGraph::DistanceList> distances; // distances[i] towards origins[i]
+  std::map<Name, std::vector<uint32_t> > originsOfPrefix; // indices in origins, in increasing order
+};
+
+std::unique_ptr<RoutingState> g_routingState;
+bool g_allPossibleRoutes = false; // routes were last calculated by CalculateAllPossibleRoutes
+
+void
+ResetRoutingState ()
+{
+  g_routingState.reset ();
+}
+
+bool g_isResetScheduled = false;
+
+void
+ResetRoutes ()
+{
+  ResetRoutingState ();
+  g_routedPrefixes.clear ();
+  g_allPossibleRoutes = false;
+  g_isResetScheduled = false;
+}
+
+/**
+ * Remember prefixes of the installed routes, so that the next calculation can withdraw them
+ */
+void
+SetRoutedPrefixes (std::set<Name>& prefixes)
+{
+  g_routedPrefixes.swap (prefixes);
+
+  if (!g_isResetScheduled)
+    {
+      Simulator::ScheduleDestroy (&ResetRoutes);
+      g_isResetScheduled = true;
+    }
+}
+
+/**
+ * Reverse shortest path tree towards every origin: O(#origins) Dijkstra runs
+ *
+ * For every node and prefix next hops are added by origin vertex, which gives the same FIBs
+ * as calculating a shortest path tree from every node.  Trees are calculated and routes
+ * installed one batch of origins at a time, which bounds memory used by the trees unless they
+ * are kept in state.distances.
+ */
+void
+CalculateRoutesToOrigins (RoutingState& state, uint32_t nThreads, bool keepDistances)
+{
+  size_t batchSize = nThreads * 16;
+
+  std::vector<uint32_t> batch;
+  std::vector<GlobalRoutingGraph::DistanceList> distances;
+  std::vector< std::vector<FibHelper::Route> > routes (state.nodes.size ());
+  for (size_t first = 0; first < state.origins.size (); first += batchSize)
+    {
+      size_t last = std::min (first + batchSize, state.origins.size ());
+      batch.assign (state.origins.begin () + first, state.origins.begin () + last);
+
+      state.graph.ReverseShortestPaths (batch, distances, nThreads);
+
+      for (size_t i = first; i < last; i++)
+        {
+          const GlobalRoutingGraph::DistanceList& distancesToOrigin = distances[i - first];
+          const GlobalRouter::LocalPrefixList& prefixes = state.graph.GetRouter (state.origins[i])->GetLocalPrefixes ();
+
+          for (size_t node = 0; node < state.nodes.size (); node++)
+            {
+              const GlobalRoutingGraph::Distance& distance = distancesToOrigin[state.sources[node]];
+              if (state.sources[node] == state.origins[i] || distance.face == 0)
+                continue; // self or unreachable
+
+              BOOST_FOREACH (const shared_ptr<const Name> &prefix, prefixes)
+                {
+                  AddRoute (routes[node], *prefix, state.graph.GetFace (distance.face), distance.cost);
+                }
+            }
+        }
+
+      for (size_t node = 0; node < state.nodes.size (); node++)
+        {
+          if (routes[node].empty ())
+            continue;
+
+          FibHelper::AddRoutes (state.nodes[node], routes[node]);
+          routes[node].clear ();
+        }
+
+      if (keepDistances)
+        {
+          for (size_t i = 0; i < distances.size (); i++)
+            {
+              state.distances.push_back (GlobalRoutingGraph::DistanceList ());
+              state.distances.back ().swap (distances[i]);
+            }
+        }
+    }
+}
+
+typedef std::vector< std::pair<uint32_t, uint32_t> > NextHopList; // face, cost
+
+/**
+ * Next hops towards the origins of a prefix on the node, as CalculateRoutesToOrigins leaves
+ * them in the FIB: one next hop per face, with the cost of the last origin
+ */
+void
+GetNextHops (const RoutingState& state, uint32_t node, const std::vector<uint32_t>& origins,
+             const std::vector<const GlobalRoutingGraph::DistanceList*>& distances,
+             NextHopList& nextHops)
+{
+  nextHops.clear ();
+  for (std::vector<uint32_t>::const_iterator origin = origins.begin (); origin != origins.end (); origin++)
+    {
+      const GlobalRoutingGraph::Distance& distance = (*distances[*origin])[state.sources[node]];
+      if (state.sources[node] == state.origins[*origin] || distance.face == 0)
+        continue; // self or unreachable
+
+      NextHopList::iterator nextHop = nextHops.begin ();
+      while (nextHop != nextHops.end () && nextHop->first != distance.face)
+        nextHop++;
+
+      if (nextHop == nextHops.end ())
+        nextHops.push_back (std::make_pair (distance.face, distance.cost));
+      else
+        nextHop->second = distance.cost;
+    }
+}
+
+} // namespace
+
 void
 GlobalRoutingHelper::CalculateRoutes (bool invalidatedRoutes/* = true*/)
 {
   /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
+   * The router graph is snapshotted into a compressed sparse row graph (see GlobalRoutingGraph)
+   * and one reverse shortest path tree per origin is calculated on it with Boost Graph Library,
+   * in parallel.  This gives the same routes as a shortest path tree from every node.
    * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
+   *
+   * Trees are calculated and routes installed on the main thread one batch of origins at a
+   * time, to bound memory used by the trees.  The snapshot and the trees are kept for
+   * UpdateRoutes only if SetIncrementalUpdates (true) was called.
    */
 
-  BOOST_CONCEPT_ASSERT(( VertexListGraphConcept< NdnGlobalRouterGraph > ));
-  BOOST_CONCEPT_ASSERT(( IncidenceGraphConcept< NdnGlobalRouterGraph > ));
-
-  NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+  std::unique_ptr<RoutingState> state (new RoutingState);
+  const GlobalRoutingGraph& graph = state->graph;
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by the graph, which
-  // is not obviously how implement in an efficient manner
   for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
     {
       Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter> ();
@@ -268,93 +492,169 @@ GlobalRoutingHelper::CalculateRoutes (bool invalidatedRoutes/* = true*/)
 	  continue;
 	}
 
-      DistancesMap    distances;
-
-      dijkstra_shortest_paths (graph, source,
-			       // predecessor_map (boost::ref(predecessors))
-			       // .
-			       distance_map (boost::ref(distances))
-			       .
-			       distance_inf (WeightInf)
-			       .
-			       distance_zero (WeightZero)
-			       .
-			       distance_compare (boost::WeightCompare ())
-			       .
-			       distance_combine (boost::WeightCombine ())
-			       );
-
-      // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
-
-      Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol> ();
-      shared_ptr<Forwarder> forwarder = L3protocol->GetForwarder();
-
-      if (invalidatedRoutes) {
-        std::vector<::nfd::fib::NextHop> NextHopList;
-        for (::nfd::NameTree::const_iterator it = forwarder->getNameTree().fullEnumerate
-               (&(nfd::predicate_NameTreeEntry_hasFibEntry)); it != forwarder->getNameTree()
-               .end();) {
-          NextHopList.clear ();
-          shared_ptr<::nfd::fib::Entry> entry = it->getFibEntry();
-          ++it;
-          NextHopList = entry->getNextHops();
-          for (int i = 0; i < NextHopList.size (); i++) {
-            NextHopList[i].setCost(std::numeric_limits<uint64_t>::max ());
-          }
+      state->nodes.push_back (*node);
+      state->sources.push_back (graph.GetVertex (source));
+    }
+
+  for (uint32_t vertex = 0; vertex < graph.GetNVertices (); vertex++)
+    {
+      const GlobalRouter::LocalPrefixList& prefixes = graph.GetRouter (vertex)->GetLocalPrefixes ();
+      if (prefixes.empty ())
+        continue;
+
+      BOOST_FOREACH (const shared_ptr<const Name> &prefix, prefixes)
+        {
+          state->originsOfPrefix[*prefix].push_back (state->origins.size ());
         }
+      state->origins.push_back (vertex);
+    }
 
-      }
+  if (invalidatedRoutes)
+    {
+      for (std::vector< Ptr<Node> >::iterator node = state->nodes.begin (); node != state->nodes.end (); node++)
+        {
+          InvalidateRoutes (*node);
+        }
+    }
 
-      NS_LOG_DEBUG ("Reachability from Node: " << source->GetObject<Node> ()->GetId ());
-      for (DistancesMap::iterator i = distances.begin ();
-	   i != distances.end ();
-	   i++)
-	{
-	  if (i->first == source)
-	    continue;
-	  else
-	    {
-	      // cout << "  Node " << i->first->GetObject<Node> ()->GetId ();
-	      if (i->second.get<0> () == 0)
-		{
-		  // cout << " is unreachable" << endl;
-		}
-	      else
-		{
-                  BOOST_FOREACH (const shared_ptr<const Name> &prefix, i->first->GetLocalPrefixes ())
-                    {
-                      NS_LOG_DEBUG (" prefix " << prefix << " reachable via face " << *i->second.get<0> ()
-                                    << " with distance " << i->second.get<1> ()
-                                    << " with delay " << i->second.get<2> ());
+  std::set<Name> prefixes;
+  for (std::map<Name, std::vector<uint32_t> >::iterator prefix = state->originsOfPrefix.begin ();
+       prefix != state->originsOfPrefix.end (); prefix++)
+    {
+      prefixes.insert (prefixes.end (), prefix->first);
+    }
+  SetRoutedPrefixes (prefixes);
 
-                      //Ptr<fib::Entry> entry = fib->Add (prefix, i->second.get<0> (), i->second.get<1> ());
+  NS_LOG_INFO ("Calculating routes towards " << state->origins.size () << " origins");
+  CalculateRoutesToOrigins (*state, GetNThreads (), m_isIncremental);
 
-                      // shared_ptr<::nfd::fib::Entry> entry = forwarder->getFib().insert(*prefix).first;
-                      // entry->addNextHop((i->second.get<0> ())->shared_from_this (), i->second.get<1> ());
+  if (m_isIncremental)
+    g_routingState = std::move (state);
+  else
+    g_routingState.reset ();
+  g_allPossibleRoutes = false;
+}
 
-                      ControlParameters parameters;
-                      parameters.setName(*prefix);
-                      parameters.setFaceId((i->second.get<0>())->getId());
-                      parameters.setCost (i->second.get<1>());
+void
+GlobalRoutingHelper::UpdateRoutes ()
+{
+  /**
+   * Faces of the snapshot kept by CalculateRoutes are checked for changed metrics and states.
+   * Reverse shortest path trees are recalculated only for origins whose tree used a changed
+   * face or can be shortened by one (see GlobalRoutingGraph::IsAffected).  Then, for nodes
+   * whose distance to such an origin changed, next hops of the origin's prefixes before and
+   * after the change are compared, and only the difference is applied to the FIB.
+   */
 
-                      FibHelper fibHelper;
-                      fibHelper.AddNextHop(parameters, *node);
+  if (g_routingState == 0)
+    {
+      NS_LOG_INFO ("No routing state is kept, recalculating all routes");
+      if (g_allPossibleRoutes)
+        CalculateAllPossibleRoutes ();
+      else
+        CalculateRoutes ();
+      return;
+    }
 
-                      //entry->SetRealDelayToProducer (i->second.get<0> (), Seconds (i->second.get<2> ()));
+  RoutingState& state = *g_routingState;
 
-                      //Ptr<Limits> faceLimits = i->second.get<0> ()->GetObject<Limits> ();
+  std::vector<uint32_t> faces;
+  state.graph.UpdateFaceMetrics (faces);
+  if (faces.empty ())
+    return;
 
-                      // Ptr<Limits> fibLimits = entry->GetObject<Limits> ();
-                      //if (fibLimits != 0)
-                        //{
-                          // if it was created by the forwarding strategy via DidAddFibEntry event
-                          //fibLimits->SetLimits (faceLimits->GetMaxRate (), 2 * i->second.get<2> () /*exact RTT*/);
-                  //NS_LOG_DEBUG ("Set limit for prefix " << *prefix << " " << faceLimits->GetMaxRate () << " / " << 2*i->second.get<2> () << "s (" << faceLimits->GetMaxRate () * 2 * i->second.get<2> () << ")");
-                      //}
-                  }
-		}
-	    }
-	}
+  std::vector<uint32_t> affected; // indices in origins
+  std::vector<uint32_t> affectedOrigins;
+  for (uint32_t i = 0; i < state.origins.size (); i++)
+    {
+      for (std::vector<uint32_t>::iterator face = faces.begin (); face != faces.end (); face++)
+        {
+          if (state.graph.IsAffected (*face, state.distances[i]))
+            {
+              affected.push_back (i);
+              affectedOrigins.push_back (state.origins[i]);
+              break;
+            }
+        }
+    }
+
+  NS_LOG_INFO (faces.size () << " faces changed, updating routes towards " << affected.size ()
+               << " of " << state.origins.size () << " origins");
+  if (affected.empty ())
+    return;
+
+  // new distances are swapped with the kept ones below, after which previous holds the old ones
+  std::vector<GlobalRoutingGraph::DistanceList> previous;
+  state.graph.ReverseShortestPaths (affectedOrigins, previous, GetNThreads ());
+
+  std::vector<const GlobalRoutingGraph::DistanceList*> before (state.origins.size ());
+  std::vector<const GlobalRoutingGraph::DistanceList*> after (state.origins.size ());
+  for (uint32_t i = 0; i < state.origins.size (); i++)
+    {
+      before[i] = after[i] = &state.distances[i];
+    }
+
+  // (node, prefix) pairs whose next hops may have changed
+  std::set< std::pair<uint32_t, Name> > changed;
+  for (uint32_t j = 0; j < affected.size (); j++)
+    {
+      uint32_t i = affected[j];
+      state.distances[i].swap (previous[j]);
+      before[i] = &previous[j];
+
+      for (uint32_t node = 0; node < state.nodes.size (); node++)
+        {
+          const GlobalRoutingGraph::Distance& old = previous[j][state.sources[node]];
+          const GlobalRoutingGraph::Distance& current = state.distances[i][state.sources[node]];
+          if (old.face == current.face && old.cost == current.cost)
+            continue;
+
+          BOOST_FOREACH (const shared_ptr<const Name> &prefix, state.graph.GetRouter (state.origins[i])->GetLocalPrefixes ())
+            {
+              changed.insert (std::make_pair (node, *prefix));
+            }
+        }
+    }
+
+  NextHopList oldNextHops;
+  NextHopList newNextHops;
+  std::vector<FibHelper::Route> added;
+  std::vector<FibHelper::Route> removed;
+  for (std::set< std::pair<uint32_t, Name> >::iterator item = changed.begin (); item != changed.end (); item++)
+    {
+      uint32_t node = item->first;
+      const Name& prefix = item->second;
+      const std::vector<uint32_t>& origins = state.originsOfPrefix[prefix];
+
+      GetNextHops (state, node, origins, before, oldNextHops);
+      GetNextHops (state, node, origins, after, newNextHops);
+
+      for (NextHopList::iterator nextHop = newNextHops.begin (); nextHop != newNextHops.end (); nextHop++)
+        {
+          if (std::find (oldNextHops.begin (), oldNextHops.end (), *nextHop) == oldNextHops.end ())
+            AddRoute (added, prefix, state.graph.GetFace (nextHop->first), nextHop->second);
+        }
+
+      for (NextHopList::iterator nextHop = oldNextHops.begin (); nextHop != oldNextHops.end (); nextHop++)
+        {
+          NextHopList::iterator newNextHop = newNextHops.begin ();
+          while (newNextHop != newNextHops.end () && newNextHop->first != nextHop->first)
+            newNextHop++;
+
+          if (newNextHop == newNextHops.end ())
+            removed.push_back (FibHelper::Route (prefix, state.graph.GetFace (nextHop->first), 0));
+        }
+
+      std::set< std::pair<uint32_t, Name> >::iterator next = item;
+      next++;
+      if (next == changed.end () || next->first != node)
+        {
+          // add first, so that FIB entries that only change next hops are not erased
+          FibHelper::AddRoutes (state.nodes[node], added);
+          FibHelper::RemoveRoutes (state.nodes[node], removed);
+          added.clear ();
+          removed.clear ();
+        }
     }
 }
 
@@ -362,19 +662,17 @@ void
 GlobalRoutingHelper::CalculateAllPossibleRoutes (bool invalidatedRoutes/* = true*/)
 {
   /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
+   * For every origin, one reverse shortest path tree gives the distance from every router to
+   * the origin.  Cost of reaching the origin through a face is then the face metric plus the
+   * distance of the neighbor behind the face, over paths that do not come back through the
+   * router (see GlobalRoutingGraph::FaceCosts).  This gives the same routes as enabling faces
+   * of a node one by one and calculating shortest paths for each of them.
    */
 
-  BOOST_CONCEPT_ASSERT(( VertexListGraphConcept< NdnGlobalRouterGraph > ));
-  BOOST_CONCEPT_ASSERT(( IncidenceGraphConcept< NdnGlobalRouterGraph > ));
-
-  NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+  GlobalRoutingGraph graph;
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by the graph, which
-  // is not obviously how implement in an efficient manner
+  std::vector< Ptr<Node> > nodes;
+  std::vector<uint32_t> nodeOfVertex (graph.GetNVertices (), std::numeric_limits<uint32_t>::max ());
   for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
     {
       Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter> ();
@@ -384,130 +682,507 @@ GlobalRoutingHelper::CalculateAllPossibleRoutes (bool invalidatedRoutes/* = true
 	  continue;
 	}
 
-      Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol> ();
-      shared_ptr<Forwarder> forwarder = L3protocol->GetForwarder();
-
-      if (invalidatedRoutes) {
-        std::vector<::nfd::fib::NextHop> NextHopList;
-        for (nfd::NameTree::const_iterator it = forwarder->getNameTree().fullEnumerate
-               (&(nfd::predicate_NameTreeEntry_hasFibEntry)); it != forwarder->getNameTree()
-               .end();) {
-          NextHopList.clear ();
-          shared_ptr<::nfd::fib::Entry> entry = it->getFibEntry();
-          ++it;
-          NextHopList = entry->getNextHops();
-          for (int i = 0; i < NextHopList.size (); i++) {
-            NextHopList[i].setCost(std::numeric_limits<uint64_t>::max ());
-          }
+      nodeOfVertex[graph.GetVertex (source)] = nodes.size ();
+      nodes.push_back (*node);
+    }
+
+  std::vector<uint32_t> origins;
+  std::set<Name> prefixes;
+  for (uint32_t vertex = 0; vertex < graph.GetNVertices (); vertex++)
+    {
+      const GlobalRouter::LocalPrefixList& localPrefixes = graph.GetRouter (vertex)->GetLocalPrefixes ();
+      if (localPrefixes.empty ())
+        continue;
+
+      origins.push_back (vertex);
+      BOOST_FOREACH (const shared_ptr<const Name> &prefix, localPrefixes)
+        {
+          prefixes.insert (*prefix);
         }
-      }
-      //NS_ASSERT (fib != 0);
+    }
+
+  if (invalidatedRoutes)
+    {
+      for (std::vector< Ptr<Node> >::iterator node = nodes.begin (); node != nodes.end (); node++)
+        {
+          InvalidateRoutes (*node);
+        }
+    }
+  SetRoutedPrefixes (prefixes);
 
-      NS_LOG_DEBUG ("===========");
-      NS_LOG_DEBUG ("Reachability from Node: " << source->GetObject<Node> ()->GetId () << " ("
-                    << Names::FindName (source->GetObject<Node> ()) << ")");
+  // next hops installed here are not tracked, UpdateRoutes will recalculate all of them
+  ResetRoutingState ();
+  g_allPossibleRoutes = true;
 
-      Ptr<L3Protocol> l3 = source->GetObject<L3Protocol> ();
-      NS_ASSERT (l3 != 0);
+  NS_LOG_INFO ("Calculating all possible routes towards " << origins.size () << " origins");
 
-      // remember interface statuses
-      std::vector<uint16_t> originalMetric (l3->GetNFaces ());
-      for (uint32_t faceId = 0; faceId < l3->GetNFaces (); faceId++)
+  uint32_t nThreads = GetNThreads ();
+  size_t batchSize = nThreads * 16;
+
+  std::vector<uint32_t> batch;
+  std::vector<GlobalRoutingGraph::FaceCostList> costs;
+  std::vector< std::vector<FibHelper::Route> > routes (nodes.size ());
+  for (size_t first = 0; first < origins.size (); first += batchSize)
+    {
+      size_t last = std::min (first + batchSize, origins.size ());
+      batch.assign (origins.begin () + first, origins.begin () + last);
+
+      graph.FaceCosts (batch, costs, nThreads);
+
+      for (size_t i = first; i < last; i++)
         {
-          originalMetric[faceId] = l3->GetFace (faceId)->GetMetric ();
-          l3->GetFace (faceId)->SetMetric (std::numeric_limits<uint16_t>::max ()-1);
-          // value std::numeric_limits<uint16_t>::max () MUST NOT be used (reserved)
+          const GlobalRouter::LocalPrefixList& prefixes = graph.GetRouter (origins[i])->GetLocalPrefixes ();
+
+          const GlobalRoutingGraph::FaceCostList& costsToOrigin = costs[i - first];
+          for (GlobalRoutingGraph::FaceCostList::const_iterator cost = costsToOrigin.begin ();
+               cost != costsToOrigin.end ();
+               cost++)
+            {
+              uint32_t node = nodeOfVertex[cost->vertex];
+              if (node == std::numeric_limits<uint32_t>::max ())
+                continue; // channel
+
+              BOOST_FOREACH (const shared_ptr<const Name> &prefix, prefixes)
+                {
+                  AddRoute (routes[node], *prefix, graph.GetFace (cost->face), cost->cost);
+                }
+            }
         }
 
-      for (uint32_t enabledFaceId = 0; enabledFaceId < l3->GetNFaces (); enabledFaceId++)
+      for (size_t node = 0; node < nodes.size (); node++)
         {
-          if (DynamicCast<ndn::NetDeviceFace> (l3->GetFace (enabledFaceId)) == 0)
+          if (routes[node].empty ())
             continue;
 
-          // enabling only faceId
-          l3->GetFace (enabledFaceId)->SetMetric (originalMetric[enabledFaceId]);
+          FibHelper::AddRoutes (nodes[node], routes[node]);
+          routes[node].clear ();
+        }
+    }
+}
+
+
+namespace {
+
+const uint32_t ROUTES_FILE_MAGIC = 0x52474e4e; // "NNGR"
+const uint32_t ROUTES_FILE_VERSION = 1;
+const uint32_t ROUTES_FILE_ALL_POSSIBLE_ROUTES = 1;
+
+/**
+ * Header of the file written by SaveRoutes, followed by the name table (size and TLV wire
+ * encoding of every prefix) and by a route table of every node (node id, number of routes,
+ * RouteRecord of every route).  Values are in host byte order.
+ */
+struct RoutesFileHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  uint64_t topologyHash;
+  uint32_t flags;
+  uint32_t nNames;
+  uint32_t nNodes;
+  uint32_t reserved; // explicit tail padding, written as 0
+};
+
+struct RouteRecord
+{
+  uint32_t name; // index in the name table
+  uint32_t face; // Face::GetId () on the node
+  uint32_t cost;
+};
+
+/**
+ * 64-bit FNV-1a hash
+ */
+class TopologyHash
+{
+public:
+  TopologyHash ()
+    : m_value (UINT64_C (14695981039346656037))
+  {
+  }
+
+  void
+  Add (const void* data, size_t size)
+  {
+    const uint8_t* bytes = static_cast<const uint8_t*> (data);
+    for (size_t i = 0; i < size; i++)
+      {
+        m_value = (m_value ^ bytes[i]) * UINT64_C (1099511628211);
+      }
+  }
+
+  void
+  Add (uint32_t value)
+  {
+    Add (&value, sizeof (value));
+  }
+
+  void
+  Add (const std::string& value)
+  {
+    Add (value.size ());
+    Add (value.data (), value.size ());
+  }
+
+  uint64_t
+  GetValue () const
+  {
+    return m_value;
+  }
+
+private:
+  uint64_t m_value;
+};
+
+/**
+ * Routers are identified by the node or channel they are aggregated to, as GlobalRouter ids
+ * keep growing in a process that runs several simulations
+ */
+void
+AddRouterId (TopologyHash& hash, const Ptr<GlobalRouter>& router)
+{
+  Ptr<Node> node = router->GetObject<Node> ();
+  if (node != 0)
+    {
+      hash.Add (0u);
+      hash.Add (node->GetId ());
+      return;
+    }
+
+  Ptr<Channel> channel = router->GetObject<Channel> ();
+  hash.Add (1u);
+  hash.Add (channel != 0 ? channel->GetId () : std::numeric_limits<uint32_t>::max ());
+}
+
+void
+AddRouter (TopologyHash& hash, const Ptr<GlobalRouter>& router)
+{
+  if (router == 0)
+    {
+      hash.Add (std::numeric_limits<uint32_t>::max ());
+      return;
+    }
+
+  const GlobalRouter::IncidencyList& incidencies = router->GetIncidencies ();
+  hash.Add (incidencies.size ());
+  for (GlobalRouter::IncidencyList::const_iterator i = incidencies.begin (); i != incidencies.end (); i++)
+    {
+      const Ptr<Face>& face = i->get<1> ();
+      if (face != 0)
+        {
+          hash.Add (face->GetId ());
+          hash.Add (face->GetMetric ());
+          hash.Add (face->IsUp ());
+        }
+      else
+        hash.Add (std::numeric_limits<uint32_t>::max ());
+      AddRouterId (hash, i->get<2> ());
+    }
+
+  const GlobalRouter::LocalPrefixList& prefixes = router->GetLocalPrefixes ();
+  hash.Add (prefixes.size ());
+  BOOST_FOREACH (const shared_ptr<const Name> &prefix, prefixes)
+    {
+      hash.Add (prefix->toUri ());
+    }
+}
+
+/**
+ * Hash of everything routes depend on: routers on nodes and channels, their faces, metrics and
+ * face states, and the prefixes they originate
+ */
+uint64_t
+CalculateTopologyHash ()
+{
+  TopologyHash hash;
+  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+    {
+      hash.Add ((*node)->GetId ());
+      AddRouter (hash, (*node)->GetObject<GlobalRouter> ());
+    }
+
+  for (ChannelList::Iterator channel = ChannelList::Begin (); channel != ChannelList::End (); channel++)
+    {
+      hash.Add ((*channel)->GetId ());
+      AddRouter (hash, (*channel)->GetObject<GlobalRouter> ());
+    }
+
+  return hash.GetValue ();
+}
+
+/**
+ * Bounds-checked reader of a memory-mapped file
+ */
+class MappedFileReader
+{
+public:
+  MappedFileReader (const void* data, size_t size)
+    : m_position (static_cast<const uint8_t*> (data))
+    , m_end (m_position + size)
+  {
+  }
+
+  template<class T>
+  bool
+  Read (T& value)
+  {
+    const uint8_t* data;
+    if (!Read (data, sizeof (T)))
+      return false;
+
+    std::memcpy (&value, data, sizeof (T));
+    return true;
+  }
+
+  bool
+  Read (const uint8_t*& data, size_t size)
+  {
+    if (static_cast<size_t> (m_end - m_position) < size)
+      return false;
+
+    data = m_position;
+    m_position += size;
+    return true;
+  }
+
+  bool
+  IsAtEnd () const
+  {
+    return m_position == m_end;
+  }
+
+  size_t
+  GetNRemaining () const
+  {
+    return m_end - m_position;
+  }
+
+private:
+  const uint8_t* m_position;
+  const uint8_t* m_end;
+};
+
+template<class T>
+void
+Write (std::ofstream& os, const T& value)
+{
+  os.write (reinterpret_cast<const char*> (&value), sizeof (T));
+}
+
+} // namespace
 
-          DistancesMap    distances;
+void
+GlobalRoutingHelper::SaveRoutes (const std::string& filename)
+{
+  NS_LOG_FUNCTION (filename);
+
+  // only routes of the routed prefixes are saved, so that other routes (e.g., default routes of
+  // StackHelper) are neither duplicated nor withdrawn after the routes are loaded
+  std::vector<const Name*> names;
+  for (std::set<Name>::const_iterator prefix = g_routedPrefixes.begin (); prefix != g_routedPrefixes.end (); prefix++)
+    {
+      names.push_back (&*prefix);
+    }
 
-          NS_LOG_DEBUG ("-----------");
+  std::vector< std::pair<uint32_t, std::vector<RouteRecord> > > nodes;
+  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+    {
+      Ptr<GlobalRouter> router = (*node)->GetObject<GlobalRouter> ();
+      if (router == 0)
+        continue;
+
+      // and only next hops through faces of GlobalRouter, as they are what CalculateRoutes
+      // and CalculateAllPossibleRoutes install
+      std::map< ::nfd::FaceId, uint32_t> faceIds;
+      const GlobalRouter::IncidencyList& incidencies = router->GetIncidencies ();
+      for (GlobalRouter::IncidencyList::const_iterator i = incidencies.begin (); i != incidencies.end (); i++)
+        {
+          faceIds[i->get<1> ()->getId ()] = i->get<1> ()->GetId ();
+        }
 
-          dijkstra_shortest_paths (graph, source,
-                                   // predecessor_map (boost::ref(predecessors))
-                                   // .
-                                   distance_map (boost::ref(distances))
-                                   .
-                                   distance_inf (WeightInf)
-                                   .
-                                   distance_zero (WeightZero)
-                                   .
-                                   distance_compare (boost::WeightCompare ())
-                                   .
-                                   distance_combine (boost::WeightCombine ())
-                                   );
+      nodes.push_back (std::make_pair ((*node)->GetId (), std::vector<RouteRecord> ()));
+      std::vector<RouteRecord>& routes = nodes.back ().second;
 
-          // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
+      ::nfd::Fib& fib = (*node)->GetObject<L3Protocol> ()->GetForwarder ()->getFib ();
+      for (uint32_t name = 0; name < names.size (); name++)
+        {
+          shared_ptr< ::nfd::fib::Entry> entry = fib.findExactMatch (*names[name]);
+          if (!static_cast<bool> (entry))
+            continue;
 
-          for (DistancesMap::iterator i = distances.begin ();
-               i != distances.end ();
-               i++)
+          BOOST_FOREACH (const ::nfd::fib::NextHop& nextHop, entry->getNextHops ())
             {
-              if (i->first == source)
+              std::map< ::nfd::FaceId, uint32_t>::iterator face = faceIds.find (nextHop.getFace ()->getId ());
+              if (face == faceIds.end ())
                 continue;
-              else
-                {
-                  // cout << "  Node " << i->first->GetObject<Node> ()->GetId ();
-                  if (i->second.get<0> () == 0)
-                    {
-                      // cout << " is unreachable" << endl;
-                    }
-                  else
-                    {
-                      BOOST_FOREACH (const shared_ptr<const Name> &prefix, i->first->GetLocalPrefixes ())
-                        {
-                          NS_LOG_DEBUG (" prefix " << *prefix << " reachable via face " << *i->second.get<0> ()
-                                        << " with distance " << i->second.get<1> ()
-                                        << " with delay " << i->second.get<2> ());
-
-                          if (i->second.get<0> ()->GetMetric () == std::numeric_limits<uint16_t>::max ()-1)
-                            continue;
-
-                          //Ptr<fib::Entry> entry = fib->Add (prefix, i->second.get<0> (), i->second.get<1> ());
-                          // shared_ptr<::nfd::fib::Entry> entry = forwarder->getFib().insert(*prefix).first;
-                          // entry->addNextHop((i->second.get<0> ())->shared_from_this (), i->second.get<1> ());
-                          ControlParameters parameters;
-                          parameters.setName(*prefix);
-                          parameters.setFaceId((i->second.get<0>())->getId());
-                          parameters.setCost (i->second.get<1>());
-
-                          FibHelper fibHelper;
-                          fibHelper.AddNextHop(parameters, *node);
-
-                          //entry->SetRealDelayToProducer (i->second.get<0> (), Seconds (i->second.get<2> ()));
-
-                          //Ptr<Limits> faceLimits = i->second.get<0> ()->GetObject<Limits> ();
-
-                          //Ptr<Limits> fibLimits = entry->GetObject<Limits> ();
-                          //if (fibLimits != 0)
-                          //{
-                              // if it was created by the forwarding strategy via DidAddFibEntry event
-                              //fibLimits->SetLimits (faceLimits->GetMaxRate (), 2 * i->second.get<2> () /*exact RTT*/);
-                              //NS_LOG_DEBUG ("Set limit for prefix " << *prefix << " " << faceLimits->GetMaxRate () << " / " << 2*i->second.get<2> () << "s (" << faceLimits->GetMaxRate () * 2 * i->second.get<2> () << ")");
-                          //}
-                        }
-                    }
-                }
+
+              RouteRecord route = { name, face->second, static_cast<uint32_t> (nextHop.getCost ()) };
+              routes.push_back (route);
             }
+        }
+    }
+
+  std::ofstream os (filename.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!os.is_open ())
+    NS_FATAL_ERROR ("Cannot open file " << filename << " for writing");
+
+  RoutesFileHeader header = { ROUTES_FILE_MAGIC, ROUTES_FILE_VERSION, CalculateTopologyHash (),
+                              g_allPossibleRoutes ? ROUTES_FILE_ALL_POSSIBLE_ROUTES : 0,
+                              static_cast<uint32_t> (names.size ()), static_cast<uint32_t> (nodes.size ()), 0 };
+  Write (os, header);
+
+  for (std::vector<const Name*>::iterator name = names.begin (); name != names.end (); name++)
+    {
+      const Block& wire = (*name)->wireEncode ();
+      Write (os, static_cast<uint32_t> (wire.size ()));
+      os.write (reinterpret_cast<const char*> (wire.wire ()), wire.size ());
+    }
+
+  size_t nRoutes = 0;
+  for (size_t i = 0; i < nodes.size (); i++)
+    {
+      Write (os, nodes[i].first);
+      Write (os, static_cast<uint32_t> (nodes[i].second.size ()));
+      if (!nodes[i].second.empty ())
+        os.write (reinterpret_cast<const char*> (&nodes[i].second[0]),
+                  nodes[i].second.size () * sizeof (RouteRecord));
+      nRoutes += nodes[i].second.size ();
+    }
+
+  if (!os.good ())
+    NS_FATAL_ERROR ("Failed to write routes to " << filename);
+
+  NS_LOG_INFO ("Saved " << nRoutes << " routes of " << nodes.size () << " nodes to " << filename);
+}
+
+bool
+GlobalRoutingHelper::LoadRoutes (const std::string& filename)
+{
+  NS_LOG_FUNCTION (filename);
+
+  boost::interprocess::mapped_region region;
+  try
+    {
+      boost::interprocess::file_mapping file (filename.c_str (), boost::interprocess::read_only);
+      boost::interprocess::mapped_region (file, boost::interprocess::read_only).swap (region);
+    }
+  catch (boost::interprocess::interprocess_exception& e)
+    {
+      NS_LOG_INFO ("Cannot map " << filename << ": " << e.what ());
+      return false;
+    }
+
+  MappedFileReader reader (region.get_address (), region.get_size ());
 
-          // disabling the face again
-          l3->GetFace (enabledFaceId)->SetMetric (std::numeric_limits<uint16_t>::max ()-1);
+  RoutesFileHeader header;
+  if (!reader.Read (header) || header.magic != ROUTES_FILE_MAGIC || header.version != ROUTES_FILE_VERSION)
+    {
+      NS_LOG_WARN (filename << " is not a routes file of this version");
+      return false;
+    }
+
+  if (header.topologyHash != CalculateTopologyHash ())
+    {
+      NS_LOG_INFO ("Routes in " << filename << " were saved for a different topology");
+      return false;
+    }
+
+  // every name takes at least its size and every node its id and number of routes, so counts
+  // larger than the rest of the file are corrupted and must not be used to allocate memory
+  if (header.nNames > reader.GetNRemaining () / sizeof (uint32_t) ||
+      header.nNodes > reader.GetNRemaining () / (2 * sizeof (uint32_t)))
+    {
+      NS_LOG_WARN (filename << " is truncated or corrupted");
+      return false;
+    }
+
+  // the file is validated completely before existing routes are touched
+  std::vector<Name> names;
+  names.reserve (header.nNames);
+  for (uint32_t i = 0; i < header.nNames; i++)
+    {
+      uint32_t size;
+      const uint8_t* wire;
+      if (!reader.Read (size) || !reader.Read (wire, size))
+        {
+          NS_LOG_WARN (filename << " is truncated");
+          return false;
         }
 
-      // recover original interface statuses
-      for (uint32_t faceId = 0; faceId < l3->GetNFaces (); faceId++)
+      try
+        {
+          names.push_back (Name (Block (wire, size)));
+        }
+      catch (::ndn::tlv::Error& e)
         {
-          l3->GetFace (faceId)->SetMetric (originalMetric[faceId]);
+          NS_LOG_WARN (filename << " contains an invalid name: " << e.what ());
+          return false;
         }
     }
+
+  std::vector< std::pair<Ptr<Node>, std::vector<FibHelper::Route> > > nodes (header.nNodes);
+  std::map<uint32_t, Ptr<Face> > faces;
+  for (uint32_t i = 0; i < header.nNodes; i++)
+    {
+      uint32_t nodeId;
+      uint32_t nRoutes;
+      if (!reader.Read (nodeId) || !reader.Read (nRoutes) || nodeId >= NodeList::GetNNodes () ||
+          nRoutes > reader.GetNRemaining () / sizeof (RouteRecord))
+        {
+          NS_LOG_WARN (filename << " is truncated or corrupted");
+          return false;
+        }
+
+      Ptr<Node> node = NodeList::GetNode (nodeId);
+      Ptr<L3Protocol> ndn = node->GetObject<L3Protocol> ();
+      faces.clear ();
+      for (uint32_t face = 0; face < ndn->GetNFaces (); face++)
+        {
+          faces[ndn->GetFace (face)->GetId ()] = ndn->GetFace (face);
+        }
+
+      nodes[i].first = node;
+      nodes[i].second.reserve (nRoutes);
+      for (uint32_t j = 0; j < nRoutes; j++)
+        {
+          RouteRecord route;
+          if (!reader.Read (route) || route.name >= names.size () || faces.find (route.face) == faces.end ())
+            {
+              NS_LOG_WARN (filename << " is truncated or corrupted");
+              return false;
+            }
+
+          nodes[i].second.push_back (FibHelper::Route (names[route.name], faces[route.face], route.cost));
+        }
+    }
+
+  if (!reader.IsAtEnd ())
+    {
+      NS_LOG_WARN (filename << " has unexpected data at the end");
+      return false;
+    }
+
+  size_t nRoutes = 0;
+  for (size_t i = 0; i < nodes.size (); i++)
+    {
+      InvalidateRoutes (nodes[i].first);
+    }
+
+  std::set<Name> prefixes (names.begin (), names.end ());
+  SetRoutedPrefixes (prefixes);
+
+  for (size_t i = 0; i < nodes.size (); i++)
+    {
+      FibHelper::AddRoutes (nodes[i].first, nodes[i].second);
+      nRoutes += nodes[i].second.size ();
+    }
+
+  // routes were not calculated in this run, UpdateRoutes has to recalculate all of them
+  ResetRoutingState ();
+  g_allPossibleRoutes = header.flags & ROUTES_FILE_ALL_POSSIBLE_ROUTES;
+
+  NS_LOG_INFO ("Loaded " << nRoutes << " routes of " << nodes.size () << " nodes from " << filename);
+  return true;
 }
 
 
@@ -98,26 +98,117 @@ public:
   /**
    * @brief Calculate for every node shortest path trees and install routes to all prefix origins
    *
-   * @param invalidatedRoutes flag indicating whether existing routes should be invalidated or keps as is
+   * Routes are calculated with reverse shortest path trees rooted at the origins, a batch of
+   * origins at a time.  The trees are kept for UpdateRoutes only if enabled with
+   * SetIncrementalUpdates.  Faces that are down are not used.
+   *
+   * When a node has several lowest-cost paths to an origin, the next hop is the first of their
+   * faces in the order the faces were added to the node's GlobalRouter.  Before this rule, the
+   * choice depended on the order Dijkstra's heap visited nodes, so FIBs of topologies with
+   * equal-cost paths (e.g., grids) may differ from routes calculated by earlier versions.
+   *
+   * @param invalidatedRoutes flag indicating whether routes installed by the previous
+   *                          CalculateRoutes, CalculateAllPossibleRoutes or LoadRoutes should be
+   *                          withdrawn or kept as is.  Other routes, e.g., default routes of
+   *                          StackHelper::SetDefaultRoutes, are never withdrawn
    */
   static void
   CalculateRoutes (bool invalidatedRoutes = true);
 
   /**
-   * @brief Calculate all possible next-hop independent alternative routes
+   * @brief Update routes after faces were brought up or down or their metrics were changed
+   *
+   * Only routes towards origins whose shortest path trees are affected by the changed faces are
+   * recalculated, and only next hops that changed are added to or removed from FIBs.  For
+   * example, after LinkControlHelper::FailLink or LinkControlHelper::UpLink:
+   *
+   *     Simulator::Schedule (Seconds (10.0), LinkControlHelper::FailLink, node1, node2);
+   *     Simulator::Schedule (Seconds (10.0), GlobalRoutingHelper::UpdateRoutes);
    *
-   * @param invalidatedRoutes flag indicating whether existing routes should be invalidated or keps as is
+   * Topology and origins must not change after CalculateRoutes.  If routes were calculated with
+   * CalculateAllPossibleRoutes, without SetIncrementalUpdates (true), or not calculated at all,
+   * all routes are recalculated.
+   */
+  static void
+  UpdateRoutes ();
+
+  /**
+   * @brief Calculate all possible next-hop independent alternative routes
    *
-   * Refer to the implementation for more details.
+   * @param invalidatedRoutes flag indicating whether routes installed by the previous
+   *                          CalculateRoutes, CalculateAllPossibleRoutes or LoadRoutes should be
+   *                          withdrawn or kept as is.  Other routes, e.g., default routes of
+   *                          StackHelper::SetDefaultRoutes, are never withdrawn
    *
-   * Note that this method is highly experimental and should be used with caution (very time consuming).
+   * For every face of a node, a route is installed with the cost of the best path that starts
+   * with this face and does not return to the node.  Routes are calculated with one reverse
+   * shortest path tree per origin.  Refer to the implementation for more details.
    */
   static void
   CalculateAllPossibleRoutes (bool invalidatedRoutes = true);
 
+  /**
+   * @brief Save routes installed by CalculateRoutes or CalculateAllPossibleRoutes to a file
+   *
+   * Next hops through faces of GlobalRouter towards prefixes of origins are written for every
+   * node, together with a hash of the topology (routers, faces, metrics, face states, and
+   * origins).  Other routes, e.g., default routes of StackHelper or routes added with
+   * FibHelper, are not saved.
+   *
+   * @param filename name of the file to write
+   */
+  static void
+  SaveRoutes (const std::string &filename);
+
+  /**
+   * @brief Load routes saved by SaveRoutes, instead of calculating them
+   *
+   * The file is memory-mapped and routes are installed directly into FIBs.  Nothing is
+   * changed if the file cannot be read or was saved for a different topology, so a parameter
+   * sweep can calculate routes in the first run only:
+   *
+   *     if (!GlobalRoutingHelper::LoadRoutes ("routes.bin"))
+   *       {
+   *         GlobalRoutingHelper::CalculateRoutes ();
+   *         GlobalRoutingHelper::SaveRoutes ("routes.bin");
+   *       }
+   *
+   * @param filename name of the file to read
+   * @returns true if routes were loaded
+   */
+  static bool
+  LoadRoutes (const std::string &filename);
+
+  /**
+   * @brief Set number of threads used to calculate shortest path trees in CalculateRoutes
+   *
+   * @param nThreads number of threads, 0 (default) to use all available hardware threads
+   */
+  static void
+  SetNThreads (uint32_t nThreads);
+
+  /**
+   * @brief Keep shortest path trees calculated by CalculateRoutes, so that UpdateRoutes
+   *        recalculates only routes affected by changed faces
+   *
+   * The trees take #origins x #routers x 8 bytes (e.g., 20 GB with AddOriginsForAll on 50k
+   * nodes), so by default they are released as soon as the routes are installed.
+   *
+   * @param isEnabled true to keep the trees, false (default) to release them
+   */
+  static void
+  SetIncrementalUpdates (bool isEnabled);
+
 private:
   void
   Install (Ptr<Channel> channel);
+
+  static uint32_t
+  GetNThreads ();
+
+private:
+  static uint32_t m_nThreads;
+  static bool m_isIncremental;
 };
 
 } // namespace ndn
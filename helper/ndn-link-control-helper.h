@@ -41,7 +41,8 @@ public:
    * The helper will attempt to find NDN link between node1 and
    * node2 and set NDN face to DOWN state
    *
-   * Note that only PointToPointChannels are supported by this helper method
+   * Note that only PointToPointChannels are supported by this helper method.
+   * FIBs are not changed, use GlobalRoutingHelper::UpdateRoutes to repair global routes
    *
    * @param node1 one node
    * @param node2 another node
@@ -55,7 +56,8 @@ public:
    * The helper will attempt to find NDN link between node1 and
    * node2 and set NDN face to DOWN state
    *
-   * Note that only PointToPointChannels are supported by this helper method
+   * Note that only PointToPointChannels are supported by this helper method.
+   * FIBs are not changed, use GlobalRoutingHelper::UpdateRoutes to repair global routes
    *
    * This variant uses node names registered by Names class
    *
@@ -71,7 +73,8 @@ public:
    * The helper will attempt to find NDN link between node1 and
    * node2 and set NDN face to UP state
    *
-   * Note that only PointToPointChannels are supported by this helper method
+   * Note that only PointToPointChannels are supported by this helper method.
+   * FIBs are not changed, use GlobalRoutingHelper::UpdateRoutes to repair global routes
    *
    * @param node1 one node
    * @param node2 another node
@@ -85,7 +88,8 @@ public:
    * The helper will attempt to find NDN link between node1 and
    * node2 and set NDN face to UP state
    *
-   * Note that only PointToPointChannels are supported by this helper method
+   * Note that only PointToPointChannels are supported by this helper method.
+   * FIBs are not changed, use GlobalRoutingHelper::UpdateRoutes to repair global routes
    *
    * This variant uses node names registered by Names class
    *
@@ -196,6 +196,13 @@ StackHelper::SetDefaultRoutes (bool needSet)
   m_needSetDefaultRoutes = needSet;
 }
 
+void
+StackHelper::SetHeadless (bool headless)
+{
+  NS_LOG_FUNCTION (this << headless);
+  m_headless = headless;
+}
+
 void
 StackHelper::EnableLimits (bool enable/* = true*/,
                            Time avgRtt/*=Seconds(0.1)*/,
@@ -241,6 +248,7 @@ StackHelper::Install (Ptr<Node> node) const
 
   Ptr<L3Protocol> ndn = m_ndnFactory.Create<L3Protocol> ();
   ndn->SetContentStore (m_nfdCS);
+  ndn->SetHeadless (m_headless);
   // Aggregate L3Protocol on node
   node->AggregateObject (ndn);
 
@@ -264,6 +264,18 @@ public:
   void
   SetDefaultRoutes (bool needSet);
 
+  /**
+   * \brief Set flag indicating that NFD management should not be initialized on nodes
+   *
+   * Headless nodes do not have an internal face, managers, and status server, which saves
+   * memory and installation time in large topologies.  Routes and strategies can still be
+   * configured with FibHelper, GlobalRoutingHelper, and StrategyChoiceHelper.
+   *
+   * @see L3Protocol::SetHeadless
+   */
+  void
+  SetHeadless (bool headless);
+
   /**
    * \brief Get the dummy key chain instance associated with the stack helper
    *
@@ -300,6 +312,7 @@ private:
   uint32_t m_avgDataSize;
   uint32_t m_avgInterestSize;
   bool     m_needSetDefaultRoutes;
+  bool     m_headless = false;
 
   typedef std::list< std::pair<TypeId, NetDeviceFaceCreateCallback> > NetDeviceCallbackList;
   NetDeviceCallbackList m_netDeviceCallbacks;
@@ -23,6 +23,7 @@
 #include "ns3/log.h"
 
 #include "ns3/ndnSIM/NFD/daemon/mgmt/strategy-choice-manager.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
 
 namespace ns3 {
 namespace ndn {
@@ -45,6 +46,17 @@ StrategyChoiceHelper::~StrategyChoiceHelper ()
 void
 StrategyChoiceHelper::StrategyChoice (const ControlParameters& parameters, Ptr<Node> node)
 {
+  Ptr<L3Protocol> L3protocol = node->GetObject<L3Protocol> ();
+  if (L3protocol->IsHeadless ())
+    {
+      // no strategy choice manager, the command is applied directly
+      if (!L3protocol->GetForwarder ()->getStrategyChoice ().insert (parameters.getName (),
+                                                                     parameters.getStrategy ()))
+        NS_LOG_WARN ("Strategy " << parameters.getStrategy () << " is not installed on node "
+                     << node->GetId ());
+      return;
+    }
+
   NS_LOG_DEBUG ("Strategy choice command was initialized");
   Block encodedParameters(parameters.wireEncode());
 
@@ -54,7 +66,6 @@ StrategyChoiceHelper::StrategyChoice (const ControlParameters& parameters, Ptr<N
 
   shared_ptr<Interest> command(make_shared<Interest>(commandName));
   StackHelper::getKeyChain().signWithSha256(*command);
-  Ptr<L3Protocol> L3protocol = node->GetObject<L3Protocol> ();
   shared_ptr<StrategyChoiceManager> strategyChoiceManager = L3protocol->GetStrategyChoiceManager ();
   strategyChoiceManager->onStrategyChoiceRequest(*command);
   NS_LOG_DEBUG ("Forwarding strategy installed in node " << node->GetId ());
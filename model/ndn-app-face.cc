@@ -23,15 +23,18 @@
 #include "ndn-app-face.h"
 
 #include "ns3/log.h"
+#include "ns3/ndn-log-level.h"
 #include "ns3/packet.h"
 #include "ns3/node.h"
 #include "ns3/assert.h"
 #include "ns3/simulator.h"
+#include "ns3/make-event.h"
 #include "ns3/attribute.h"
 #include "ns3/attribute-helper.h"
 
 #include "ns3/ndn-app.h"
 #include "ns3/ndn-common.h"
+#include "ns3/ndn-l3-protocol.h"
 
 NS_LOG_COMPONENT_DEFINE ("ndn.AppFace");
 
@@ -98,8 +101,11 @@ AppFace::sendInterest (const Interest& interest)
       return;
     }
 
+  ++getMutableCounters ().getNOutInterests ();
+  onSendInterest (interest);
+
   // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnInterest, m_app, interest.shared_from_this ());
+  ScheduleDelivery (Ptr<EventImpl> (MakeEvent (&App::OnInterest, m_app, interest.shared_from_this ()), false));
 }
 
 void
@@ -112,8 +118,34 @@ AppFace::sendData (const Data& data)
        return;
     }
 
+  ++getMutableCounters ().getNOutDatas ();
+  onSendData (data);
+
   // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnData, m_app, data.shared_from_this ());
+  ScheduleDelivery (Ptr<EventImpl> (MakeEvent (&App::OnData, m_app, data.shared_from_this ()), false));
+}
+
+void
+AppFace::ScheduleDelivery (const Ptr<EventImpl>& delivery)
+{
+  if (m_l3Protocol != 0)
+    m_l3Protocol->ScheduleAppDelivery (delivery);
+  else
+    Simulator::ScheduleNow (delivery);
+}
+
+void
+AppFace::ReceiveInterest (const Interest& interest)
+{
+  ++getMutableCounters ().getNInInterests ();
+  onReceiveInterest (interest);
+}
+
+void
+AppFace::ReceiveData (const Data& data)
+{
+  ++getMutableCounters ().getNInDatas ();
+  onReceiveData (data);
 }
 
 std::ostream&
@@ -33,6 +33,7 @@
 namespace ns3 {
 
 class Packet;
+class EventImpl;
 
 namespace ndn {
 
@@ -77,12 +78,33 @@ public:
   virtual bool
   isLocal() const;
 
+  /**
+   * \brief Pass Interest sent by the application to the forwarder
+   *
+   * Applications should use this method instead of raising onReceiveInterest directly,
+   * so that face counters are updated
+   */
+  void
+  ReceiveInterest (const Interest& interest);
+
+  /**
+   * \brief Pass Data sent by the application to the forwarder
+   */
+  void
+  ReceiveData (const Data& data);
+
 public:
   virtual std::ostream&
   Print (std::ostream &os) const;
   ////////////////////////////////////////////////////////////////////
 
 private:
+  /**
+   * \brief Deliver Interest or Data to the application (see L3Protocol::ScheduleAppDelivery)
+   */
+  void
+  ScheduleDelivery (const Ptr<EventImpl>& delivery);
+
   AppFace ();
   AppFace (const AppFace &); ///< \brief Disabled copy constructor
   AppFace& operator= (const AppFace &); ///< \brief Disabled copy operator
@@ -23,6 +23,7 @@
 
 #include "ns3/packet.h"
 #include "ns3/log.h"
+#include "ns3/ndn-log-level.h"
 #include "ns3/node.h"
 #include "ns3/assert.h"
 #include "ns3/uinteger.h"
@@ -34,6 +35,7 @@
 #include "ns3/ptr.h"
 #include "ns3/ndn-interest.h"
 #include "ns3/ndn-data.h"
+#include "ns3/ndn-l3-protocol.h"
 
 #include "ns3/ndn-fw-hop-count-tag.h"
 
@@ -121,6 +123,9 @@ Face::sendInterest (const ::ndn::Interest& interest)
     packet->AddPacketTag (hopCount);
   Block block = interest.wireEncode ();
   Convert::ToPacket (make_shared <Block> (block), packet);
+
+  ++getMutableCounters ().getNOutInterests ();
+  onSendInterest (interest);
   Send (packet);
 }
 
@@ -137,15 +142,11 @@ Face::sendData (const ::ndn::Data& data)
 
   const Data& d = static_cast<const Data&>(data);
 
-  Ptr<Packet> packet = Create <Packet> ();
+  ++getMutableCounters ().getNOutDatas ();
+  onSendData (data);
 
-  FwHopCountTag hopCount;
-  bool tagExists = d.getPacket ()->PeekPacketTag (hopCount);
-  if (tagExists)
-    packet->AddPacketTag (hopCount);
-  Block block = data.wireEncode ();
-  Convert::ToPacket (make_shared <Block> (block), packet);
-  Send (packet);
+  // the encoded packet is shared by all faces the Data goes out of
+  Send (d.getWirePacket ()->Copy ());
 }
 
 bool
@@ -173,6 +174,11 @@ Face::Receive (Ptr<const Packet> p)
       return false;
     }
   Ptr<Packet> packet = p->Copy (); // give upper layers a rw copy of the packet
+
+  // application deliveries are deferred until the end of processing only if enabled
+  bool isDeferred = m_l3Protocol != 0 && m_l3Protocol->IsAppDeliveryDeferred ();
+  if (isDeferred)
+    m_l3Protocol->BeginPacketProcessing ();
   try
     {
       //Let's see..
@@ -184,10 +190,18 @@ Face::Receive (Ptr<const Packet> p)
       NS_FATAL_ERROR ("Unknown NDN header. Should not happen");
       return false;
     }
+  if (isDeferred)
+    m_l3Protocol->EndPacketProcessing ();
 
   return false;
 }
 
+void
+Face::SetL3Protocol (Ptr<L3Protocol> l3Protocol)
+{
+  m_l3Protocol = l3Protocol;
+}
+
 void
 Face::SetMetric (uint16_t metric)
 {
@@ -42,6 +42,8 @@ class Node;
 
 namespace ndn {
 
+class L3Protocol;
+
 /**
  * \ingroup ndn
  * \defgroup ndn-face Faces
@@ -216,6 +218,12 @@ public:
   inline void
   SetId (uint32_t id);
 
+  /**
+   * \brief Set NDN stack the face is added to (called by L3Protocol::AddFace and RemoveFace)
+   */
+  void
+  SetL3Protocol (Ptr<L3Protocol> l3Protocol);
+
   /**
    * \brief Get face Id
    *
@@ -275,6 +283,7 @@ private:
 
 protected:
   Ptr<Node> m_node; ///< \brief Smart pointer to Node
+  Ptr<L3Protocol> m_l3Protocol; ///< \brief NDN stack of the node, cached to avoid aggregate lookups per packet
 
 private:
   bool m_ifup;
@@ -24,8 +24,10 @@
 #include "ns3/packet.h"
 #include "ns3/node.h"
 #include "ns3/log.h"
+#include "ns3/ndn-log-level.h"
 #include "ns3/callback.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/object-vector.h"
 #include "ns3/pointer.h"
@@ -55,6 +57,65 @@ const uint16_t L3Protocol::IP_STACK_PORT = 9695;
 
 NS_OBJECT_ENSURE_REGISTERED (L3Protocol);
 
+/**
+ * \brief Trace source accessor that hooks face events into L3Protocol traces
+ *        only once something is connected to them
+ */
+class L3FaceTraceSourceAccessor : public TraceSourceAccessor
+{
+public:
+  L3FaceTraceSourceAccessor (Ptr<const TraceSourceAccessor> accessor)
+    : m_accessor (accessor)
+  {
+  }
+
+  virtual bool
+  ConnectWithoutContext (ObjectBase *obj, const CallbackBase &cb) const
+  {
+    Enable (obj);
+    return m_accessor->ConnectWithoutContext (obj, cb);
+  }
+
+  virtual bool
+  Connect (ObjectBase *obj, std::string context, const CallbackBase &cb) const
+  {
+    Enable (obj);
+    return m_accessor->Connect (obj, context, cb);
+  }
+
+  virtual bool
+  DisconnectWithoutContext (ObjectBase *obj, const CallbackBase &cb) const
+  {
+    return m_accessor->DisconnectWithoutContext (obj, cb);
+  }
+
+  virtual bool
+  Disconnect (ObjectBase *obj, std::string context, const CallbackBase &cb) const
+  {
+    return m_accessor->Disconnect (obj, context, cb);
+  }
+
+private:
+  static void
+  Enable (ObjectBase *obj)
+  {
+    L3Protocol *l3 = dynamic_cast<L3Protocol*> (obj);
+    if (l3 != 0)
+      l3->EnableFaceTraces ();
+  }
+
+private:
+  Ptr<const TraceSourceAccessor> m_accessor;
+};
+
+template<class T>
+static Ptr<const TraceSourceAccessor>
+MakeFaceTraceSourceAccessor (T a)
+{
+  return Ptr<const TraceSourceAccessor> (new L3FaceTraceSourceAccessor (MakeTraceSourceAccessor (a)),
+                                         false);
+}
+
 TypeId
 L3Protocol::GetTypeId (void)
 {
@@ -67,17 +128,24 @@ L3Protocol::GetTypeId (void)
                    MakeObjectVectorAccessor (&L3Protocol::m_faces),
                    MakeObjectVectorChecker<Face> ())
 
+    .AddAttribute ("DeferredAppDelivery",
+                   "Deliver packets to applications at the end of processing of the packet received "
+                   "from a link, instead of scheduling a new event per delivered packet",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&L3Protocol::m_deferredAppDelivery),
+                   MakeBooleanChecker ())
+
     .AddTraceSource("OutInterests",  "OutInterests",
-                     MakeTraceSourceAccessor(&L3Protocol::m_outInterests))
+                    MakeFaceTraceSourceAccessor(&L3Protocol::m_outInterests))
     .AddTraceSource("InInterests",   "InInterests",
-                    MakeTraceSourceAccessor(&L3Protocol::m_inInterests))
+                    MakeFaceTraceSourceAccessor(&L3Protocol::m_inInterests))
 
     ////////////////////////////////////////////////////////////////////
 
     .AddTraceSource ("OutData",  "OutData",
-                      MakeTraceSourceAccessor(&L3Protocol::m_outData))
+                     MakeFaceTraceSourceAccessor(&L3Protocol::m_outData))
     .AddTraceSource ("InData",   "InData",
-                      MakeTraceSourceAccessor(&L3Protocol::m_inData))
+                     MakeFaceTraceSourceAccessor(&L3Protocol::m_inData))
   ;
   return tid;
 }
@@ -99,7 +167,9 @@ L3Protocol::initialize(Ptr<Node> node)
   m_forwarder = make_shared<Forwarder>();
   m_forwarder->setNode (node);
 
-  initializeManagement();
+  configureTables();
+  if (!m_headless)
+    initializeManagement();
 
   m_forwarder->getFaceTable().addReserved(make_shared<NullFace>(), nfd::FACEID_NULL);
   m_forwarder->getFaceTable().addReserved(make_shared<NullFace>(FaceUri("contentstore://")), nfd::FACEID_CONTENT_STORE);
@@ -129,28 +199,78 @@ L3Protocol::initializeManagement()
                                              ref(*m_forwarder),
                                              ref(StackHelper::getKeyChain()));
 
+  // Alex do we need this?
+  m_forwarder->getFaceTable().addReserved(m_internalFace, nfd::FACEID_INTERNAL_FACE);
+
+  // add FIB entry for NFD Management Protocol
+  shared_ptr<::nfd::fib::Entry> entry = m_forwarder->getFib().insert("/localhost/nfd").first;
+  entry->addNextHop(m_internalFace, 0);
+}
+
+void
+L3Protocol::configureTables()
+{
   TablesConfigSection tablesConfig(m_forwarder->getCs(),
                                    m_forwarder->getPit(),
                                    m_forwarder->getFib(),
                                    m_forwarder->getStrategyChoice(),
                                    m_forwarder->getMeasurements());
 
-  // Alex do we need this?
-  m_forwarder->getFaceTable().addReserved(m_internalFace, nfd::FACEID_INTERNAL_FACE);
-
   tablesConfig.ensureTablesAreConfigured(m_nfdCS);
+}
 
-  // add FIB entry for NFD Management Protocol
-  // shared_ptr<::nfd::fib::Entry> entry = m_forwarder->getFib().insert("/localhost/nfd").first;
-  // entry->addNextHop(m_internalFace, 0);
-  ControlParameters parameters;
-  parameters.setName("/localhost/nfd");
-  parameters.setFaceId(m_internalFace->getId ());
-  parameters.setCost (0);
+void
+L3Protocol::SetHeadless (bool headless)
+{
+  m_headless = headless;
+}
 
-  FibHelper fibHelper;
-  Ptr<Node> node = GetObject<Node> ();
-  fibHelper.AddNextHop(parameters, node);
+bool
+L3Protocol::IsHeadless () const
+{
+  return m_headless;
+}
+
+void
+L3Protocol::ScheduleAppDelivery (const Ptr<EventImpl>& delivery)
+{
+  if (m_deferredAppDelivery && m_packetProcessingDepth > 0)
+    m_appDeliveries.push_back (delivery);
+  else
+    Simulator::ScheduleNow (delivery);
+}
+
+bool
+L3Protocol::IsAppDeliveryDeferred () const
+{
+  return m_deferredAppDelivery;
+}
+
+void
+L3Protocol::BeginPacketProcessing ()
+{
+  m_packetProcessingDepth++;
+}
+
+void
+L3Protocol::EndPacketProcessing ()
+{
+  if (m_packetProcessingDepth > 1)
+    {
+      m_packetProcessingDepth--;
+      return;
+    }
+
+  // applications run with the depth still raised, so whatever they trigger is queued
+  // after the current deliveries rather than executed inside them
+  while (!m_appDeliveries.empty ())
+    {
+      Ptr<EventImpl> delivery = m_appDeliveries.front ();
+      m_appDeliveries.pop_front ();
+      delivery->Invoke ();
+    }
+
+  m_packetProcessingDepth--;
 }
 
 shared_ptr<FibManager>
@@ -233,9 +353,13 @@ L3Protocol::DoDispose (void)
 
   for (FaceList::iterator i = m_faces.begin (); i != m_faces.end (); ++i)
   {
+    (*i)->SetL3Protocol (0);
     *i = 0;
   }
   m_faces.clear ();
+  m_facesById.clear ();
+  m_faceByNetDevice.clear ();
+  m_appDeliveries.clear ();
   m_node = 0;
 
   // Force delete on objects
@@ -255,6 +379,7 @@ L3Protocol::AddFace (const Ptr<Face>& face)
   NS_LOG_FUNCTION (this << &face);
 
   face->SetId (m_faceCounter); // sets a unique ID of the face. This ID serves only informational purposes
+  face->SetL3Protocol (this);
 
   shared_ptr<Face> sharedFace = shared_ptr<Face>(GetPointer(face),
                                                  bind(&faceNullDeleter, face));
@@ -264,8 +389,37 @@ L3Protocol::AddFace (const Ptr<Face>& face)
   face->RegisterProtocolHandlers ();
 
   m_faces.push_back (face);
+  if (m_facesById.size () <= face->GetId ())
+    m_facesById.resize (face->GetId () + 1);
+  m_facesById[face->GetId ()] = face;
   m_faceCounter++;
 
+  Ptr<NetDeviceFace> netDeviceFace = DynamicCast<NetDeviceFace> (face);
+  if (netDeviceFace != 0)
+    m_faceByNetDevice.insert (std::make_pair (PeekPointer (netDeviceFace->GetNetDevice ()), face));
+
+  if (m_faceTracesEnabled)
+    ConnectFaceTraces (face);
+
+  return face->GetId ();
+}
+
+void
+L3Protocol::EnableFaceTraces ()
+{
+  if (m_faceTracesEnabled)
+    return;
+
+  m_faceTracesEnabled = true;
+  BOOST_FOREACH (const Ptr<Face>& face, m_faces)
+    {
+      ConnectFaceTraces (face);
+    }
+}
+
+void
+L3Protocol::ConnectFaceTraces (const Ptr<Face>& face)
+{
   face->onReceiveInterest += [this, face] (const Interest& interest) {
     this->m_inInterests(interest, *face);
   };
@@ -281,8 +435,6 @@ L3Protocol::AddFace (const Ptr<Face>& face)
   face->onSendData += [this, face] (const Data& data) {
     this->m_outData(data, *face);
   };
-
-  return face->GetId ();
 }
 
 void
@@ -291,6 +443,7 @@ L3Protocol::RemoveFace (Ptr<Face> face)
   NS_LOG_FUNCTION (this << ::ndn::cref (*face));
 
   face->UnRegisterProtocolHandlers ();
+  face->SetL3Protocol (0);
 
   // Just call the fail method. This should do the work for us and remove face from FIB and PIT
   face->fail ("Remove Face");
@@ -301,6 +454,18 @@ L3Protocol::RemoveFace (Ptr<Face> face)
       return;
     }
   m_faces.erase (face_it);
+
+  if (face->GetId () < m_facesById.size () && m_facesById[face->GetId ()] == face)
+    m_facesById[face->GetId ()] = 0;
+
+  Ptr<NetDeviceFace> netDeviceFace = DynamicCast<NetDeviceFace> (face);
+  if (netDeviceFace != 0)
+    {
+      std::unordered_map<const NetDevice*, Ptr<Face> >::iterator entry =
+        m_faceByNetDevice.find (PeekPointer (netDeviceFace->GetNetDevice ()));
+      if (entry != m_faceByNetDevice.end () && entry->second == face)
+        m_faceByNetDevice.erase (entry);
+    }
 }
 
 Ptr<Face>
@@ -313,26 +478,20 @@ L3Protocol::GetFace (uint32_t index) const
 Ptr<Face>
 L3Protocol::GetFaceById (uint32_t index) const
 {
-  BOOST_FOREACH (const Ptr<Face> &face, m_faces) // this function is not supposed to be called often, so linear search is fine
-    {
-      if (face->GetId () == index)
-        return face;
-    }
-  return 0;
+  // face IDs are assigned sequentially from m_faceCounter
+  if (index >= m_facesById.size ())
+    return 0;
+  return m_facesById[index];
 }
 
 Ptr<Face>
 L3Protocol::GetFaceByNetDevice (Ptr<NetDevice> netDevice) const
 {
-  BOOST_FOREACH (const Ptr<Face> &face, m_faces) // this function is not supposed to be called often, so linear search is fine
-    {
-      Ptr<NetDeviceFace> netDeviceFace = DynamicCast<NetDeviceFace> (face);
-      if (netDeviceFace == 0) continue;
-
-      if (netDeviceFace->GetNetDevice () == netDevice)
-        return face;
-    }
-  return 0;
+  std::unordered_map<const NetDevice*, Ptr<Face> >::const_iterator entry =
+    m_faceByNetDevice.find (PeekPointer (netDevice));
+  if (entry == m_faceByNetDevice.end ())
+    return 0;
+  return entry->second;
 }
 
 uint32_t
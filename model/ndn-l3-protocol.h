@@ -23,10 +23,13 @@
 
 #include <list>
 #include <vector>
+#include <deque>
+#include <unordered_map>
 
 #include "ns3/ptr.h"
 #include "ns3/net-device.h"
 #include "ns3/nstime.h"
+#include "ns3/event-impl.h"
 
 #include "ns3/ndnSIM/NFD/core/privilege-helper.hpp"
 #include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
@@ -121,6 +124,61 @@ public:
   void
   initializeManagement();
 
+  /**
+   * \brief Choose whether NFD management is initialized on the node
+   *
+   * A headless node has no internal face, managers, status server, or /localhost/nfd route.
+   * FibHelper and StrategyChoiceHelper then change FIB and strategy choice table directly.
+   * Must be called before initialize.
+   *
+   * @param headless True to skip initialization of NFD management
+   */
+  void
+  SetHeadless (bool headless);
+
+  /**
+   * \brief Check whether NFD management was skipped on the node
+   */
+  bool
+  IsHeadless () const;
+
+  /**
+   * \brief Deliver a packet to an application, decoupled from the forwarding pipeline
+   *
+   * By default, and always outside of processing of a packet received from a link, the delivery
+   * is scheduled as a new simulator event.  With DeferredAppDelivery attribute set, deliveries
+   * made while such a packet is processed are queued and executed (in order) right after the
+   * forwarder is done with it, in the same event.  Packets that applications send meanwhile are
+   * processed and delivered the same way.
+   *
+   * @param delivery call to App::OnInterest or App::OnData
+   */
+  void
+  ScheduleAppDelivery (const Ptr<EventImpl>& delivery);
+
+  /**
+   * \brief Check whether DeferredAppDelivery is set
+   *
+   * Faces bracket processing of received packets with BeginPacketProcessing and
+   * EndPacketProcessing only in this case.
+   */
+  bool
+  IsAppDeliveryDeferred () const;
+
+  /**
+   * \brief Mark the beginning of processing of a packet received from a link
+   */
+  void
+  BeginPacketProcessing ();
+
+  /**
+   * \brief Mark the end of processing of a packet received from a link
+   *
+   * At the end of the outermost processing, executes deferred application deliveries.
+   */
+  void
+  EndPacketProcessing ();
+
   /**
    * \brief Get the Fib Manager instance
    *
@@ -215,7 +273,7 @@ public:
   GetFace (uint32_t face) const;
 
   /**
-   * \brief Get face by face ID
+   * \brief Get face by face ID (constant time)
    * \param face The face ID number
    * \returns The NdnFace associated with the Ndn face number.
    */
@@ -229,7 +287,7 @@ public:
   RemoveFace (Ptr<Face> face);
 
   /**
-   * \brief Get face for NetDevice
+   * \brief Get face for NetDevice (constant time)
    */
   virtual Ptr<Face>
   GetFaceByNetDevice (Ptr<NetDevice> netDevice) const;
@@ -247,9 +305,29 @@ private:
   L3Protocol(const L3Protocol &); ///< copy constructor is disabled
   L3Protocol &operator = (const L3Protocol &); ///< copy operator is disabled
 
+  /**
+   * \brief Hook face events to InInterests, OutInterests, InData and OutData traces
+   *
+   * Called when the first callback is connected to any of these trace sources, so
+   * that face events are not dispatched per packet when nothing is traced.
+   * Faces added later are hooked in AddFace.
+   */
+  void
+  EnableFaceTraces ();
+
+  void
+  ConnectFaceTraces (const Ptr<Face>& face);
+
+  void
+  configureTables ();
+
+  friend class L3FaceTraceSourceAccessor;
+
 private:
   uint32_t                          m_faceCounter; ///< \brief counter of faces. Increased every time a new face is added to the stack
   FaceList                          m_faces; ///< \brief list of faces that belongs to ndn stack on this node
+  FaceList                          m_facesById; ///< \brief faces indexed by face ID, null for removed faces
+  std::unordered_map<const NetDevice*, Ptr<Face> > m_faceByNetDevice; ///< \brief NetDeviceFaces indexed by their NetDevice
   shared_ptr<Forwarder>             m_forwarder;
 
   shared_ptr<InternalFace>          m_internalFace;
@@ -259,6 +337,12 @@ private:
   shared_ptr<StatusServer>          m_statusServer;
 
   bool                              m_nfdCS = true;
+  bool                              m_headless = false;
+  bool                              m_faceTracesEnabled = false;
+
+  bool                              m_deferredAppDelivery = false;
+  uint32_t                          m_packetProcessingDepth = 0;
+  std::deque<Ptr<EventImpl> >       m_appDeliveries; ///< \brief deliveries deferred until the end of packet processing
 
   // These objects are aggregated, but for optimization, get them here
   Ptr<Node> m_node; ///< \brief node on which ndn stack is installed
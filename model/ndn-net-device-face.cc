@@ -24,6 +24,7 @@
 
 #include "ns3/net-device.h"
 #include "ns3/log.h"
+#include "ns3/ndn-log-level.h"
 #include "ns3/packet.h"
 #include "ns3/node.h"
 #include "ns3/pointer.h"
@@ -52,7 +52,10 @@
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/graphviz.hpp>
 
-#include <set>
+#include <cstdlib>
+#include <fstream>
+#include <unordered_map>
+#include <unordered_set>
 
 #ifdef NS3_MPI
 #include <ns3/mpi-interface.h>
@@ -141,11 +144,122 @@ AnnotatedTopologyReader::GetLinks () const
   return m_linksList;
 }
 
+namespace {
+
+const uint32_t TOPOLOGY_CACHE_MAGIC = 0x4f544e4e; // "NNTO"
+const uint32_t TOPOLOGY_CACHE_VERSION = 1;
+
+/**
+ * \brief Split line into whitespace-separated fields, reusing storage of the fields
+ *
+ * Fields that are not present in the line are cleared.  Text after the last field
+ * is ignored.
+ */
+void
+SplitFields (const string &line, vector<string> &fields)
+{
+  size_t pos = 0;
+  for (vector<string>::iterator field = fields.begin (); field != fields.end (); field++)
+    {
+      pos = line.find_first_not_of (" \t\r", pos);
+      if (pos == string::npos)
+        {
+          field->clear ();
+          continue;
+        }
+
+      size_t end = line.find_first_of (" \t\r", pos);
+      if (end == string::npos)
+        end = line.size ();
+
+      field->assign (line, pos, end - pos);
+      pos = end;
+    }
+}
+
+/**
+ * \brief Type and attributes of an object, as given in <Type>,<Attribute>=<Value>,... format
+ */
+struct ObjectSpec
+{
+  string type;
+  vector< pair<string, string> > attributes;
+};
+
+/**
+ * \brief Parse object specification, logging malformed attributes
+ */
+void
+ParseObjectSpec (const string &value, const char *what, ObjectSpec &spec)
+{
+  typedef boost::tokenizer<boost::escaped_list_separator<char> > tokenizer;
+  tokenizer tok (value);
+
+  tokenizer::iterator token = tok.begin ();
+  spec.type = *token;
+
+  for (token ++; token != tok.end (); token ++)
+    {
+      boost::escaped_list_separator<char> separator ('\\', '=', '\"');
+      tokenizer attributeTok (*token, separator);
+
+      tokenizer::iterator attributeToken = attributeTok.begin ();
+
+      string attribute = *attributeToken;
+      attributeToken++;
+
+      if (attributeToken == attributeTok.end ())
+        {
+          NS_LOG_ERROR (what << " attribute [" << *token << "] should be in form <Attribute>=<Value>");
+          continue;
+        }
+
+      spec.attributes.push_back (make_pair (attribute, *attributeToken));
+    }
+}
+
+template<class T>
+void
+WriteValue (ostream &os, const T &value)
+{
+  os.write (reinterpret_cast<const char*> (&value), sizeof (value));
+}
+
+void
+WriteString (ostream &os, const string &value)
+{
+  WriteValue (os, static_cast<uint32_t> (value.size ()));
+  os.write (value.data (), value.size ());
+}
+
+template<class T>
+T
+ReadValue (istream &is)
+{
+  T value = T ();
+  is.read (reinterpret_cast<char*> (&value), sizeof (value));
+  if (!is)
+    NS_FATAL_ERROR ("Topology cache file is truncated");
+  return value;
+}
+
+void
+ReadString (istream &is, string &value)
+{
+  uint32_t size = ReadValue<uint32_t> (is);
+  value.resize (size);
+  if (size > 0)
+    is.read (&value[0], size);
+  if (!is)
+    NS_FATAL_ERROR ("Topology cache file is truncated");
+}
+
+} // namespace
+
 NodeContainer
 AnnotatedTopologyReader::Read (void)
 {
-  ifstream topgen;
-  topgen.open (GetFileName ().c_str ());
+  ifstream topgen (GetFileName ().c_str (), ios::in | ios::binary);
 
   if ( !topgen.is_open () || !topgen.good () )
     {
@@ -153,35 +267,67 @@ AnnotatedTopologyReader::Read (void)
       return m_nodes;
     }
 
-  while (!topgen.eof ())
+  uint32_t magic = 0;
+  topgen.read (reinterpret_cast<char*> (&magic), sizeof (magic));
+  bool isCache = topgen.gcount () == sizeof (magic) && magic == TOPOLOGY_CACHE_MAGIC;
+
+  if (isCache)
     {
-      string line;
-      getline (topgen, line);
+      ReadCache (topgen);
+    }
+  else
+    {
+      topgen.clear ();
+      topgen.seekg (0);
+      if (!ReadAnnotated (topgen))
+        return m_nodes;
+    }
+
+  NS_LOG_INFO ("Annotated topology created with " << m_nodes.GetN () << " nodes and " << LinksSize () << " links");
+  topgen.close ();
+
+  ApplySettings ();
 
+  return m_nodes;
+}
+
+bool
+AnnotatedTopologyReader::ReadAnnotated (std::istream &topgen)
+{
+  string line;
+  while (getline (topgen, line))
+    {
       if (line == "router") break;
     }
 
-  if (topgen.eof ())
+  if (!topgen)
     {
       NS_FATAL_ERROR ("Topology file " << GetFileName () << " does not have \"router\" section");
-      return m_nodes;
+      return false;
     }
 
-  while (!topgen.eof ())
+  // node names are resolved locally instead of through the ns3::Names path lookup
+  unordered_map<string, Ptr<Node> > nodes;
+  vector<string> fields (5);
+
+  bool hasLinkSection = false;
+  while (getline (topgen, line))
     {
-      string line;
-      getline (topgen,line);
       if (line[0] == '#') continue; // comments
-      if (line=="link") break; // stop reading nodes
-
-      istringstream lineBuffer (line);
-      string name, city;
-      double latitude = 0, longitude = 0;
-      uint32_t systemId = 0;
+      if (line=="link") // stop reading nodes
+        {
+          hasLinkSection = true;
+          break;
+        }
 
-      lineBuffer >> name >> city >> latitude >> longitude >> systemId;
+      SplitFields (line, fields);
+      const string &name = fields[0];
       if (name.empty ()) continue;
 
+      double latitude = strtod (fields[2].c_str (), 0);
+      double longitude = strtod (fields[3].c_str (), 0);
+      uint32_t systemId = strtoul (fields[4].c_str (), 0, 10);
+
       Ptr<Node> node;
 
       if (abs(latitude) > 0.001 && abs(latitude) > 0.001)
@@ -192,44 +338,47 @@ AnnotatedTopologyReader::Read (void)
           node = CreateNode (name, var.GetValue (), var.GetValue (), systemId);
           // node = CreateNode (name, systemId);
         }
-    }
 
-  map<string, set<string> > processedLinks; // to eliminate duplications
+      nodes[name] = node;
+    }
 
-  if (topgen.eof ())
+  if (!hasLinkSection)
     {
       NS_LOG_ERROR ("Topology file " << GetFileName () << " does not have \"link\" section");
-      return m_nodes;
+      return false;
     }
 
-  // SeekToSection ("link");
-  while (!topgen.eof ())
+  // to eliminate duplications, keyed by (from node id, to node id)
+  unordered_set<uint64_t> processedLinks;
+
+  fields.resize (7);
+  while (getline (topgen, line))
     {
-      string line;
-      getline (topgen,line);
       if (line == "") continue;
       if (line[0] == '#') continue; // comments
 
       // NS_LOG_DEBUG ("Input: [" << line << "]");
 
-      istringstream lineBuffer (line);
-      string from, to, capacity, metric, delay, maxPackets, lossRate;
+      SplitFields (line, fields);
+      const string &from = fields[0], &to = fields[1], &capacity = fields[2], &metric = fields[3],
+        &delay = fields[4], &maxPackets = fields[5], &lossRate = fields[6];
 
-      lineBuffer >> from >> to >> capacity >> metric >> delay >> maxPackets >> lossRate;
+      unordered_map<string, Ptr<Node> >::const_iterator fromNode = nodes.find (from);
+      if (fromNode == nodes.end ())
+        NS_FATAL_ERROR (from << " node not found");
+      unordered_map<string, Ptr<Node> >::const_iterator toNode = nodes.find (to);
+      if (toNode == nodes.end ())
+        NS_FATAL_ERROR (to << " node not found");
 
-      if (processedLinks[to].size () != 0 &&
-          processedLinks[to].find (from) != processedLinks[to].end ())
+      uint64_t fromId = fromNode->second->GetId ();
+      uint64_t toId = toNode->second->GetId ();
+      if (processedLinks.count ((toId << 32) | fromId) != 0)
         {
           continue; // duplicated link
         }
-      processedLinks[from].insert (to);
+      processedLinks.insert ((fromId << 32) | toId);
 
-      Ptr<Node> fromNode = Names::Find<Node> (m_path, from);
-      NS_ASSERT_MSG (fromNode != 0, from << " node not found");
-      Ptr<Node> toNode   = Names::Find<Node> (m_path, to);
-      NS_ASSERT_MSG (toNode != 0, to << " node not found");
-
-      Link link (fromNode, from, toNode, to);
+      Link link (fromNode->second, from, toNode->second, to);
 
       link.SetAttribute ("DataRate", capacity);
       link.SetAttribute ("OSPF", metric);
@@ -247,12 +396,61 @@ AnnotatedTopologyReader::Read (void)
       NS_LOG_DEBUG ("New link " << from << " <==> " << to << " / " << capacity << " with " << metric << " metric (" << delay << ", " << maxPackets << ", " << lossRate << ")");
     }
 
-  NS_LOG_INFO ("Annotated topology created with " << m_nodes.GetN () << " nodes and " << LinksSize () << " links");
-  topgen.close ();
+  return true;
+}
 
-  ApplySettings ();
+void
+AnnotatedTopologyReader::ReadCache (std::istream &is)
+{
+  uint32_t version = ReadValue<uint32_t> (is);
+  if (version != TOPOLOGY_CACHE_VERSION)
+    NS_FATAL_ERROR ("Topology cache file " << GetFileName () << " has unsupported version " << version);
 
-  return m_nodes;
+  uint32_t nNodes = ReadValue<uint32_t> (is);
+  vector< pair<Ptr<Node>, string> > nodes;
+  nodes.reserve (nNodes);
+
+  string name;
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      ReadString (is, name);
+      uint32_t systemId = ReadValue<uint32_t> (is);
+      bool hasPosition = ReadValue<uint8_t> (is) != 0;
+
+      Ptr<Node> node;
+      if (hasPosition)
+        {
+          double posX = ReadValue<double> (is);
+          double posY = ReadValue<double> (is);
+          node = CreateNode (name, posX, posY, systemId);
+        }
+      else
+        node = CreateNode (name, systemId);
+
+      nodes.push_back (make_pair (node, name));
+    }
+
+  uint32_t nLinks = ReadValue<uint32_t> (is);
+  string attribute, value;
+  for (uint32_t i = 0; i < nLinks; i++)
+    {
+      uint32_t from = ReadValue<uint32_t> (is);
+      uint32_t to = ReadValue<uint32_t> (is);
+      if (from >= nodes.size () || to >= nodes.size ())
+        NS_FATAL_ERROR ("Topology cache file " << GetFileName () << " is corrupted");
+
+      Link link (nodes[from].first, nodes[from].second, nodes[to].first, nodes[to].second);
+
+      uint32_t nAttributes = ReadValue<uint32_t> (is);
+      for (uint32_t j = 0; j < nAttributes; j++)
+        {
+          ReadString (is, attribute);
+          ReadString (is, value);
+          link.SetAttribute (attribute, value);
+        }
+
+      AddLink (link);
+    }
 }
 
 void
@@ -335,19 +533,25 @@ AnnotatedTopologyReader::ApplySettings ()
 
   PointToPointHelper p2p;
 
+  // Links usually share few distinct settings: parse each only once and reconfigure
+  // the helper only when the setting differs from the one used for the previous link
+  unordered_map<string, ObjectSpec> objectSpecs;
+  string currentMaxPackets, currentDataRate, currentDelay;
+
   BOOST_FOREACH (Link &link, m_linksList)
     {
       // cout << "Link: " << Findlink.GetFromNode () << ", " << link.GetToNode () << endl;
-      string tmp;
+      string value;
 
       ////////////////////////////////////////////////
-      if (link.GetAttributeFailSafe ("MaxPackets", tmp))
+      if (link.GetAttributeFailSafe ("MaxPackets", value) && value != currentMaxPackets)
         {
-          NS_LOG_INFO ("MaxPackets = " + link.GetAttribute ("MaxPackets"));
+          NS_LOG_INFO ("MaxPackets = " + value);
+          currentMaxPackets = value;
 
           try
             {
-              uint32_t maxPackets = boost::lexical_cast<uint32_t> (link.GetAttribute ("MaxPackets"));
+              uint32_t maxPackets = boost::lexical_cast<uint32_t> (value);
 
               // compatibility mode. Only DropTailQueue is supported
               p2p.SetQueue ("ns3::DropTailQueue",
@@ -355,80 +559,56 @@ AnnotatedTopologyReader::ApplySettings ()
             }
           catch (...)
             {
-              typedef boost::tokenizer<boost::escaped_list_separator<char> > tokenizer;
-              tokenizer tok (link.GetAttribute ("MaxPackets"));
-
-              tokenizer::iterator token = tok.begin ();
-              p2p.SetQueue (*token);
-
-              for (token ++; token != tok.end (); token ++)
+              unordered_map<string, ObjectSpec>::iterator spec = objectSpecs.find (value);
+              if (spec == objectSpecs.end ())
                 {
-                  boost::escaped_list_separator<char> separator ('\\', '=', '\"');
-                  tokenizer attributeTok (*token, separator);
-
-                  tokenizer::iterator attributeToken = attributeTok.begin ();
-
-                  string attribute = *attributeToken;
-                  attributeToken++;
-
-                  if (attributeToken == attributeTok.end ())
-                    {
-                      NS_LOG_ERROR ("Queue attribute [" << *token << "] should be in form <Attribute>=<Value>");
-                      continue;
-                    }
-
-                  string value = *attributeToken;
+                  spec = objectSpecs.insert (make_pair (value, ObjectSpec ())).first;
+                  ParseObjectSpec (value, "Queue", spec->second);
+                }
 
-                  p2p.SetQueueAttribute (attribute, StringValue (value));
+              p2p.SetQueue (spec->second.type);
+              for (size_t i = 0; i < spec->second.attributes.size (); i++)
+                {
+                  p2p.SetQueueAttribute (spec->second.attributes[i].first,
+                                         StringValue (spec->second.attributes[i].second));
                 }
             }
         }
 
-      if (link.GetAttributeFailSafe ("DataRate", tmp))
+      if (link.GetAttributeFailSafe ("DataRate", value) && value != currentDataRate)
         {
-          NS_LOG_INFO ("DataRate = " + link.GetAttribute("DataRate"));
-          p2p.SetDeviceAttribute ("DataRate", StringValue (link.GetAttribute ("DataRate")));
+          NS_LOG_INFO ("DataRate = " + value);
+          currentDataRate = value;
+          p2p.SetDeviceAttribute ("DataRate", StringValue (value));
         }
 
-      if (link.GetAttributeFailSafe ("Delay", tmp))
+      if (link.GetAttributeFailSafe ("Delay", value) && value != currentDelay)
         {
-          NS_LOG_INFO ("Delay = " + link.GetAttribute("Delay"));
-          p2p.SetChannelAttribute ("Delay", StringValue (link.GetAttribute ("Delay")));
+          NS_LOG_INFO ("Delay = " + value);
+          currentDelay = value;
+          p2p.SetChannelAttribute ("Delay", StringValue (value));
         }
 
       NetDeviceContainer nd = p2p.Install(link.GetFromNode (), link.GetToNode ());
       link.SetNetDevices (nd.Get (0), nd.Get (1));
 
       ////////////////////////////////////////////////
-      if (link.GetAttributeFailSafe ("LossRate", tmp))
+      if (link.GetAttributeFailSafe ("LossRate", value))
         {
-          NS_LOG_INFO ("LinkError = " + link.GetAttribute("LossRate"));
+          NS_LOG_INFO ("LinkError = " + value);
 
-          typedef boost::tokenizer<boost::escaped_list_separator<char> > tokenizer;
-          tokenizer tok (link.GetAttribute("LossRate"));
-
-          tokenizer::iterator token = tok.begin ();
-          ObjectFactory factory (*token);
-
-          for (token ++; token != tok.end (); token ++)
+          unordered_map<string, ObjectSpec>::iterator spec = objectSpecs.find (value);
+          if (spec == objectSpecs.end ())
             {
-              boost::escaped_list_separator<char> separator ('\\', '=', '\"');
-              tokenizer attributeTok (*token, separator);
-
-              tokenizer::iterator attributeToken = attributeTok.begin ();
-
-              string attribute = *attributeToken;
-              attributeToken++;
-
-              if (attributeToken == attributeTok.end ())
-                {
-                  NS_LOG_ERROR ("ErrorModel attribute [" << *token << "] should be in form <Attribute>=<Value>");
-                  continue;
-                }
-
-              string value = *attributeToken;
+              spec = objectSpecs.insert (make_pair (value, ObjectSpec ())).first;
+              ParseObjectSpec (value, "ErrorModel", spec->second);
+            }
 
-              factory.Set (attribute, StringValue (value));
+          ObjectFactory factory (spec->second.type);
+          for (size_t i = 0; i < spec->second.attributes.size (); i++)
+            {
+              factory.Set (spec->second.attributes[i].first,
+                           StringValue (spec->second.attributes[i].second));
             }
 
           nd.Get (0)->SetAttribute ("ReceiveErrorModel", PointerValue (factory.Create<ErrorModel> ()));
@@ -511,6 +691,64 @@ AnnotatedTopologyReader::SaveTopology (const std::string &file)
 }
 
 
+void
+AnnotatedTopologyReader::SaveTopologyCache (const std::string &file)
+{
+  ofstream os (file.c_str (), ios::trunc | ios::binary);
+  if (!os.is_open ())
+    {
+      NS_FATAL_ERROR ("Cannot open file " << file << " for writing");
+      return;
+    }
+
+  WriteValue (os, TOPOLOGY_CACHE_MAGIC);
+  WriteValue (os, TOPOLOGY_CACHE_VERSION);
+
+  unordered_map<uint32_t, uint32_t> nodeIndex; // node id -> index in the file
+  WriteValue (os, static_cast<uint32_t> (m_nodes.GetN ()));
+  for (NodeContainer::Iterator node = m_nodes.Begin ();
+       node != m_nodes.End ();
+       node++)
+    {
+      uint32_t index = nodeIndex.size ();
+      nodeIndex[(*node)->GetId ()] = index;
+
+      WriteString (os, Names::FindName (*node));
+      WriteValue (os, (*node)->GetSystemId ());
+
+      Ptr<MobilityModel> mobility = (*node)->GetObject<MobilityModel> ();
+      WriteValue (os, static_cast<uint8_t> (mobility != 0));
+      if (mobility != 0)
+        {
+          Vector position = mobility->GetPosition ();
+          WriteValue (os, position.x);
+          WriteValue (os, position.y);
+        }
+    }
+
+  WriteValue (os, static_cast<uint32_t> (m_linksList.size ()));
+  for (std::list<Link>::iterator link = m_linksList.begin ();
+       link != m_linksList.end ();
+       link ++)
+    {
+      WriteValue (os, nodeIndex[link->GetFromNode ()->GetId ()]);
+      WriteValue (os, nodeIndex[link->GetToNode ()->GetId ()]);
+
+      uint32_t nAttributes = std::distance (link->AttributesBegin (), link->AttributesEnd ());
+      WriteValue (os, nAttributes);
+      for (Link::ConstAttributesIterator attribute = link->AttributesBegin ();
+           attribute != link->AttributesEnd ();
+           attribute++)
+        {
+          WriteString (os, attribute->first);
+          WriteString (os, attribute->second);
+        }
+    }
+
+  if (!os)
+    NS_FATAL_ERROR ("Failed to write topology cache file " << file);
+}
+
 template <class Names>
 class name_writer {
 public:
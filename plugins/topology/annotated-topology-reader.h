@@ -25,6 +25,8 @@
 #include "ns3/random-variable.h"
 #include "ns3/object-factory.h"
 
+#include <iosfwd>
+
 namespace ns3 
 {
     
@@ -50,6 +52,7 @@ public:
    * \brief Main annotated topology reading function.
    *
    * This method opens an input stream and reads topology file with annotations.
+   * If the file was created by SaveTopologyCache, it is loaded from the binary format.
    *
    * \return the container of the nodes created (or empty container if there was an error)
    */
@@ -114,6 +117,16 @@ public:
    */
   virtual void
   SaveGraphviz (const std::string &file);
+
+  /**
+   * \brief Save nodes, their positions and links with all attributes in binary format
+   *
+   * The file can be read back with Read () much faster than the text format, and
+   * restores exactly the same node positions.  The format uses native byte order and
+   * is intended only as a cache on the same machine.
+   */
+  virtual void
+  SaveTopologyCache (const std::string &file);
   
 protected:
   Ptr<Node>
@@ -138,6 +151,19 @@ private:
   AnnotatedTopologyReader (const AnnotatedTopologyReader&);
   AnnotatedTopologyReader& operator= (const AnnotatedTopologyReader&);
 
+  /**
+   * \brief Read router and link sections of the text format
+   * \return false if the link section is missing
+   */
+  bool
+  ReadAnnotated (std::istream &is);
+
+  /**
+   * \brief Read file created by SaveTopologyCache
+   */
+  void
+  ReadCache (std::istream &is);
+
   UniformVariable m_randX;
   UniformVariable m_randY;
 
@@ -55,6 +55,7 @@
 #include <boost/graph/connected_components.hpp>
 
 #include <iomanip>
+#include <unordered_map>
 
 using namespace std;
 using namespace boost;
@@ -99,26 +100,44 @@ START "(-*[0-9]+)" SPACE "(@[?A-Za-z0-9,+]+)" SPACE \
 "=([A-Za-z0-9.!-]+)" SPACE "r([0-9])" \
 MAYSPACE END
 
+RocketfuelMapReader::LinkRange::LinkRange (const string &minBw, const string &maxBw,
+                                          const string &minDelay, const string &maxDelay)
+  : minBwValue (minBw)
+  , maxBwValue (maxBw)
+  , minDelayValue (minDelay)
+  , maxDelayValue (maxDelay)
+  , parsed (false)
+{
+}
+
 void
-RocketfuelMapReader::CreateLink (string nodeName1, string nodeName2,
-                                 double averageRtt,
-                                 const string &minBw, const string &maxBw,
-                                 const string &minDelay, const string &maxDelay)
+RocketfuelMapReader::LinkRange::Parse ()
 {
-  Ptr<Node> node1 = Names::Find<Node> (m_path, nodeName1);
-  Ptr<Node> node2 = Names::Find<Node> (m_path, nodeName2);
+  if (parsed)
+    return;
+
+  minBandwidth = static_cast<uint32_t> (lexical_cast<DataRate> (minBwValue).GetBitRate ());
+  maxBandwidth = static_cast<uint32_t> (lexical_cast<DataRate> (maxBwValue).GetBitRate ());
+  minDelay = lexical_cast<Time> (minDelayValue).ToDouble (Time::US);
+  maxDelay = lexical_cast<Time> (maxDelayValue).ToDouble (Time::US);
+  parsed = true;
+}
+
+void
+RocketfuelMapReader::CreateLink (Ptr<Node> node1, const string &nodeName1,
+                                 Ptr<Node> node2, const string &nodeName2,
+                                 double averageRtt, LinkRange &range)
+{
+  range.Parse ();
+
   Link link (node1, nodeName1, node2, nodeName2);
 
-  DataRate randBandwidth
-    (m_randVar.GetInteger (static_cast<uint32_t> (lexical_cast<DataRate> (minBw).GetBitRate ()),
-                           static_cast<uint32_t> (lexical_cast<DataRate> (maxBw).GetBitRate ())));
+  DataRate randBandwidth (m_randVar.GetInteger (range.minBandwidth, range.maxBandwidth));
 
   int32_t metric = std::max (1, static_cast<int32_t> (1.0 * m_referenceOspfRate.GetBitRate () / randBandwidth.GetBitRate ()));
 
   Time randDelay =
-    Time::FromDouble ((m_randVar.GetValue (lexical_cast<Time> (minDelay).ToDouble (Time::US),
-                                           lexical_cast<Time> (maxDelay).ToDouble (Time::US))),
-                      Time::US);
+    Time::FromDouble (m_randVar.GetValue (range.minDelay, range.maxDelay), Time::US);
 
   uint32_t queue = ceil (averageRtt * (randBandwidth.GetBitRate () / 8.0 / 1100.0));
 
@@ -291,7 +310,6 @@ RocketfuelMapReader::Read (RocketfuelParams params, bool keepOneComponent/*=true
   //NodeContainer nodes;
   UniformVariable var;
 
-  istringstream lineBuffer;
   string line;
   int lineNumber = 0;
   char errbuf[512];
@@ -302,36 +320,34 @@ RocketfuelMapReader::Read (RocketfuelParams params, bool keepOneComponent/*=true
     return m_nodes;
   }
 
+  regex_t regex;
+  int ret = regcomp (&regex, ROCKETFUEL_MAPS_LINE, REG_EXTENDED | REG_NEWLINE);
+  if (ret != 0)
+  {
+    regerror (ret, &regex, errbuf, sizeof (errbuf));
+    regfree (&regex);
+    NS_FATAL_ERROR ("Cannot compile regular expression for maps file: " << errbuf);
+    return m_nodes;
+  }
+
   while (!topgen.eof ())
   {
-    int ret;
     int argc;
     char *argv[REGMATCH_MAX];
     char *buf;
 
     lineNumber++;
     line.clear ();
-    lineBuffer.clear ();
 
     getline (topgen, line);
     buf = (char *)line.c_str ();
 
     regmatch_t regmatch[REGMATCH_MAX];
-    regex_t regex;
-
-    ret = regcomp (&regex, ROCKETFUEL_MAPS_LINE, REG_EXTENDED | REG_NEWLINE);
-    if (ret != 0)
-    {
-      regerror (ret, &regex, errbuf, sizeof (errbuf));
-      regfree (&regex);
-      continue;
-    }
 
     ret = regexec (&regex, buf, REGMATCH_MAX, regmatch, 0);
     if (ret == REG_NOMATCH)
     {
       NS_LOG_WARN ("match failed (maps file): %s" << buf);
-      regfree (&regex);
       continue;
     }
 
@@ -354,8 +370,8 @@ RocketfuelMapReader::Read (RocketfuelParams params, bool keepOneComponent/*=true
     }
 
     GenerateFromMapsFile (argc, argv);
-    regfree (&regex);
   }
+  regfree (&regex);
 
   if (keepOneComponent)
     {
@@ -436,10 +452,12 @@ RocketfuelMapReader::Read (RocketfuelParams params, bool keepOneComponent/*=true
       NS_LOG_DEBUG ("After 2 eliminating disconnected nodes:  " << num_vertices(m_graph));
     }
 
+  std::unordered_map<Traits::vertex_descriptor, Ptr<Node> > vertexNodes;
   for (tie(v, endv) = vertices(m_graph); v != endv; v++)
     {
       string nodeName = get (vertex_name, m_graph, *v);
       Ptr<Node> node = CreateNode (nodeName, 0);
+      vertexNodes[*v] = node;
 
       node_type_t type = get (vertex_rank, m_graph, *v);
       switch (type)
@@ -465,6 +483,14 @@ RocketfuelMapReader::Read (RocketfuelParams params, bool keepOneComponent/*=true
         }
     }
 
+  LinkRange
+    b2bRange (params.minb2bBandwidth, params.maxb2bBandwidth,
+              params.minb2bDelay,     params.maxb2bDelay),
+    b2gRange (params.minb2gBandwidth, params.maxb2gBandwidth,
+              params.minb2gDelay,     params.maxb2gDelay),
+    g2cRange (params.ming2cBandwidth, params.maxg2cBandwidth,
+              params.ming2cDelay,     params.maxg2cDelay);
+
   for (tie (e, ende) = edges (m_graph); e != ende; e++)
     {
       Traits::vertex_descriptor
@@ -479,35 +505,27 @@ RocketfuelMapReader::Read (RocketfuelParams params, bool keepOneComponent/*=true
         u_name = get (vertex_name, m_graph, u),
         v_name = get (vertex_name, m_graph, v);
 
+      Ptr<Node>
+        u_node = vertexNodes[u],
+        v_node = vertexNodes[v];
+
       if (u_type == BACKBONE && v_type == BACKBONE)
         {
-          CreateLink (u_name, v_name,
-                      params.averageRtt,
-                      params.minb2bBandwidth, params.maxb2bBandwidth,
-                      params.minb2bDelay,     params.maxb2bDelay);
+          CreateLink (u_node, u_name, v_node, v_name, params.averageRtt, b2bRange);
         }
       else if ((u_type == GATEWAY  && v_type == BACKBONE) ||
                (u_type == BACKBONE && v_type == GATEWAY ))
         {
-          CreateLink (u_name, v_name,
-                      params.averageRtt,
-                      params.minb2gBandwidth, params.maxb2gBandwidth,
-                      params.minb2gDelay,     params.maxb2gDelay);
+          CreateLink (u_node, u_name, v_node, v_name, params.averageRtt, b2gRange);
         }
       else if (u_type == GATEWAY  && v_type == GATEWAY)
         {
-          CreateLink (u_name, v_name,
-                      params.averageRtt,
-                      params.minb2gBandwidth, params.maxb2gBandwidth,
-                      params.minb2gDelay,     params.maxb2gDelay);
+          CreateLink (u_node, u_name, v_node, v_name, params.averageRtt, b2gRange);
         }
       else if ((u_type == GATEWAY  && v_type == CLIENT) ||
                (u_type == CLIENT   && v_type == GATEWAY ))
         {
-          CreateLink (u_name, v_name,
-                      params.averageRtt,
-                      params.ming2cBandwidth, params.maxg2cBandwidth,
-                      params.ming2cDelay,     params.maxg2cDelay);
+          CreateLink (u_node, u_name, v_node, v_name, params.averageRtt, g2cRange);
         }
       else
         {
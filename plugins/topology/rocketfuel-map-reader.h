@@ -130,11 +130,30 @@ private:
   void
   GenerateFromMapsFile (int argc, char *argv[]);
 
+  /**
+   * \brief Ranges of link bandwidth and delay, parsed once per link category on first use
+   */
+  struct LinkRange
+  {
+    LinkRange (const string &minBw, const string &maxBw,
+               const string &minDelay, const string &maxDelay);
+
+    void
+    Parse ();
+
+    const string &minBwValue, &maxBwValue, &minDelayValue, &maxDelayValue;
+    bool parsed;
+
+    uint32_t minBandwidth; ///< \brief in bits per second
+    uint32_t maxBandwidth; ///< \brief in bits per second
+    double minDelay;       ///< \brief in microseconds
+    double maxDelay;       ///< \brief in microseconds
+  };
+
   void
-  CreateLink (string nodeName1, string nodeName2,
-              double averageRtt,
-              const string &minBw, const string &maxBw,
-              const string &minDelay, const string &maxDelay);
+  CreateLink (Ptr<Node> node1, const string &nodeName1,
+              Ptr<Node> node2, const string &nodeName2,
+              double averageRtt, LinkRange &range);
   void
   KeepOnlyBiggestConnectedComponent ();
 
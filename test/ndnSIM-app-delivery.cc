@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#include "ndnSIM-app-delivery.h"
+
+#include "ns3/core-module.h"
+#include "ns3/ndn-l3-protocol.h"
+
+namespace ns3 {
+
+void
+AppDeliveryTest::Deliver (uint32_t id)
+{
+  m_delivered.push_back (id);
+}
+
+void
+AppDeliveryTest::DeliverAndSend (uint32_t id, uint32_t nextId)
+{
+  m_delivered.push_back (id);
+
+  // an application reacting to the delivery, e.g., a producer replying to an Interest, whose
+  // packet is processed and delivered by the same stack
+  m_l3->BeginPacketProcessing ();
+  m_l3->ScheduleAppDelivery (Ptr<EventImpl> (MakeEvent (&AppDeliveryTest::Deliver, this, nextId), false));
+  m_l3->EndPacketProcessing ();
+}
+
+void
+AppDeliveryTest::DoRun ()
+{
+  m_l3 = CreateObject<ndn::L3Protocol> ();
+  m_l3->SetAttribute ("DeferredAppDelivery", BooleanValue (true));
+  NS_TEST_ASSERT_MSG_EQ (m_l3->IsAppDeliveryDeferred (), true, "DeferredAppDelivery should be set");
+
+  std::vector<uint32_t> expected;
+  for (uint32_t i = 0; i < 6; i++)
+    expected.push_back (i);
+
+  // deferred deliveries run in FIFO order when the outermost processing ends
+  m_l3->BeginPacketProcessing ();
+  m_l3->ScheduleAppDelivery (Ptr<EventImpl> (MakeEvent (&AppDeliveryTest::Deliver, this, 0u), false));
+  m_l3->ScheduleAppDelivery (Ptr<EventImpl> (MakeEvent (&AppDeliveryTest::DeliverAndSend, this, 1u, 4u), false));
+
+  m_l3->BeginPacketProcessing ();
+  m_l3->ScheduleAppDelivery (Ptr<EventImpl> (MakeEvent (&AppDeliveryTest::DeliverAndSend, this, 2u, 5u), false));
+  m_l3->EndPacketProcessing ();
+  NS_TEST_EXPECT_MSG_EQ (m_delivered.empty (), true, "nested processing should not run deliveries");
+
+  m_l3->ScheduleAppDelivery (Ptr<EventImpl> (MakeEvent (&AppDeliveryTest::Deliver, this, 3u), false));
+  m_l3->EndPacketProcessing ();
+
+  NS_TEST_EXPECT_MSG_EQ ((m_delivered == expected), true, "deferred deliveries are not in FIFO order");
+  NS_TEST_EXPECT_MSG_EQ (Simulator::IsFinished (), true, "deferred deliveries should not schedule events");
+
+  // outside of processing deliveries are scheduled even when deferral is enabled
+  m_delivered.clear ();
+  m_l3->ScheduleAppDelivery (Ptr<EventImpl> (MakeEvent (&AppDeliveryTest::Deliver, this, 0u), false));
+  NS_TEST_EXPECT_MSG_EQ (m_delivered.empty (), true, "delivery outside of processing should be scheduled");
+
+  // without deferral deliveries are scheduled, in order
+  m_l3->SetAttribute ("DeferredAppDelivery", BooleanValue (false));
+  m_l3->BeginPacketProcessing ();
+  for (uint32_t i = 1; i < 6; i++)
+    m_l3->ScheduleAppDelivery (Ptr<EventImpl> (MakeEvent (&AppDeliveryTest::Deliver, this, i), false));
+  m_l3->EndPacketProcessing ();
+  NS_TEST_EXPECT_MSG_EQ (m_delivered.empty (), true, "deliveries without deferral should be scheduled");
+
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ ((m_delivered == expected), true, "scheduled deliveries are not in order");
+
+  m_l3 = 0;
+  Simulator::Destroy ();
+}
+
+}
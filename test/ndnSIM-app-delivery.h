@@ -0,0 +1,60 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#ifndef NDNSIM_TEST_APP_DELIVERY_H
+#define NDNSIM_TEST_APP_DELIVERY_H
+
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+namespace ndn {
+class L3Protocol;
+}
+
+/**
+ * With DeferredAppDelivery, application deliveries made during processing of a packet run in
+ * FIFO order before EndPacketProcessing returns, including those queued by the deliveries
+ * themselves; otherwise they are scheduled as simulator events
+ */
+class AppDeliveryTest : public TestCase
+{
+public:
+  AppDeliveryTest () : TestCase ("L3Protocol::ScheduleAppDelivery test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void Deliver (uint32_t id);
+  void DeliverAndSend (uint32_t id, uint32_t nextId);
+
+  Ptr<ndn::L3Protocol> m_l3;
+  std::vector<uint32_t> m_delivered;
+};
+
+}
+
+#endif
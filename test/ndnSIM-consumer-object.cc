@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#include "ndnSIM-consumer-object.h"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <set>
+
+namespace ns3 {
+
+namespace {
+
+const uint32_t OBJECT_SIZE = 10000; // 10 segments of 1024 bytes, the last one shorter
+const uint32_t SEGMENT_SIZE = 1024;
+const uint32_t N_SEGMENTS = 10;
+
+} // namespace
+
+void
+ConsumerObjectTest::ObjectFetched (Ptr<ndn::App> app, const ndn::Name& object, Time completionTime,
+                                   uint64_t bytes, double goodput)
+{
+  Fetched fetched;
+  fetched.object = object.toUri ();
+  fetched.completionTime = completionTime;
+  fetched.bytes = bytes;
+  m_fetched.push_back (fetched);
+}
+
+void
+ConsumerObjectTest::InterestSent (std::shared_ptr<const ndn::Interest> interest, Ptr<ndn::App> app,
+                                  Ptr<ndn::Face> face)
+{
+  m_nSent[interest->getName ().toUri ()]++;
+}
+
+void
+ConsumerObjectTest::Run (bool isPayloadVirtual, uint32_t nObjects, Time producerStart, Time duration)
+{
+  m_fetched.clear ();
+  m_nSent.clear ();
+
+  NodeContainer nodes;
+  nodes.Create (1);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll ();
+
+  ndn::AppHelper producerHelper ("ns3::ndn::ProducerObject");
+  producerHelper.SetPrefix ("/object");
+  producerHelper.SetAttribute ("ObjectSize", UintegerValue (OBJECT_SIZE));
+  producerHelper.SetAttribute ("SegmentSize", UintegerValue (SEGMENT_SIZE));
+  producerHelper.SetAttribute ("VirtualPayload", BooleanValue (isPayloadVirtual));
+  producerHelper.Install (nodes.Get (0)).Start (producerStart);
+
+  ndn::AppHelper consumerHelper ("ns3::ndn::ConsumerObject");
+  consumerHelper.SetPrefix ("/object");
+  consumerHelper.SetAttribute ("NumberOfObjects", UintegerValue (nObjects));
+  consumerHelper.SetAttribute ("ObjectRate", DoubleValue (1.0));
+  consumerHelper.SetAttribute ("Window", UintegerValue (4));
+  consumerHelper.SetAttribute ("LifeTime", StringValue ("1s"));
+  Ptr<Application> consumer = consumerHelper.Install (nodes.Get (0)).Get (0);
+  consumer->TraceConnectWithoutContext ("ObjectFetched", MakeCallback (&ConsumerObjectTest::ObjectFetched, this));
+  consumer->TraceConnectWithoutContext ("TransmittedInterests", MakeCallback (&ConsumerObjectTest::InterestSent, this));
+
+  Simulator::Stop (duration);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+ConsumerObjectTest::CheckCompletion (bool isPayloadVirtual)
+{
+  // the producer on the node replies right away, objects are requested about a second apart
+  Run (isPayloadVirtual, 3, Seconds (0), Seconds (30));
+
+  NS_TEST_ASSERT_MSG_EQ (m_fetched.size (), 3u, "all objects should be fetched");
+
+  std::set<std::string> objects;
+  for (std::vector<Fetched>::const_iterator fetched = m_fetched.begin (); fetched != m_fetched.end (); ++fetched)
+    {
+      objects.insert (fetched->object);
+      NS_TEST_EXPECT_MSG_EQ (fetched->bytes, OBJECT_SIZE, "object size should count the content of all segments");
+      NS_TEST_EXPECT_MSG_LT (fetched->completionTime, Seconds (1), "objects should be fetched without retransmissions");
+    }
+  NS_TEST_EXPECT_MSG_EQ (objects.size (), 3u, "each object should be reported once");
+
+  // segment 0 tells the number of segments, the rest is requested once
+  NS_TEST_EXPECT_MSG_EQ (m_nSent.size (), 3 * N_SEGMENTS, "all segments of all objects should be requested");
+  for (std::map<std::string, uint32_t>::const_iterator sent = m_nSent.begin (); sent != m_nSent.end (); ++sent)
+    NS_TEST_EXPECT_MSG_EQ (sent->second, 1u, "segment " << sent->first << " should be requested once");
+}
+
+void
+ConsumerObjectTest::CheckRetransmission ()
+{
+  // Interests are dropped for lack of a route until the producer starts at 2.5 s
+  Run (false, 1, Seconds (2.5), Seconds (10));
+
+  NS_TEST_ASSERT_MSG_EQ (m_fetched.size (), 1u, "the object should be fetched once the producer starts");
+  NS_TEST_EXPECT_MSG_EQ (m_fetched[0].bytes, OBJECT_SIZE, "wrong object size");
+
+  // with no RTT sample, the retransmission timeout is limited by the 1 s LifeTime
+  NS_TEST_EXPECT_MSG_EQ (m_fetched[0].completionTime, Seconds (3), "segment 0 should be retransmitted every second");
+
+  // segment 0 is sent at 0, 1, 2 and 3 s, the other segments once it is received
+  std::string first = ndn::Name ("/object").appendNumber (0).appendSegment (0).toUri ();
+  NS_TEST_EXPECT_MSG_EQ (m_nSent.size (), N_SEGMENTS, "all segments should be requested");
+  for (std::map<std::string, uint32_t>::const_iterator sent = m_nSent.begin (); sent != m_nSent.end (); ++sent)
+    NS_TEST_EXPECT_MSG_EQ (sent->second, sent->first == first ? 4u : 1u, "wrong number of Interests for " << sent->first);
+}
+
+void
+ConsumerObjectTest::DoRun ()
+{
+  CheckCompletion (false);
+  CheckCompletion (true);
+  CheckRetransmission ();
+}
+
+}
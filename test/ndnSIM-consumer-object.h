@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#ifndef NDNSIM_TEST_CONSUMER_OBJECT_H
+#define NDNSIM_TEST_CONSUMER_OBJECT_H
+
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+#include "ns3/ndn-common.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+namespace ndn {
+class App;
+class Face;
+}
+
+/**
+ * ConsumerObject fetches all segments of objects served by ProducerObject, and retransmits
+ * segments until they are received
+ */
+class ConsumerObjectTest : public TestCase
+{
+public:
+  ConsumerObjectTest () : TestCase ("ConsumerObject completion and retransmission test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void Run (bool isPayloadVirtual, uint32_t nObjects, Time producerStart, Time duration);
+
+  void CheckCompletion (bool isPayloadVirtual);
+  void CheckRetransmission ();
+
+  void ObjectFetched (Ptr<ndn::App> app, const ndn::Name& object, Time completionTime,
+                      uint64_t bytes, double goodput);
+  void InterestSent (std::shared_ptr<const ndn::Interest> interest, Ptr<ndn::App> app, Ptr<ndn::Face> face);
+
+  struct Fetched
+  {
+    std::string object;
+    Time completionTime;
+    uint64_t bytes;
+  };
+
+  std::vector<Fetched> m_fetched;
+  std::map<std::string, uint32_t> m_nSent; ///< @brief number of Interests by segment name
+};
+
+}
+
+#endif
@@ -0,0 +1,176 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#include "ndnSIM-consumer-pcon.h"
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM/apps/ndn-consumer-pcon.h"
+
+namespace ns3 {
+
+namespace {
+
+/**
+ * Gives access to window updates, which are otherwise driven by Data and timeouts
+ */
+class TestConsumerPcon : public ndn::ConsumerPcon
+{
+public:
+  void
+  Increase ()
+  {
+    WindowIncrease ();
+  }
+
+  void
+  Decrease (uint32_t sequenceNumber)
+  {
+    WindowDecrease (sequenceNumber);
+  }
+
+  /**
+   * @brief Pretend Interests up to sequenceNumber - 1 were sent
+   */
+  void
+  SetSeq (uint32_t sequenceNumber)
+  {
+    m_seq = sequenceNumber;
+  }
+
+  uint32_t
+  GetWindow () const
+  {
+    return m_window;
+  }
+};
+
+} // namespace
+
+void
+ConsumerPconTest::RecordWindow (double oldValue, double newValue)
+{
+  m_windows.push_back (newValue);
+}
+
+void
+ConsumerPconTest::CheckAimd ()
+{
+  Ptr<TestConsumerPcon> pcon = CreateObject<TestConsumerPcon> ();
+  pcon->TraceConnectWithoutContext ("CongestionWindow", MakeCallback (&ConsumerPconTest::RecordWindow, this));
+  m_windows.assign (1, 1.0);
+
+  // slow start
+  for (int i = 0; i < 3; i++)
+    pcon->Increase ();
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_windows.back (), 4.0, 1e-9, "slow start should grow the window by one per Data");
+  NS_TEST_EXPECT_MSG_EQ (pcon->GetWindow (), 4u, "wrong window in packets");
+
+  // the first signal halves the window, signals for Interests sent before are ignored
+  pcon->SetSeq (10);
+  pcon->Decrease (5);
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_windows.back (), 2.0, 1e-9, "window should be decreased by Beta");
+  pcon->Decrease (7);
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_windows.back (), 2.0, 1e-9, "CWA should ignore signals for earlier Interests");
+
+  // congestion avoidance from the slow start threshold
+  pcon->Increase ();
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_windows.back (), 2.5, 1e-9, "congestion avoidance should grow the window by 1/window");
+  pcon->Increase ();
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_windows.back (), 2.9, 1e-9, "congestion avoidance should grow the window by 1/window");
+  NS_TEST_EXPECT_MSG_EQ (pcon->GetWindow (), 2u, "window in packets should be the integer part");
+
+  // Interests sent after the decrease can decrease the window again, once
+  pcon->SetSeq (20);
+  pcon->Decrease (12);
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_windows.back (), 1.45, 1e-9, "window should be decreased for later Interests");
+  pcon->Decrease (15);
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_windows.back (), 1.45, 1e-9, "CWA should ignore signals for earlier Interests");
+  NS_TEST_EXPECT_MSG_EQ (pcon->GetWindow (), 1u, "wrong window in packets");
+}
+
+void
+ConsumerPconTest::CheckAimdWithoutCwa ()
+{
+  Ptr<TestConsumerPcon> pcon = CreateObject<TestConsumerPcon> ();
+  pcon->SetAttribute ("UseCwa", BooleanValue (false));
+  pcon->TraceConnectWithoutContext ("CongestionWindow", MakeCallback (&ConsumerPconTest::RecordWindow, this));
+  m_windows.assign (1, 1.0);
+
+  for (int i = 0; i < 3; i++)
+    pcon->Increase ();
+
+  // every signal decreases the window, down to one packet
+  pcon->SetSeq (10);
+  pcon->Decrease (5);
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_windows.back (), 2.0, 1e-9, "window should be decreased by Beta");
+  pcon->Decrease (7);
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_windows.back (), 1.0, 1e-9, "without CWA every signal should decrease the window");
+  pcon->Decrease (8);
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_windows.back (), 1.0, 1e-9, "window should not go below one packet");
+  NS_TEST_EXPECT_MSG_EQ (pcon->GetWindow (), 1u, "wrong window in packets");
+}
+
+void
+ConsumerPconTest::CheckCubic ()
+{
+  Ptr<TestConsumerPcon> pcon = CreateObject<TestConsumerPcon> ();
+  pcon->SetAttribute ("CcAlgorithm", StringValue ("CUBIC"));
+  pcon->SetAttribute ("UseCubicFastConvergence", BooleanValue (true));
+  pcon->TraceConnectWithoutContext ("CongestionWindow", MakeCallback (&ConsumerPconTest::RecordWindow, this));
+  m_windows.assign (1, 1.0);
+
+  // slow start to 10 and a decrease by CubicBeta at time 0
+  for (int i = 0; i < 9; i++)
+    pcon->Increase ();
+  pcon->SetSeq (10);
+  pcon->Decrease (10);
+
+  // W_cubic (t) = 0.4 (t - K)^3 + 10 with K = cbrt (10 * 0.3 / 0.4) = 1.957 s; the window
+  // grows by (W_cubic - window) / window per Data
+  Simulator::Schedule (Seconds (0.5), &TestConsumerPcon::Increase, pcon);
+  Simulator::Schedule (Seconds (3.0), &TestConsumerPcon::Increase, pcon);
+
+  // the window is below the previous maximum, so fast convergence lowers W_max to
+  // 7.693 * (1 + 0.7) / 2, which slows the next growth
+  Simulator::Schedule (Seconds (3.0), &TestConsumerPcon::SetSeq, pcon, 20u);
+  Simulator::Schedule (Seconds (3.0), &TestConsumerPcon::Decrease, pcon, 20u);
+  Simulator::Schedule (Seconds (4.0), &TestConsumerPcon::Increase, pcon);
+  Simulator::Run ();
+
+  static const double EXPECTED[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 7,
+                                     7.251671164429333, 7.693171238515319,
+                                     5.385219866960723, 5.574136699128068 };
+  const size_t nExpected = sizeof (EXPECTED) / sizeof (EXPECTED[0]);
+  NS_TEST_ASSERT_MSG_EQ (m_windows.size (), nExpected, "wrong number of window updates");
+  for (size_t i = 0; i < nExpected; i++)
+    NS_TEST_EXPECT_MSG_EQ_TOL (m_windows[i], EXPECTED[i], 1e-9, "wrong window after update " << i);
+
+  Simulator::Destroy ();
+}
+
+void
+ConsumerPconTest::DoRun ()
+{
+  CheckAimd ();
+  CheckAimdWithoutCwa ();
+  CheckCubic ();
+}
+
+}
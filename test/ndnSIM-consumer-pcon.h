@@ -0,0 +1,55 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#ifndef NDNSIM_TEST_CONSUMER_PCON_H
+#define NDNSIM_TEST_CONSUMER_PCON_H
+
+#include "ns3/test.h"
+
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * ConsumerPcon grows and decreases its congestion window following AIMD and CUBIC, and with
+ * UseCwa decreases it at most once for Interests sent before the last decrease
+ */
+class ConsumerPconTest : public TestCase
+{
+public:
+  ConsumerPconTest () : TestCase ("ConsumerPcon window adaptation test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void CheckAimd ();
+  void CheckAimdWithoutCwa ();
+  void CheckCubic ();
+
+  void RecordWindow (double oldValue, double newValue);
+
+  std::vector<double> m_windows; ///< @brief values of CongestionWindow
+};
+
+}
+
+#endif
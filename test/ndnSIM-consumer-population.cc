@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#include "ndnSIM-consumer-population.h"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndnSIM/apps/ndn-consumer-population.h"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include <numeric>
+#include <vector>
+
+namespace ns3 {
+
+namespace {
+
+const double DURATION = 10.0; // seconds
+
+} // namespace
+
+uint64_t
+ConsumerPopulationTest::Run (bool withProducer, uint32_t nUsers, double frequency, uint32_t nContents,
+                             const std::string& meanSessionLength, const std::string& meanOffTime)
+{
+  NodeContainer nodes;
+  nodes.Create (1);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll ();
+
+  if (withProducer)
+    {
+      ndn::AppHelper producerHelper ("ns3::ndn::Producer");
+      producerHelper.SetPrefix ("/population");
+      producerHelper.Install (nodes.Get (0));
+    }
+
+  ndn::AppHelper consumerHelper ("ns3::ndn::ConsumerPopulation");
+  consumerHelper.SetPrefix ("/population");
+  consumerHelper.SetAttribute ("NumberOfUsers", UintegerValue (nUsers));
+  consumerHelper.SetAttribute ("Frequency", DoubleValue (frequency));
+  consumerHelper.SetAttribute ("NumberOfContents", UintegerValue (nContents));
+  consumerHelper.SetAttribute ("MeanSessionLength", StringValue (meanSessionLength));
+  consumerHelper.SetAttribute ("MeanOffTime", StringValue (meanOffTime));
+  consumerHelper.SetAttribute ("LifeTime", StringValue ("1s"));
+  ApplicationContainer apps = consumerHelper.Install (nodes.Get (0));
+  apps.Stop (Seconds (DURATION));
+  m_population = DynamicCast<ndn::ConsumerPopulation> (apps.Get (0));
+
+  Simulator::Stop (Seconds (DURATION));
+  Simulator::Run ();
+
+  // the population is the only source of Interests on the node
+  return nodes.Get (0)->GetObject<ndn::L3Protocol> ()->GetForwarder ()->getCounters ().getNInInterests ();
+}
+
+void
+ConsumerPopulationTest::CheckAggregation ()
+{
+  // 1000 requests a second for a single content, never satisfied
+  uint64_t nInterests = Run (false, 100, 10.0, 1, "0s", "60s");
+
+  uint64_t nRequests = m_population->GetNRequests ();
+  NS_TEST_EXPECT_MSG_EQ_TOL (nRequests, 10000u, 500u, "wrong number of requests");
+  NS_TEST_EXPECT_MSG_EQ (m_population->GetNSatisfied (), 0u, "requests without producer should not be satisfied");
+
+  // one Interest per LifeTime: other requests join it, and time out with it
+  NS_TEST_EXPECT_MSG_EQ (nInterests, 10u, "requests for the same content should be aggregated");
+  NS_TEST_EXPECT_MSG_LT (m_population->GetNTimedOut (), nRequests, "requests of the last Interest have not timed out yet");
+  NS_TEST_EXPECT_MSG_GT (m_population->GetNTimedOut (), nRequests * 8 / 10, "requests of expired Interests should time out");
+
+  std::vector<uint64_t> satisfaction = m_population->GetSatisfactionHistogram (10);
+  NS_TEST_EXPECT_MSG_EQ (satisfaction[0], 100u, "no user should be satisfied");
+
+  m_population = 0;
+  Simulator::Destroy ();
+}
+
+void
+ConsumerPopulationTest::CheckSatisfaction ()
+{
+  // the producer on the node replies right away
+  uint64_t nInterests = Run (true, 100, 1.0, 50, "0s", "60s");
+
+  uint64_t nRequests = m_population->GetNRequests ();
+  NS_TEST_ASSERT_MSG_GT (nRequests, 0u, "no requests made");
+  NS_TEST_EXPECT_MSG_EQ (m_population->GetNSatisfied (), nRequests, "all requests should be satisfied");
+  NS_TEST_EXPECT_MSG_EQ (m_population->GetNTimedOut (), 0u, "no request should time out");
+  NS_TEST_EXPECT_MSG_EQ (nInterests, nRequests, "each request should be sent when Data comes back right away");
+
+  const std::vector<uint64_t>& delays = m_population->GetDelayHistogram ();
+  NS_TEST_EXPECT_MSG_EQ (delays[0], nRequests, "all delays should be in the first bin");
+  NS_TEST_EXPECT_MSG_EQ (std::accumulate (delays.begin (), delays.end (), 0ull), nRequests,
+                         "delay histogram should count each satisfied request once");
+
+  std::vector<uint64_t> satisfaction = m_population->GetSatisfactionHistogram (10);
+  NS_TEST_EXPECT_MSG_EQ (satisfaction[9], std::accumulate (satisfaction.begin (), satisfaction.end (), 0ull),
+                         "all users should be fully satisfied");
+
+  m_population = 0;
+  Simulator::Destroy ();
+}
+
+void
+ConsumerPopulationTest::CheckSessions ()
+{
+  // users are in session a quarter of the time
+  Run (false, 1000, 2.0, 100, "2s", "6s");
+
+  double expected = 1000 * 2.0 * DURATION / 4;
+  NS_TEST_EXPECT_MSG_EQ_TOL (static_cast<double> (m_population->GetNRequests ()), expected, expected * 0.1,
+                             "users should request only during sessions");
+
+  m_population = 0;
+  Simulator::Destroy ();
+}
+
+void
+ConsumerPopulationTest::DoRun ()
+{
+  CheckAggregation ();
+  CheckSatisfaction ();
+  CheckSessions ();
+}
+
+}
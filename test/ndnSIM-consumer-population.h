@@ -0,0 +1,69 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#ifndef NDNSIM_TEST_CONSUMER_POPULATION_H
+#define NDNSIM_TEST_CONSUMER_POPULATION_H
+
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+
+#include <stdint.h>
+#include <string>
+
+namespace ns3 {
+
+namespace ndn {
+class ConsumerPopulation;
+}
+
+/**
+ * ConsumerPopulation aggregates requests of its users for the same content, counts requests
+ * not satisfied within LifeTime as timed out, and switches users between sessions and idle
+ * periods
+ */
+class ConsumerPopulationTest : public TestCase
+{
+public:
+  ConsumerPopulationTest () : TestCase ("ConsumerPopulation test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  /**
+   * @brief Run a ConsumerPopulation on a single node for 10 seconds
+   * @param withProducer whether a producer of the requested prefix runs on the node
+   * @returns number of Interests the population sent
+   */
+  uint64_t
+  Run (bool withProducer, uint32_t nUsers, double frequency, uint32_t nContents,
+       const std::string& meanSessionLength, const std::string& meanOffTime);
+
+  void CheckAggregation ();
+  void CheckSatisfaction ();
+  void CheckSessions ();
+
+  Ptr<ndn::ConsumerPopulation> m_population;
+};
+
+}
+
+#endif
@@ -0,0 +1,56 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#ifndef NDNSIM_TEST_FLUID_TRAFFIC_H
+#define NDNSIM_TEST_FLUID_TRAFFIC_H
+
+#include "ns3/test.h"
+#include "ns3/net-device-container.h"
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * Fluid load of FluidTrafficHelper on a chain matches the bit rate of a packet-level
+ * ConsumerCbr/Producer pair on each device, follows SetFrequency, and reduces data rates
+ */
+class FluidTrafficTest : public TestCase
+{
+public:
+  FluidTrafficTest () : TestCase ("FluidTrafficHelper load test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  /**
+   * @brief Chain of nodes with a producer of /prefix on the last one
+   * @returns devices of the links, sending towards the producer at even positions
+   */
+  NetDeviceContainer
+  BuildChain ();
+};
+
+}
+
+#endif
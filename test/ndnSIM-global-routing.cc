@@ -0,0 +1,188 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#include "ndnSIM-global-routing.h"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/model/ndn-global-router.h"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/fib.hpp"
+
+#include <limits>
+#include <vector>
+
+namespace ns3 {
+
+namespace {
+
+const uint32_t N_ROWS = 4;
+const uint32_t N_COLUMNS = 5;
+const uint32_t UNREACHABLE = std::numeric_limits<uint32_t>::max ();
+
+/**
+ * Cost from every node to the origin, relaxing all faces that are up until nothing changes
+ */
+std::vector<uint32_t>
+GetCostsToOrigin (uint32_t origin)
+{
+  std::vector<uint32_t> costs (NodeList::GetNNodes (), UNREACHABLE);
+  costs[origin] = 0;
+
+  bool isChanged = true;
+  while (isChanged)
+    {
+      isChanged = false;
+      for (uint32_t node = 0; node < costs.size (); node++)
+        {
+          const ndn::GlobalRouter::IncidencyList& incidencies =
+            NodeList::GetNode (node)->GetObject<ndn::GlobalRouter> ()->GetIncidencies ();
+          for (ndn::GlobalRouter::IncidencyList::const_iterator i = incidencies.begin (); i != incidencies.end (); i++)
+            {
+              uint32_t peer = i->get<2> ()->GetObject<Node> ()->GetId ();
+              if (!i->get<1> ()->IsUp () || costs[peer] == UNREACHABLE)
+                continue;
+
+              uint32_t cost = costs[peer] + i->get<1> ()->GetMetric ();
+              if (cost < costs[node])
+                {
+                  costs[node] = cost;
+                  isChanged = true;
+                }
+            }
+        }
+    }
+  return costs;
+}
+
+} // namespace
+
+void
+GlobalRoutingTest::CheckRoutes (const std::string& prefix, uint32_t origin, const std::string& when)
+{
+  std::vector<uint32_t> costs = GetCostsToOrigin (origin);
+
+  for (uint32_t node = 0; node < costs.size (); node++)
+    {
+      if (node == origin)
+        continue;
+
+      // first face on a lowest-cost path, in incidency order
+      Ptr<ndn::Face> expectedFace;
+      uint32_t expectedCost = UNREACHABLE;
+      const ndn::GlobalRouter::IncidencyList& incidencies =
+        NodeList::GetNode (node)->GetObject<ndn::GlobalRouter> ()->GetIncidencies ();
+      for (ndn::GlobalRouter::IncidencyList::const_iterator i = incidencies.begin (); i != incidencies.end (); i++)
+        {
+          uint32_t peer = i->get<2> ()->GetObject<Node> ()->GetId ();
+          if (!i->get<1> ()->IsUp () || costs[peer] == UNREACHABLE)
+            continue;
+
+          uint32_t cost = costs[peer] + i->get<1> ()->GetMetric ();
+          if (cost < expectedCost)
+            {
+              expectedFace = i->get<1> ();
+              expectedCost = cost;
+            }
+        }
+      NS_TEST_ASSERT_MSG_EQ (expectedCost, costs[node], "reference costs are inconsistent");
+
+      const ::nfd::Fib& fib = NodeList::GetNode (node)->GetObject<ndn::L3Protocol> ()->GetForwarder ()->getFib ();
+      std::shared_ptr< ::nfd::fib::Entry> entry = fib.findExactMatch (ndn::Name (prefix));
+      NS_TEST_ASSERT_MSG_EQ (static_cast<bool> (entry), true, "no route to " << prefix << " on node " << node << " " << when);
+
+      const ::nfd::fib::NextHopList& nextHops = entry->getNextHops ();
+      NS_TEST_ASSERT_MSG_EQ (nextHops.size (), 1u, "one next hop to " << prefix << " expected on node " << node << " " << when);
+      NS_TEST_EXPECT_MSG_EQ (nextHops.front ().getFace ()->getId (), expectedFace->getId (),
+                             "wrong next hop to " << prefix << " on node " << node << " " << when);
+      NS_TEST_EXPECT_MSG_EQ (nextHops.front ().getCost (), expectedCost,
+                             "wrong cost to " << prefix << " on node " << node << " " << when);
+    }
+}
+
+void
+GlobalRoutingTest::DoRun ()
+{
+  // node of row r and column c is r * N_COLUMNS + c; links are created column-wise and
+  // row-wise alternately, so that incidency order differs from node to node
+  NodeContainer nodes;
+  nodes.Create (N_ROWS * N_COLUMNS);
+
+  PointToPointHelper p2p;
+  for (uint32_t row = 0; row < N_ROWS; row++)
+    for (uint32_t column = 0; column < N_COLUMNS; column++)
+      {
+        uint32_t node = row * N_COLUMNS + column;
+        if ((row + column) % 2 == 0)
+          {
+            if (row + 1 < N_ROWS)
+              p2p.Install (nodes.Get (node), nodes.Get (node + N_COLUMNS));
+            if (column + 1 < N_COLUMNS)
+              p2p.Install (nodes.Get (node), nodes.Get (node + 1));
+          }
+        else
+          {
+            if (column + 1 < N_COLUMNS)
+              p2p.Install (nodes.Get (node), nodes.Get (node + 1));
+            if (row + 1 < N_ROWS)
+              p2p.Install (nodes.Get (node), nodes.Get (node + N_COLUMNS));
+          }
+      }
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll ();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll ();
+
+  // equal metrics give many equal-cost paths, a few heavier faces break some of them
+  const uint32_t corner = 0;
+  const uint32_t center = 2 * N_COLUMNS + 2;
+  const ndn::GlobalRouter::IncidencyList& incidencies = nodes.Get (N_COLUMNS + 1)->GetObject<ndn::GlobalRouter> ()->GetIncidencies ();
+  for (ndn::GlobalRouter::IncidencyList::const_iterator i = incidencies.begin (); i != incidencies.end (); i++)
+    i->get<1> ()->SetMetric (3);
+
+  ndnGlobalRoutingHelper.AddOrigins ("/corner", nodes.Get (corner));
+  ndnGlobalRoutingHelper.AddOrigins ("/center", nodes.Get (center));
+
+  ndn::GlobalRoutingHelper::SetIncrementalUpdates (true);
+  ndn::GlobalRoutingHelper::CalculateRoutes ();
+  CheckRoutes ("/corner", corner, "after CalculateRoutes");
+  CheckRoutes ("/center", center, "after CalculateRoutes");
+
+  // an updated tree keeps the same tie-break
+  ndn::LinkControlHelper::FailLink (nodes.Get (1), nodes.Get (N_COLUMNS + 1));
+  ndn::GlobalRoutingHelper::UpdateRoutes ();
+  CheckRoutes ("/corner", corner, "after UpdateRoutes");
+  CheckRoutes ("/center", center, "after UpdateRoutes");
+
+  // and so do batched calculations
+  ndn::GlobalRoutingHelper::SetIncrementalUpdates (false);
+  ndn::GlobalRoutingHelper::CalculateRoutes ();
+  CheckRoutes ("/corner", corner, "after recalculation");
+  CheckRoutes ("/center", center, "after recalculation");
+
+  Simulator::Destroy ();
+}
+
+}
@@ -0,0 +1,48 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#ifndef NDNSIM_TEST_GLOBAL_ROUTING_H
+#define NDNSIM_TEST_GLOBAL_ROUTING_H
+
+#include "ns3/test.h"
+
+namespace ns3 {
+
+/**
+ * Routes of GlobalRoutingHelper::CalculateRoutes and UpdateRoutes on a grid match a brute-force
+ * reference: the next hop of each node is its first face, in GlobalRouter incidency order,
+ * among faces on a lowest-cost path to the origin
+ */
+class GlobalRoutingTest : public TestCase
+{
+public:
+  GlobalRoutingTest () : TestCase ("GlobalRoutingHelper equal-cost next hops on a grid test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void CheckRoutes (const std::string& prefix, uint32_t origin, const std::string& when);
+};
+
+}
+
+#endif
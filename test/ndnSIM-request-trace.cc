@@ -0,0 +1,219 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#include "ndnSIM-request-trace.h"
+
+#include "ns3/ndnSIM/utils/ndn-request-trace.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+namespace ns3 {
+
+using ndn::shared_ptr;
+using ndn::Name;
+using ndn::RequestTraceReader;
+using ndn::RequestTraceWriter;
+using ndn::ShardedRequestTraceReader;
+
+static const int64_t START_TIME = 1400000000LL * 1000000000LL; // epoch time, in nanoseconds
+static const int64_t INTERVAL = 7;
+
+std::string
+RequestTraceTest::GetUri (uint32_t i)
+{
+  // names of different lengths, so that records cross chunk boundaries at different offsets
+  std::ostringstream os;
+  os << "/prefix/content/" << i << "/" << std::string (i % 37, 'x');
+  return os.str ();
+}
+
+void
+RequestTraceTest::CheckParseLine ()
+{
+  int64_t time = 0;
+  std::string uri;
+
+  NS_TEST_EXPECT_MSG_EQ (RequestTraceReader::ParseLine ("1700000000.123456789,/a/b", time, uri), true, "");
+  NS_TEST_EXPECT_MSG_EQ (time, 1700000000123456789LL, "epoch time has lost precision");
+  NS_TEST_EXPECT_MSG_EQ (uri, "/a/b", "");
+
+  NS_TEST_EXPECT_MSG_EQ (RequestTraceReader::ParseLine ("  3 /x/y  \r", time, uri), true, "");
+  NS_TEST_EXPECT_MSG_EQ (time, 3000000000LL, "");
+  NS_TEST_EXPECT_MSG_EQ (uri, "/x/y", "");
+
+  NS_TEST_EXPECT_MSG_EQ (RequestTraceReader::ParseLine ("0.5\t/z", time, uri), true, "");
+  NS_TEST_EXPECT_MSG_EQ (time, 500000000LL, "");
+
+  NS_TEST_EXPECT_MSG_EQ (RequestTraceReader::ParseLine ("# comment", time, uri), false, "comment is not a request");
+  NS_TEST_EXPECT_MSG_EQ (RequestTraceReader::ParseLine ("", time, uri), false, "empty line is not a request");
+  NS_TEST_EXPECT_MSG_EQ (RequestTraceReader::ParseLine ("abc /x", time, uri), false, "time is not a number");
+  NS_TEST_EXPECT_MSG_EQ (RequestTraceReader::ParseLine ("12", time, uri), false, "line has no name");
+}
+
+void
+RequestTraceTest::CheckTextTrace ()
+{
+  std::string fileName = CreateTempDirFilename ("requests.txt");
+  std::ofstream file (fileName.c_str ());
+  file << "# time,name\n10.5,/a\n\n11 /b\n";
+  file.close ();
+
+  RequestTraceReader reader;
+  NS_TEST_ASSERT_MSG_EQ (reader.Open (fileName), true, "cannot open text trace");
+
+  int64_t time = -1;
+  Name name;
+  NS_TEST_EXPECT_MSG_EQ (reader.Next (time, name), true, "");
+  NS_TEST_EXPECT_MSG_EQ (time, 0, "times should be relative to the first request");
+  NS_TEST_EXPECT_MSG_EQ (name, Name ("/a"), "");
+  NS_TEST_EXPECT_MSG_EQ (reader.Next (time, name), true, "");
+  NS_TEST_EXPECT_MSG_EQ (time, 500000000LL, "");
+  NS_TEST_EXPECT_MSG_EQ (name, Name ("/b"), "");
+  NS_TEST_EXPECT_MSG_EQ (reader.Next (time, name), false, "trace has only two requests");
+}
+
+void
+RequestTraceTest::CheckBinaryTrace ()
+{
+  RequestTraceWriter writer;
+  NS_TEST_ASSERT_MSG_EQ (writer.Open (m_binaryFile), true, "cannot create binary trace");
+  for (uint32_t i = 0; i < m_nRecords; i++)
+    writer.Write (START_TIME + i * INTERVAL, Name (GetUri (i)));
+  NS_TEST_ASSERT_MSG_EQ (writer.Close (), true, "cannot write binary trace");
+
+  // read back, skipping every third request
+  RequestTraceReader reader;
+  NS_TEST_ASSERT_MSG_EQ (reader.Open (m_binaryFile), true, "cannot open binary trace");
+
+  uint32_t i = 0;
+  int64_t time = 0;
+  Name name;
+  for (;; i++)
+    {
+      if (i % 3 == 1)
+        {
+          if (!reader.Skip ())
+            break;
+          continue;
+        }
+
+      if (!reader.Next (time, name))
+        break;
+
+      NS_TEST_ASSERT_MSG_EQ (time, i * INTERVAL, "wrong time of request " << i);
+      NS_TEST_ASSERT_MSG_EQ (name, Name (GetUri (i)), "wrong name of request " << i);
+    }
+  NS_TEST_EXPECT_MSG_EQ (i, m_nRecords, "wrong number of requests");
+}
+
+void
+RequestTraceTest::CheckShards ()
+{
+  const uint32_t nShards = 3;
+
+  // the last shard is opened late
+  std::vector<shared_ptr<ShardedRequestTraceReader> > shards;
+  for (uint32_t shard = 0; shard < nShards - 1; shard++)
+    shards.push_back (ShardedRequestTraceReader::Open (m_binaryFile, nShards, shard, 0));
+
+  NS_TEST_ASSERT_MSG_EQ ((shards[0] != 0), true, "cannot open binary trace");
+  NS_TEST_EXPECT_MSG_EQ ((shards[1] == shards[0]), true, "shards should share the reader");
+  NS_TEST_EXPECT_MSG_EQ ((ShardedRequestTraceReader::Open (m_binaryFile, nShards, 1, 0) == 0), true,
+                         "shard is already open");
+  NS_TEST_EXPECT_MSG_EQ ((ShardedRequestTraceReader::Open (m_binaryFile, nShards + 1, 0, 0) == 0), true,
+                         "trace is already shared by a different number of shards");
+
+  shared_ptr<ShardedRequestTraceReader> whole = ShardedRequestTraceReader::Open (m_binaryFile, 1, 0, 0);
+  NS_TEST_EXPECT_MSG_EQ ((whole != 0 && whole != shards[0]), true, "a single shard should not be shared");
+
+  // shards interleave their reads; the last one joins half way and stops at three quarters
+  std::vector<uint32_t> next;
+  for (uint32_t shard = 0; shard < nShards; shard++)
+    next.push_back (shard);
+
+  bool isLastOpen = false;
+  bool isLastClosed = false;
+  bool hasNext = true;
+  int64_t time = 0;
+  Name name;
+  while (hasNext)
+    {
+      hasNext = false;
+      for (uint32_t shard = 0; shard < nShards; shard++)
+        {
+          if (shard == nShards - 1 && !isLastOpen)
+            {
+              if (std::max (next[0], next[1]) < m_nRecords / 2)
+                continue;
+
+              // requests of the shard read before it was opened are skipped
+              NS_TEST_ASSERT_MSG_EQ ((ShardedRequestTraceReader::Open (m_binaryFile, nShards, shard, 1)
+                                      == shards[0]), true, "cannot open shard " << shard << " late");
+              NS_TEST_EXPECT_MSG_EQ (shards[0]->GetStartTime (), 0, "shards should share the timeline");
+              uint32_t lastRead = std::max (next[0], next[1]) - nShards;
+              next[shard] = lastRead + 1 + (shard + nShards - (lastRead + 1) % nShards) % nShards;
+              isLastOpen = true;
+            }
+
+          if (shard == nShards - 1 && next[shard] >= m_nRecords * 3 / 4)
+            {
+              if (!isLastClosed)
+                shards[0]->Close (shard);
+              isLastClosed = true;
+              continue;
+            }
+
+          if (!shards[0]->Next (shard, time, name))
+            {
+              NS_TEST_EXPECT_MSG_EQ ((next[shard] >= m_nRecords), true, "shard " << shard << " ended early");
+              continue;
+            }
+
+          NS_TEST_ASSERT_MSG_EQ (time, next[shard] * INTERVAL, "wrong time of request " << next[shard]);
+          NS_TEST_ASSERT_MSG_EQ (name, Name (GetUri (next[shard])), "wrong name of request " << next[shard]);
+          next[shard] += nShards;
+          hasNext = true;
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (isLastClosed, true, "the last shard should have been opened and closed");
+
+  // the unshared reader is not affected by the shards
+  NS_TEST_ASSERT_MSG_EQ ((whole != 0 && whole->Next (0, time, name)), true, "cannot read the whole trace");
+  NS_TEST_EXPECT_MSG_EQ (name, Name (GetUri (0)), "the whole trace should start with the first request");
+}
+
+void
+RequestTraceTest::DoRun ()
+{
+  m_binaryFile = CreateTempDirFilename ("requests.trace");
+
+  CheckParseLine ();
+  CheckTextTrace ();
+  CheckBinaryTrace ();
+  CheckShards ();
+
+  std::remove (m_binaryFile.c_str ());
+}
+
+}
@@ -0,0 +1,61 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#ifndef NDNSIM_TEST_REQUEST_TRACE_H
+#define NDNSIM_TEST_REQUEST_TRACE_H
+
+#include "ns3/test.h"
+
+#include <stdint.h>
+#include <string>
+
+namespace ns3 {
+
+/**
+ * Requests written by RequestTraceWriter are read back by RequestTraceReader, whole, with
+ * skipping and split among shards, and lines of text traces are parsed with nanosecond
+ * precision.  With many records the binary trace spans several mapped chunks.
+ */
+class RequestTraceTest : public TestCase
+{
+public:
+  RequestTraceTest (uint32_t nRecords)
+    : TestCase ("RequestTrace test")
+    , m_nRecords (nRecords)
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void CheckParseLine ();
+  void CheckTextTrace ();
+  void CheckBinaryTrace ();
+  void CheckShards ();
+
+  static std::string GetUri (uint32_t i);
+
+  uint32_t m_nRecords;
+  std::string m_binaryFile;
+};
+
+}
+
+#endif
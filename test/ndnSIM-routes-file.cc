@@ -0,0 +1,177 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#include "ndnSIM-routes-file.h"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/model/ndn-global-router.h"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/fib.hpp"
+
+#include <boost/foreach.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
+
+#include <fstream>
+#include <set>
+
+namespace ns3 {
+
+namespace {
+
+typedef std::set< boost::tuple<uint32_t, std::string, uint64_t, uint64_t> > FibDump; // node, prefix, face, cost
+
+/**
+ * Dump next hops through faces of GlobalRouter, other next hops (e.g., /localhost/nfd
+ * through the internal face) are not installed by GlobalRoutingHelper
+ */
+void
+DumpFibs (FibDump& dump)
+{
+  dump.clear ();
+  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+    {
+      std::set< ::nfd::FaceId> faces;
+      const ndn::GlobalRouter::IncidencyList& incidencies = (*node)->GetObject<ndn::GlobalRouter> ()->GetIncidencies ();
+      for (ndn::GlobalRouter::IncidencyList::const_iterator i = incidencies.begin (); i != incidencies.end (); i++)
+        {
+          faces.insert (i->get<1> ()->getId ());
+        }
+
+      const ::nfd::Fib& fib = (*node)->GetObject<ndn::L3Protocol> ()->GetForwarder ()->getFib ();
+      for (::nfd::Fib::const_iterator entry = fib.begin (); entry != fib.end (); entry++)
+        {
+          BOOST_FOREACH (const ::nfd::fib::NextHop& nextHop, entry->getNextHops ())
+            {
+              if (faces.count (nextHop.getFace ()->getId ()) == 0)
+                continue;
+
+              dump.insert (boost::make_tuple ((*node)->GetId (), entry->getPrefix ().toUri (),
+                                              nextHop.getFace ()->getId (), nextHop.getCost ()));
+            }
+        }
+    }
+}
+
+/**
+ * Remove next hops of the prefix from the dump
+ * @returns number of removed next hops
+ */
+size_t
+RemovePrefix (FibDump& dump, const std::string& prefix)
+{
+  size_t nRemoved = 0;
+  for (FibDump::iterator i = dump.begin (); i != dump.end ();)
+    {
+      if (i->get<1> () == prefix)
+        {
+          dump.erase (i++);
+          nRemoved++;
+        }
+      else
+        i++;
+    }
+  return nRemoved;
+}
+
+} // namespace
+
+void
+RoutesFileTest::BuildTopology (bool extraLink)
+{
+  NodeContainer nodes;
+  nodes.Create (4);
+
+  PointToPointHelper p2p;
+  p2p.Install (nodes.Get (0), nodes.Get (1));
+  p2p.Install (nodes.Get (1), nodes.Get (2));
+  p2p.Install (nodes.Get (2), nodes.Get (3));
+  p2p.Install (nodes.Get (0), nodes.Get (2));
+  if (extraLink)
+    p2p.Install (nodes.Get (1), nodes.Get (3));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll ();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll ();
+  ndnGlobalRoutingHelper.AddOrigins ("/prefix", nodes.Get (3));
+  ndnGlobalRoutingHelper.AddOrigins ("/other", nodes.Get (0));
+}
+
+void
+RoutesFileTest::DoRun ()
+{
+  std::string filename = CreateTempDirFilename ("routes.bin");
+
+  // save routes, a route added manually is not saved
+  BuildTopology (false);
+  ndn::FibHelper::AddRoute (NodeList::GetNode (1), "/manual", NodeList::GetNode (0), 1);
+  ndn::GlobalRoutingHelper::CalculateRoutes ();
+  ndn::GlobalRoutingHelper::SaveRoutes (filename);
+
+  FibDump calculated;
+  DumpFibs (calculated);
+  NS_TEST_EXPECT_MSG_EQ (RemovePrefix (calculated, "/manual"), 1u, "CalculateRoutes should keep the manual route");
+  NS_TEST_ASSERT_MSG_EQ (calculated.empty (), false, "CalculateRoutes should install routes");
+  Simulator::Destroy ();
+
+  // the 32-byte header ends with 4 reserved bytes that must be written as zeros
+  std::ifstream file (filename.c_str (), std::ios::binary);
+  char header[32];
+  NS_TEST_ASSERT_MSG_EQ (static_cast<bool> (file.read (header, sizeof (header))), true, "routes file is too short");
+  for (int i = 28; i < 32; i++)
+    NS_TEST_EXPECT_MSG_EQ (header[i], 0, "padding of the routes file header is not zero");
+  file.close ();
+
+  // load them into the same topology
+  BuildTopology (false);
+  NS_TEST_ASSERT_MSG_EQ (ndn::GlobalRoutingHelper::LoadRoutes (filename), true, "routes should be loaded");
+
+  FibDump loaded;
+  DumpFibs (loaded);
+  NS_TEST_EXPECT_MSG_EQ ((loaded == calculated), true, "loaded routes differ from calculated ones");
+
+  // loaded routes are withdrawn by the next calculation, other routes are kept
+  ndn::FibHelper::AddRoute (NodeList::GetNode (1), "/manual", NodeList::GetNode (0), 1);
+  ndn::GlobalRoutingHelper::CalculateRoutes ();
+
+  FibDump recalculated;
+  DumpFibs (recalculated);
+  NS_TEST_EXPECT_MSG_EQ (RemovePrefix (recalculated, "/manual"), 1u, "CalculateRoutes should keep the manual route");
+  NS_TEST_EXPECT_MSG_EQ ((recalculated == calculated), true, "recalculated routes differ from loaded ones");
+  Simulator::Destroy ();
+
+  // routes saved for another topology are rejected, and FIBs are not changed
+  BuildTopology (true);
+  NS_TEST_EXPECT_MSG_EQ (ndn::GlobalRoutingHelper::LoadRoutes (filename), false,
+                         "routes of a different topology should not be loaded");
+
+  FibDump unchanged;
+  DumpFibs (unchanged);
+  NS_TEST_EXPECT_MSG_EQ (unchanged.empty (), true, "FIBs should not change when routes are rejected");
+  Simulator::Destroy ();
+}
+
+}
@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#include "ndnSIM-seq-state-table.h"
+
+#include "ns3/ndnSIM/utils/ndn-seq-state-table.h"
+
+#include <map>
+
+namespace ns3 {
+
+using ndn::SeqState;
+using ndn::SeqStateTable;
+
+namespace {
+
+class Random
+{
+public:
+  explicit Random (uint32_t seed)
+    : m_state (seed)
+  {
+  }
+
+  uint32_t
+  Next (uint32_t n)
+  {
+    m_state = m_state * UINT64_C (6364136223846793005) + UINT64_C (1442695040888963407);
+    return static_cast<uint32_t> (m_state >> 33) % n;
+  }
+
+private:
+  uint64_t m_state;
+};
+
+} // namespace
+
+void
+SeqStateTableTest::CheckRandomOperations (uint32_t seed, bool isWindow)
+{
+  Random random (seed);
+  SeqStateTable table;
+  std::map<uint32_t, uint32_t> reference; // sequence number, retxCount
+
+  uint32_t windowStart = 0;
+  for (uint32_t i = 0; i < 200000; i++)
+    {
+      uint32_t seq;
+      if (isWindow)
+        {
+          // consumer window sliding forward, with a few very old sequence numbers
+          seq = random.Next (20) == 0 ? random.Next (windowStart + 1) : windowStart + random.Next (64);
+          if (random.Next (8) == 0)
+            windowStart++;
+        }
+      else
+        {
+          // numbers sharing low bits collide in the table
+          seq = random.Next (4) == 0 ? random.Next (64) << 20 : random.Next (1000000);
+        }
+
+      switch (random.Next (3))
+        {
+        case 0:
+          {
+            SeqState& state = table.Insert (seq);
+            NS_TEST_ASSERT_MSG_EQ (state.seq, seq, "Insert returned state of another sequence number");
+
+            std::map<uint32_t, uint32_t>::iterator expected = reference.find (seq);
+            if (expected == reference.end ())
+              {
+                NS_TEST_ASSERT_MSG_EQ (state.retxCount, 0, "new state of " << seq << " is not empty");
+                reference[seq] = 0;
+              }
+            else
+              NS_TEST_ASSERT_MSG_EQ (state.retxCount, expected->second, "Insert lost state of " << seq);
+
+            state.retxCount++;
+            reference[seq]++;
+            break;
+          }
+        case 1:
+          table.Erase (seq);
+          reference.erase (seq);
+          break;
+        default:
+          {
+            SeqState* state = table.Find (seq);
+            std::map<uint32_t, uint32_t>::iterator expected = reference.find (seq);
+            NS_TEST_ASSERT_MSG_EQ ((state != 0), (expected != reference.end ()), "Find of " << seq << " is wrong");
+            if (state != 0)
+              NS_TEST_ASSERT_MSG_EQ (state->retxCount, expected->second, "Find returned wrong state of " << seq);
+          }
+        }
+
+      NS_TEST_ASSERT_MSG_EQ (table.GetSize (), reference.size (), "wrong size after " << i << " operations");
+    }
+
+  for (std::map<uint32_t, uint32_t>::iterator expected = reference.begin (); expected != reference.end (); expected++)
+    {
+      SeqState* state = table.Find (expected->first);
+      NS_TEST_ASSERT_MSG_NE (state, 0, "state of " << expected->first << " is lost");
+      NS_TEST_ASSERT_MSG_EQ (state->retxCount, expected->second, "wrong state of " << expected->first);
+    }
+}
+
+void
+SeqStateTableTest::DoRun ()
+{
+  for (uint32_t seed = 1; seed <= 4; seed++)
+    {
+      CheckRandomOperations (seed, true);
+      CheckRandomOperations (seed, false);
+    }
+}
+
+}
@@ -0,0 +1,49 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#ifndef NDNSIM_TEST_SEQ_STATE_TABLE_H
+#define NDNSIM_TEST_SEQ_STATE_TABLE_H
+
+#include "ns3/test.h"
+
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * SeqStateTable behaves as std::map under random inserts and erases of sequence numbers,
+ * both for a sliding window of consecutive numbers and for colliding arbitrary ones
+ */
+class SeqStateTableTest : public TestCase
+{
+public:
+  SeqStateTableTest () : TestCase ("SeqStateTable test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void CheckRandomOperations (uint32_t seed, bool isWindow);
+};
+
+}
+
+#endif
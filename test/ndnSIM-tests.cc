@@ -22,6 +22,17 @@
 #include "ns3/test.h"
 
 #include "ndnSIM-ndn-ns3.h"
+#include "ndnSIM-routes-file.h"
+#include "ndnSIM-zipf-mandelbrot.h"
+#include "ndnSIM-seq-state-table.h"
+#include "ndnSIM-virtual-payload.h"
+#include "ndnSIM-app-delivery.h"
+#include "ndnSIM-request-trace.h"
+#include "ndnSIM-global-routing.h"
+#include "ndnSIM-fluid-traffic.h"
+#include "ndnSIM-consumer-population.h"
+#include "ndnSIM-consumer-pcon.h"
+#include "ndnSIM-consumer-object.h"
 
 namespace ns3
 {
@@ -35,6 +46,18 @@ public:
     SetDataDir (NS_TEST_SOURCEDIR);
 
     AddTestCase (new NdnNs3Test(), TestCase::QUICK);
+    AddTestCase (new RoutesFileTest (), TestCase::QUICK);
+    AddTestCase (new ZipfMandelbrotTest (), TestCase::QUICK);
+    AddTestCase (new SeqStateTableTest (), TestCase::QUICK);
+    AddTestCase (new VirtualPayloadTest (), TestCase::QUICK);
+    AddTestCase (new AppDeliveryTest (), TestCase::QUICK);
+    AddTestCase (new RequestTraceTest (1000), TestCase::QUICK);
+    AddTestCase (new RequestTraceTest (2000000), TestCase::EXTENSIVE);
+    AddTestCase (new GlobalRoutingTest (), TestCase::QUICK);
+    AddTestCase (new FluidTrafficTest (), TestCase::QUICK);
+    AddTestCase (new ConsumerPopulationTest (), TestCase::QUICK);
+    AddTestCase (new ConsumerPconTest (), TestCase::QUICK);
+    AddTestCase (new ConsumerObjectTest (), TestCase::QUICK);
 
   }
 };
@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#include "ndnSIM-virtual-payload.h"
+
+#include "ns3/packet.h"
+#include "ns3/ndn-data.h"
+#include "ns3/ndn-virtual-payload-tag.h"
+#include "ns3/ndn-fw-hop-count-tag.h"
+
+#include <ndn-cxx/data.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace ns3 {
+
+namespace {
+
+::ndn::Data
+MakeData (uint32_t contentSize)
+{
+  ::ndn::Data data (::ndn::Name ("/prefix/with/some/components/%00%01"));
+  data.setFreshnessPeriod (::ndn::time::seconds (1));
+  if (contentSize > 0)
+    data.setContent (::ndn::make_shared< ::ndn::Buffer> (contentSize));
+
+  uint32_t fakeSignature = 0;
+  ::ndn::Signature signature;
+  signature.setInfo (::ndn::SignatureInfo (static_cast< ::ndn::tlv::SignatureTypeValue> (255)));
+  signature.setValue (::ndn::Block (reinterpret_cast<const uint8_t*> (&fakeSignature), sizeof (fakeSignature)));
+  data.setSignature (signature);
+
+  data.wireEncode ();
+  return data;
+}
+
+} // namespace
+
+void
+VirtualPayloadTest::CheckPaddingSize (uint32_t contentSize)
+{
+  const ::ndn::Block& empty = MakeData (0).wireEncode ();
+  const ::ndn::Block& full = MakeData (contentSize).wireEncode ();
+
+  NS_TEST_ASSERT_MSG_EQ (empty.size () + ndn::Data::getVirtualPaddingSize (empty, contentSize), full.size (),
+                         "wrong padding for " << contentSize << " bytes of virtual content");
+
+  // packets sent by faces
+  ndn::Data virtualData (empty);
+  Ptr<Packet> packet = Create<Packet> ();
+  ndn::VirtualPayloadTag virtualPayload;
+  virtualPayload.Set (contentSize);
+  packet->AddPacketTag (virtualPayload);
+  virtualData.setPacket (packet);
+
+  ndn::Data realData (full);
+
+  NS_TEST_ASSERT_MSG_EQ (virtualData.getWirePacket ()->GetSize (), realData.getWirePacket ()->GetSize (),
+                         "packet with " << contentSize << " bytes of virtual content has wrong size");
+}
+
+void
+VirtualPayloadTest::CheckContentStoreReply ()
+{
+  ndn::Data cached (MakeData (0).wireEncode ());
+  Ptr<Packet> packet = Create<Packet> ();
+  ndn::FwHopCountTag hopCount;
+  hopCount.Set (5);
+  packet->AddPacketTag (hopCount);
+  ndn::VirtualPayloadTag virtualPayload;
+  virtualPayload.Set (1024);
+  packet->AddPacketTag (virtualPayload);
+  cached.setPacket (packet);
+
+  Ptr<const Packet> wirePacket = cached.getWirePacket ();
+  std::shared_ptr<const ndn::Data> reply = cached.getContentStoreReply ();
+  NS_TEST_EXPECT_MSG_EQ ((reply == cached.getContentStoreReply ()), true, "reply should be reused by later hits");
+
+  NS_TEST_ASSERT_MSG_EQ (reply->getWirePacket ()->PeekPacketTag (hopCount), true, "reply has no hop count");
+  NS_TEST_EXPECT_MSG_EQ (hopCount.Get (), 0, "reply should start with a zero hop count");
+  NS_TEST_EXPECT_MSG_EQ (reply->getWirePacket ()->GetSize (), wirePacket->GetSize (),
+                         "reply should keep the virtual payload");
+
+  // the cached Data is not changed
+  NS_TEST_ASSERT_MSG_EQ (cached.getPacket ()->PeekPacketTag (hopCount), true, "cached Data lost its hop count");
+  NS_TEST_EXPECT_MSG_EQ (hopCount.Get (), 5, "hop count of the cached Data has changed");
+  NS_TEST_EXPECT_MSG_EQ ((cached.getWirePacket () == wirePacket), true, "wire packet of the cached Data has changed");
+}
+
+void
+VirtualPayloadTest::CheckCreateWithName (uint32_t contentSize)
+{
+  ndn::Data data (MakeData (contentSize).wireEncode ());
+  std::vector<uint8_t> wireAfterName = data.getWireAfterName ();
+
+  // the same name gives back the same encoding
+  const ::ndn::Block& wire = data.wireEncode ();
+  const ::ndn::Block& sameWire = ndn::Data::createWithName (data.getName (), wireAfterName)->wireEncode ();
+  NS_TEST_ASSERT_MSG_EQ (sameWire.size (), wire.size (), "wrong size of Data with " << contentSize << " bytes");
+  NS_TEST_EXPECT_MSG_EQ (std::equal (wire.begin (), wire.end (), sameWire.begin ()), true,
+                         "wrong encoding of Data with " << contentSize << " bytes");
+
+  // another name keeps the other fields
+  ::ndn::Name name ("/another/name/%00%07");
+  std::shared_ptr<ndn::Data> other = ndn::Data::createWithName (name, wireAfterName);
+  NS_TEST_EXPECT_MSG_EQ (other->getName (), name, "wrong name of created Data");
+  NS_TEST_EXPECT_MSG_EQ (other->getContent ().value_size (), contentSize, "wrong content of created Data");
+  NS_TEST_EXPECT_MSG_EQ ((other->getWireAfterName () == wireAfterName), true, "created Data has other fields");
+}
+
+void
+VirtualPayloadTest::DoRun ()
+{
+  // sizes around the TLV-LENGTH boundaries of Content and Data (253 and 65536)
+  static const uint32_t SIZES[] = { 0, 1, 100, 150, 180, 200, 252, 253, 254, 1024,
+                                    65000, 65400, 65535, 65536, 100000 };
+  for (size_t i = 0; i < sizeof (SIZES) / sizeof (SIZES[0]); i++)
+    {
+      CheckPaddingSize (SIZES[i]);
+      CheckCreateWithName (SIZES[i]);
+    }
+
+  CheckContentStoreReply ();
+}
+
+}
@@ -0,0 +1,51 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#ifndef NDNSIM_TEST_VIRTUAL_PAYLOAD_H
+#define NDNSIM_TEST_VIRTUAL_PAYLOAD_H
+
+#include "ns3/test.h"
+
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * Data with VirtualPayloadTag goes on the wire with the size it would have with real content,
+ * also when it is served from the content store
+ */
+class VirtualPayloadTest : public TestCase
+{
+public:
+  VirtualPayloadTest () : TestCase ("Data virtual payload test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void CheckPaddingSize (uint32_t contentSize);
+  void CheckContentStoreReply ();
+  void CheckCreateWithName (uint32_t contentSize);
+};
+
+}
+
+#endif
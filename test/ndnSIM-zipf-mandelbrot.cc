@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#include "ndnSIM-zipf-mandelbrot.h"
+
+#include "ns3/ndnSIM/utils/ndn-zipf-mandelbrot-distribution.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace ns3 {
+
+using ndn::ZipfMandelbrotDistribution;
+
+namespace {
+
+/**
+ * Rank selection of ConsumerZipfMandelbrot before ZipfMandelbrotDistribution
+ */
+class LinearScan
+{
+public:
+  LinearScan (uint32_t n, double q, double s)
+    : m_pcum (n + 1)
+  {
+    m_pcum[0] = 0.0;
+    for (uint32_t i = 1; i <= n; i++)
+      m_pcum[i] = m_pcum[i - 1] + 1.0 / std::pow (i + q, s);
+
+    for (uint32_t i = 1; i <= n; i++)
+      m_pcum[i] = m_pcum[i] / m_pcum[n];
+  }
+
+  uint32_t
+  GetRank (double uniform) const
+  {
+    for (uint32_t i = 1; i < m_pcum.size (); i++)
+      {
+        if (uniform <= m_pcum[i])
+          return i;
+      }
+    return 1;
+  }
+
+  double
+  GetCumulativeProbability (uint32_t k) const
+  {
+    return m_pcum[k];
+  }
+
+private:
+  std::vector<double> m_pcum;
+};
+
+} // namespace
+
+void
+ZipfMandelbrotTest::CheckRanks (uint32_t n, double q, double s)
+{
+  ZipfMandelbrotDistribution distribution (n, q, s);
+  LinearScan reference (n, q, s);
+
+  for (uint32_t k = 0; k <= n; k++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (distribution.GetCumulativeProbability (k), reference.GetCumulativeProbability (k),
+                             "cumulative probability of rank " << k << " differs (N=" << n << ")");
+    }
+
+  std::vector<double> uniforms;
+  uniforms.push_back (std::numeric_limits<double>::min ());
+  uniforms.push_back (1.0);
+
+  // boundaries between ranks, where rounding matters most
+  for (uint32_t k = 1; k <= n; k++)
+    {
+      double cdf = reference.GetCumulativeProbability (k);
+      uniforms.push_back (cdf);
+      uniforms.push_back (std::nextafter (cdf, 0.0));
+      if (cdf < 1.0)
+        uniforms.push_back (std::nextafter (cdf, 1.0));
+    }
+
+  // deterministic pseudo-random numbers in (0, 1]
+  uint64_t state = 42;
+  for (uint32_t i = 0; i < 10000; i++)
+    {
+      state = state * UINT64_C (6364136223846793005) + UINT64_C (1442695040888963407);
+      uniforms.push_back (static_cast<double> ((state >> 11) + 1) / 9007199254740992.0);
+    }
+
+  for (std::vector<double>::const_iterator uniform = uniforms.begin (); uniform != uniforms.end (); uniform++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (distribution.GetRank (*uniform), reference.GetRank (*uniform),
+                             "rank of " << *uniform << " differs (N=" << n << ", q=" << q << ", s=" << s << ")");
+    }
+}
+
+void
+ZipfMandelbrotTest::DoRun ()
+{
+  CheckRanks (0, 0.7, 0.7);
+  CheckRanks (1, 0.7, 0.7);
+  CheckRanks (2, 0.0, 1.0);
+  CheckRanks (100, 0.7, 0.7);
+  CheckRanks (1000, 0.0, 1.2);
+  CheckRanks (1000, 5.0, 0.3);
+  CheckRanks (10000, 10.0, 2.5);
+
+  // one table per parameters, as long as someone uses it
+  std::shared_ptr<const ZipfMandelbrotDistribution> first = ZipfMandelbrotDistribution::Get (100, 0.7, 0.7);
+  std::shared_ptr<const ZipfMandelbrotDistribution> same = ZipfMandelbrotDistribution::Get (100, 0.7, 0.7);
+  std::shared_ptr<const ZipfMandelbrotDistribution> other = ZipfMandelbrotDistribution::Get (100, 0.7, 0.8);
+
+  NS_TEST_EXPECT_MSG_EQ ((first == same), true, "distributions with the same parameters should be shared");
+  NS_TEST_EXPECT_MSG_EQ ((first == other), false, "distributions with different parameters should not be shared");
+  NS_TEST_EXPECT_MSG_EQ (other->GetS (), 0.8, "wrong parameters of the shared distribution");
+}
+
+}
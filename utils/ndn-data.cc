@@ -20,6 +20,14 @@
 
 #include "ndn-data.h"
 
+#include "ns3/assert.h"
+#include "ns3/ndn-ns3.h"
+#include "ns3/ndn-fw-hop-count-tag.h"
+#include "ns3/ndn-virtual-payload-tag.h"
+
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+#include <ndn-cxx/encoding/tlv.hpp>
+
 namespace ns3 {
 
 namespace ndn {
@@ -47,6 +55,91 @@ void
 Data::setPacket (Ptr<Packet> packet)
 {
   m_packet = packet;
+  m_wirePacket = 0;
+}
+
+Ptr<const Packet>
+Data::getWirePacket () const
+{
+  const ::ndn::Block& block = wireEncode ();
+  if (m_wirePacket == 0 || block.wire () != m_wirePacketBlock.wire ())
+    {
+      VirtualPayloadTag virtualPayload;
+      if (m_packet->PeekPacketTag (virtualPayload))
+        {
+          // zero-filled packet, which ns-3 does not store in memory; the encoding is
+          // prepended to it, making the packet as long as Data with the real content
+          m_wirePacket = Create<Packet> (getVirtualPaddingSize (block, virtualPayload.Get ()));
+          m_wirePacket->AddPacketTag (virtualPayload);
+        }
+      else
+        m_wirePacket = Create<Packet> ();
+
+      FwHopCountTag hopCount;
+      if (m_packet->PeekPacketTag (hopCount))
+        m_wirePacket->AddPacketTag (hopCount);
+
+      ::ndn::Convert::ToPacket (std::make_shared<::ndn::Block> (block), m_wirePacket);
+      m_wirePacketBlock = block;
+    }
+  return m_wirePacket;
+}
+
+std::shared_ptr<const Data>
+Data::getContentStoreReply () const
+{
+  if (m_contentStoreReply == 0 || m_contentStoreReply->wireEncode ().wire () != wireEncode ().wire ())
+    {
+      std::shared_ptr<Data> reply = std::make_shared<Data> (*this);
+      reply->m_contentStoreReply.reset ();
+
+      Ptr<Packet> packet = Create<Packet> ();
+      packet->AddPacketTag (FwHopCountTag ());
+      VirtualPayloadTag virtualPayload;
+      if (m_packet->PeekPacketTag (virtualPayload))
+        packet->AddPacketTag (virtualPayload);
+      reply->setPacket (packet);
+
+      m_contentStoreReply = reply;
+    }
+  return m_contentStoreReply;
+}
+
+uint32_t
+Data::getVirtualPaddingSize (const ::ndn::Block& block, uint32_t contentSize)
+{
+  using ::ndn::tlv::sizeOfVarNumber;
+
+  // the encoded (empty) Content grows by the content and the longer TLV-LENGTH of Content,
+  // and the Data element itself may need a longer TLV-LENGTH
+  size_t valueGrowth = contentSize + sizeOfVarNumber (contentSize) - sizeOfVarNumber (0);
+  return valueGrowth + sizeOfVarNumber (block.value_size () + valueGrowth) - sizeOfVarNumber (block.value_size ());
+}
+
+std::vector<uint8_t>
+Data::getWireAfterName () const
+{
+  const ::ndn::Block& wire = wireEncode ();
+  wire.parse ();
+  ::ndn::Block::element_const_iterator name = wire.find (::ndn::tlv::Name);
+  NS_ASSERT (name != wire.elements_end ());
+
+  return std::vector<uint8_t> (name->wire () + name->size (), wire.value () + wire.value_size ());
+}
+
+std::shared_ptr<Data>
+Data::createWithName (const ::ndn::Name& name, const std::vector<uint8_t>& wireAfterName)
+{
+  const ::ndn::Block& nameWire = name.wireEncode ();
+  size_t valueLength = nameWire.size () + wireAfterName.size ();
+
+  ::ndn::EncodingBuffer encoder (valueLength + 2 * 9, 0); // enough for Data TLV-TYPE and TLV-LENGTH
+  encoder.prependByteArray (wireAfterName.data (), wireAfterName.size ());
+  encoder.prependByteArray (nameWire.wire (), nameWire.size ());
+  encoder.prependVarNumber (valueLength);
+  encoder.prependVarNumber (::ndn::tlv::Data);
+
+  return std::make_shared<Data> (encoder.block ());
 }
 
 } // namespace ndn
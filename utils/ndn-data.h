@@ -25,6 +25,8 @@
 #include "ns3/ptr.h"
 #include <ndn-cxx/data.hpp>
 
+#include <vector>
+
 namespace ns3 {
 
 namespace ndn {
@@ -73,8 +75,67 @@ public:
   void
   setPacket (Ptr<Packet> packet);
 
+  /**
+   * \brief Get the ns-3 packet carrying the wire encoding of this data
+   *
+   * The packet is built on first use and kept with the data, so a Data
+   * sent to many faces (or served repeatedly from the content store) is
+   * converted only once.  Faces should send a Copy () of it.  The packet
+   * is rebuilt if the data has been re-encoded or setPacket was called.
+   *
+   * If the data has VirtualPayloadTag, the packet is padded to the size of the data with
+   * the virtual content (see getVirtualPaddingSize).
+   *
+   * \returns packet with the encoded data and its FwHopCountTag
+   */
+  Ptr<const Packet>
+  getWirePacket () const;
+
+  /**
+   * \brief Get number of bytes to pad encoding of Data with empty content to the size
+   *        it would have with contentSize bytes of content
+   *
+   * Used for Data with VirtualPayloadTag.
+   */
+  static uint32_t
+  getVirtualPaddingSize (const ::ndn::Block& block, uint32_t contentSize);
+
+  /**
+   * \brief Get the wire encoding of the elements after the Name (MetaInfo, Content and
+   *        signature)
+   *
+   * Producers replying with the same fields under different names encode them once and
+   * create each reply with createWithName.
+   */
+  std::vector<uint8_t>
+  getWireAfterName () const;
+
+  /**
+   * \brief Create data with the name, followed by the encoding returned by getWireAfterName
+   *
+   * The name is spliced into a single buffer, without encoding the other fields again.
+   */
+  static std::shared_ptr<Data>
+  createWithName (const ::ndn::Name& name, const std::vector<uint8_t>& wireAfterName);
+
+  /**
+   * \brief Get a copy of this data to be sent when it is found in the content store
+   *
+   * Data served from the content store starts with a zero hop count.  The copy shares the
+   * encoding of this data and has FwHopCountTag 0 (and VirtualPayloadTag of this data, if
+   * any).  It is made on first use and kept with this data, so repeated hits reuse its wire
+   * packet, while this data (which local applications may still hold) is not changed.
+   */
+  std::shared_ptr<const Data>
+  getContentStoreReply () const;
+
 private:
   Ptr<Packet> m_packet = Create<Packet> ();
+
+  mutable Ptr<Packet> m_wirePacket;
+  mutable ::ndn::Block m_wirePacketBlock; ///< @brief encoding m_wirePacket was built from
+
+  mutable std::shared_ptr<Data> m_contentStoreReply;
 };
 
 } // namespace ndn
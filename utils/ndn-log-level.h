@@ -0,0 +1,80 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#ifndef NDN_LOG_LEVEL_H
+#define NDN_LOG_LEVEL_H
+
+#include "ns3/log.h"
+
+/**
+ * \ingroup ndn
+ * \defgroup ndn-log-level Compile-time log level
+ * \brief Removal of low-severity log statements at compile time
+ *
+ * NDNSIM_MIN_LOG_LEVEL is set with ./waf configure --ndnsim-min-log-level=LEVEL.
+ * In translation units that include this header, NS_LOG_* statements below the
+ * level expand to nothing, so they cost nothing even when ns-3 logging is enabled.
+ * NFD_LOG_* macros follow the same threshold.
+ *
+ * Levels use NFD ordering:
+ * - trace: NS_LOG_FUNCTION, NS_LOG_LOGIC, NFD_LOG_TRACE (nothing removed, default)
+ * - debug: NS_LOG_DEBUG, NFD_LOG_DEBUG
+ * - info:  NS_LOG_INFO, NFD_LOG_INFO
+ * - warn:  NS_LOG_WARN, NFD_LOG_WARN
+ * - error: NS_LOG_ERROR, NFD_LOG_ERROR (always kept)
+ */
+
+#define NDNSIM_LOG_LEVEL_TRACE 0
+#define NDNSIM_LOG_LEVEL_DEBUG 1
+#define NDNSIM_LOG_LEVEL_INFO  2
+#define NDNSIM_LOG_LEVEL_WARN  3
+#define NDNSIM_LOG_LEVEL_ERROR 4
+
+#ifndef NDNSIM_MIN_LOG_LEVEL
+#define NDNSIM_MIN_LOG_LEVEL NDNSIM_LOG_LEVEL_TRACE
+#endif
+
+#define NDNSIM_LOG_STRIPPED do { } while (false)
+
+#if NDNSIM_MIN_LOG_LEVEL > NDNSIM_LOG_LEVEL_TRACE
+#undef NS_LOG_FUNCTION
+#define NS_LOG_FUNCTION(parameters) NDNSIM_LOG_STRIPPED
+#undef NS_LOG_FUNCTION_NOARGS
+#define NS_LOG_FUNCTION_NOARGS() NDNSIM_LOG_STRIPPED
+#undef NS_LOG_LOGIC
+#define NS_LOG_LOGIC(msg) NDNSIM_LOG_STRIPPED
+#endif
+
+#if NDNSIM_MIN_LOG_LEVEL > NDNSIM_LOG_LEVEL_DEBUG
+#undef NS_LOG_DEBUG
+#define NS_LOG_DEBUG(msg) NDNSIM_LOG_STRIPPED
+#endif
+
+#if NDNSIM_MIN_LOG_LEVEL > NDNSIM_LOG_LEVEL_INFO
+#undef NS_LOG_INFO
+#define NS_LOG_INFO(msg) NDNSIM_LOG_STRIPPED
+#endif
+
+#if NDNSIM_MIN_LOG_LEVEL > NDNSIM_LOG_LEVEL_WARN
+#undef NS_LOG_WARN
+#define NS_LOG_WARN(msg) NDNSIM_LOG_STRIPPED
+#endif
+
+#endif // NDN_LOG_LEVEL_H
@@ -0,0 +1,395 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#include "ndn-request-trace.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+namespace ns3 {
+namespace ndn {
+
+const char RequestTraceReader::MAGIC[8] = { 'N', 'D', 'N', 'R', 'Q', 'T', 'R', '1' };
+const size_t RequestTraceReader::CHUNK_SIZE;
+
+static const size_t RECORD_HEADER_SIZE = 12; // time and length
+
+static uint64_t
+ReadLittleEndian (const uint8_t* buffer, size_t size)
+{
+  uint64_t value = 0;
+  for (size_t i = size; i > 0; i--)
+    value = (value << 8) | buffer[i - 1];
+  return value;
+}
+
+static void
+WriteLittleEndian (uint8_t* buffer, uint64_t value, size_t size)
+{
+  for (size_t i = 0; i < size; i++, value >>= 8)
+    buffer[i] = static_cast<uint8_t> (value & 0xFF);
+}
+
+RequestTraceReader::RequestTraceReader ()
+  : m_isBinary (false)
+  , m_fileSize (0)
+  , m_position (0)
+  , m_chunk (0)
+  , m_chunkOffset (0)
+  , m_chunkLength (0)
+  , m_hasFirstTime (false)
+  , m_firstTime (0)
+{
+}
+
+RequestTraceReader::~RequestTraceReader ()
+{
+  Close ();
+}
+
+bool
+RequestTraceReader::Open (const std::string& fileName)
+{
+  Close ();
+
+  char magic[sizeof (MAGIC)];
+  std::ifstream probe (fileName.c_str (), std::ios::binary);
+  if (!probe.is_open ())
+    return false;
+  m_isBinary = probe.read (magic, sizeof (magic)) && std::memcmp (magic, MAGIC, sizeof (MAGIC)) == 0;
+  probe.seekg (0, std::ios::end);
+  m_fileSize = probe.tellg ();
+  probe.close ();
+
+  if (!m_isBinary)
+    {
+      m_text.open (fileName.c_str ());
+      m_hasFirstTime = false;
+      return m_text.is_open ();
+    }
+
+  try
+    {
+      boost::interprocess::file_mapping (fileName.c_str (), boost::interprocess::read_only).swap (m_file);
+    }
+  catch (boost::interprocess::interprocess_exception&)
+    {
+      return false;
+    }
+
+  m_position = sizeof (MAGIC);
+  return true;
+}
+
+void
+RequestTraceReader::Close ()
+{
+  boost::interprocess::mapped_region ().swap (m_region);
+  m_chunk = 0;
+  boost::interprocess::file_mapping ().swap (m_file);
+
+  if (m_text.is_open ())
+    m_text.close ();
+  m_text.clear ();
+}
+
+bool
+RequestTraceReader::Next (int64_t& time, Name& name)
+{
+  if (m_isBinary)
+    {
+      const uint8_t* wire = 0;
+      uint32_t length = 0;
+      if (!NextRecord (time, wire, length))
+        return false;
+
+      name.wireDecode (Block (wire, length));
+      return true;
+    }
+
+  if (!NextLine (time, m_uri))
+    return false;
+
+  name = Name (m_uri);
+  return true;
+}
+
+bool
+RequestTraceReader::Skip ()
+{
+  int64_t time;
+  if (m_isBinary)
+    {
+      const uint8_t* wire = 0;
+      uint32_t length = 0;
+      return NextRecord (time, wire, length);
+    }
+
+  return NextLine (time, m_uri);
+}
+
+bool
+RequestTraceReader::Ensure (size_t n)
+{
+  if (!m_isBinary || m_position + n > m_fileSize)
+    return false;
+
+  if (m_chunk != 0 && m_position >= m_chunkOffset && m_position + n <= m_chunkOffset + m_chunkLength)
+    return true;
+
+  // map the next chunk, the part already read is not needed anymore
+  m_chunk = 0;
+  m_chunkOffset = m_position;
+  m_chunkLength = std::min<uint64_t> (std::max<uint64_t> (CHUNK_SIZE, n), m_fileSize - m_chunkOffset);
+  try
+    {
+      boost::interprocess::mapped_region (m_file, boost::interprocess::read_only,
+                                          m_chunkOffset, m_chunkLength).swap (m_region);
+    }
+  catch (boost::interprocess::interprocess_exception&)
+    {
+      return false;
+    }
+
+  m_chunk = static_cast<const uint8_t*> (m_region.get_address ());
+  return true;
+}
+
+bool
+RequestTraceReader::NextRecord (int64_t& time, const uint8_t*& wire, uint32_t& length)
+{
+  if (!Ensure (RECORD_HEADER_SIZE))
+    return false;
+
+  const uint8_t* record = m_chunk + (m_position - m_chunkOffset);
+  time = static_cast<int64_t> (ReadLittleEndian (record, 8));
+  length = static_cast<uint32_t> (ReadLittleEndian (record + 8, 4));
+
+  // a truncated record ends the trace
+  if (!Ensure (RECORD_HEADER_SIZE + length))
+    return false;
+
+  wire = m_chunk + (m_position - m_chunkOffset) + RECORD_HEADER_SIZE;
+  m_position += RECORD_HEADER_SIZE + length;
+  return true;
+}
+
+bool
+RequestTraceReader::NextLine (int64_t& time, std::string& uri)
+{
+  while (std::getline (m_text, m_line))
+    {
+      if (!ParseLine (m_line, time, uri))
+        continue;
+
+      if (!m_hasFirstTime)
+        {
+          m_firstTime = time;
+          m_hasFirstTime = true;
+        }
+      time -= m_firstTime;
+      return true;
+    }
+
+  return false;
+}
+
+bool
+RequestTraceReader::ParseLine (const std::string& line, int64_t& time, std::string& uri)
+{
+  static const char* SPACE = " \t\r";
+  static const char* SEPARATOR = " \t\r,";
+
+  size_t timeBegin = line.find_first_not_of (SPACE);
+  if (timeBegin == std::string::npos || line[timeBegin] == '#')
+    return false;
+
+  size_t timeEnd = line.find_first_of (SEPARATOR, timeBegin);
+  if (timeEnd == std::string::npos)
+    return false;
+
+  // parse seconds and nanoseconds separately, as a double would lose precision of epoch times
+  bool hasDigits = false;
+  int64_t seconds = 0;
+  int64_t nanoseconds = 0;
+  size_t i = timeBegin;
+  for (; i < timeEnd && line[i] >= '0' && line[i] <= '9'; i++)
+    {
+      seconds = seconds * 10 + (line[i] - '0');
+      hasDigits = true;
+    }
+  if (i < timeEnd && line[i] == '.')
+    {
+      int64_t scale = 100000000;
+      for (i++; i < timeEnd && line[i] >= '0' && line[i] <= '9'; i++)
+        {
+          nanoseconds += (line[i] - '0') * scale;
+          scale /= 10;
+          hasDigits = true;
+        }
+    }
+  if (!hasDigits || i != timeEnd)
+    return false;
+
+  size_t uriBegin = line.find_first_not_of (SEPARATOR, timeEnd);
+  if (uriBegin == std::string::npos)
+    return false;
+  size_t uriEnd = line.find_last_not_of (SPACE);
+
+  time = seconds * 1000000000 + nanoseconds;
+  uri.assign (line, uriBegin, uriEnd - uriBegin + 1);
+  return true;
+}
+
+ShardedRequestTraceReader::ShardedRequestTraceReader (uint32_t shardCount, int64_t startTime)
+  : m_startTime (startTime)
+  , m_nRead (0)
+  , m_queues (shardCount)
+  , m_isOpen (shardCount, false)
+{
+}
+
+shared_ptr<ShardedRequestTraceReader>
+ShardedRequestTraceReader::Open (const std::string& fileName, uint32_t shardCount, uint32_t shardIndex,
+                                 int64_t startTime)
+{
+  if (shardIndex >= shardCount)
+    return shared_ptr<ShardedRequestTraceReader> ();
+
+  // readers are released with the last consumer holding them
+  static std::map<std::string, std::weak_ptr<ShardedRequestTraceReader> > readers;
+
+  shared_ptr<ShardedRequestTraceReader> reader;
+  if (shardCount > 1)
+    reader = readers[fileName].lock ();
+  if (reader != 0)
+    {
+      if (reader->m_queues.size () != shardCount || reader->m_isOpen[shardIndex])
+        return shared_ptr<ShardedRequestTraceReader> ();
+
+      reader->m_isOpen[shardIndex] = true;
+      return reader;
+    }
+
+  reader.reset (new ShardedRequestTraceReader (shardCount, startTime));
+  if (!reader->m_reader.Open (fileName))
+    return shared_ptr<ShardedRequestTraceReader> ();
+  reader->m_isOpen[shardIndex] = true;
+
+  // a consumer replaying the whole trace does not share it with others
+  if (shardCount > 1)
+    readers[fileName] = reader;
+  return reader;
+}
+
+int64_t
+ShardedRequestTraceReader::GetStartTime () const
+{
+  return m_startTime;
+}
+
+bool
+ShardedRequestTraceReader::Next (uint32_t shardIndex, int64_t& time, Name& name)
+{
+  std::deque<Request>& queue = m_queues[shardIndex];
+  if (!queue.empty ())
+    {
+      time = queue.front ().time;
+      name = queue.front ().name;
+      queue.pop_front ();
+      return true;
+    }
+
+  while (true)
+    {
+      uint32_t shard = m_nRead % m_queues.size ();
+      m_nRead++;
+
+      if (shard == shardIndex)
+        return m_reader.Next (time, name);
+
+      if (!m_isOpen[shard])
+        {
+          if (!m_reader.Skip ())
+            return false;
+          continue;
+        }
+
+      Request request;
+      if (!m_reader.Next (request.time, request.name))
+        return false;
+      m_queues[shard].push_back (request);
+    }
+}
+
+void
+ShardedRequestTraceReader::Close (uint32_t shardIndex)
+{
+  m_isOpen[shardIndex] = false;
+  std::deque<Request> ().swap (m_queues[shardIndex]);
+}
+
+RequestTraceWriter::RequestTraceWriter ()
+  : m_hasFirstTime (false)
+  , m_firstTime (0)
+{
+}
+
+bool
+RequestTraceWriter::Open (const std::string& fileName)
+{
+  m_file.open (fileName.c_str (), std::ios::binary | std::ios::trunc);
+  if (!m_file.is_open ())
+    return false;
+
+  m_hasFirstTime = false;
+  m_file.write (RequestTraceReader::MAGIC, sizeof (RequestTraceReader::MAGIC));
+  return m_file.good ();
+}
+
+void
+RequestTraceWriter::Write (int64_t time, const Name& name)
+{
+  if (!m_hasFirstTime)
+    {
+      m_firstTime = time;
+      m_hasFirstTime = true;
+    }
+
+  const Block& wire = name.wireEncode ();
+
+  uint8_t header[RECORD_HEADER_SIZE];
+  WriteLittleEndian (header, static_cast<uint64_t> (time - m_firstTime), 8);
+  WriteLittleEndian (header + 8, wire.size (), 4);
+
+  m_file.write (reinterpret_cast<const char*> (header), sizeof (header));
+  m_file.write (reinterpret_cast<const char*> (wire.wire ()), wire.size ());
+}
+
+bool
+RequestTraceWriter::Close ()
+{
+  m_file.close ();
+  return !m_file.fail ();
+}
+
+} // namespace ndn
+} // namespace ns3
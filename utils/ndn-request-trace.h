@@ -0,0 +1,235 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#ifndef NDN_REQUEST_TRACE_H
+#define NDN_REQUEST_TRACE_H
+
+#include "ns3/ndn-common.h"
+
+#include <stdint.h>
+#include <string>
+#include <fstream>
+#include <vector>
+#include <deque>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Sequential reader of request traces (time and name of every request)
+ *
+ * Two formats are recognized by content:
+ *
+ * - binary: the 8-byte magic "NDNRQTR1", followed by records of 64-bit time in nanoseconds
+ *   since the first request and 32-bit length (both little-endian) and the TLV encoding of
+ *   the name.  The file is memory-mapped in chunks of CHUNK_SIZE bytes, which are unmapped
+ *   once read, so traces much larger than memory can be replayed.
+ *
+ * - text: lines "<time> <name>" or "<time>,<name>", where time is in seconds (the fractional
+ *   part is taken with nanosecond precision) and name is a URI.  Empty lines and lines
+ *   starting with '#' are ignored.  Times are taken relative to the first request.
+ *
+ * Requests are expected to be ordered by time.  Binary traces are produced from text ones
+ * with RequestTraceWriter (see the ndn-request-trace-convert program).
+ */
+class RequestTraceReader
+{
+public:
+  RequestTraceReader ();
+
+  ~RequestTraceReader ();
+
+  /**
+   * @brief Open a trace file
+   * @returns false if the file cannot be opened or mapped
+   */
+  bool
+  Open (const std::string& fileName);
+
+  void
+  Close ();
+
+  /**
+   * @brief Read the next request
+   * @param[out] time time of the request in nanoseconds since the first request
+   * @param[out] name name of the request
+   * @returns false at the end of the trace
+   */
+  bool
+  Next (int64_t& time, Name& name);
+
+  /**
+   * @brief Skip the next request without decoding its name (binary traces)
+   * @returns false at the end of the trace
+   */
+  bool
+  Skip ();
+
+  /**
+   * @brief Parse a line of a text trace
+   * @param[out] time time of the request in nanoseconds
+   * @param[out] uri name of the request
+   * @returns false if the line does not contain a request
+   */
+  static bool
+  ParseLine (const std::string& line, int64_t& time, std::string& uri);
+
+  static const char MAGIC[8];
+  static const size_t CHUNK_SIZE = 64 * 1024 * 1024;
+
+private:
+  /**
+   * @brief Make sure that n bytes starting at m_position are mapped
+   */
+  bool
+  Ensure (size_t n);
+
+  bool
+  NextRecord (int64_t& time, const uint8_t*& wire, uint32_t& length);
+
+  bool
+  NextLine (int64_t& time, std::string& uri);
+
+private:
+  bool m_isBinary;
+
+  // binary trace
+  boost::interprocess::file_mapping m_file;
+  boost::interprocess::mapped_region m_region;
+  uint64_t m_fileSize;
+  uint64_t m_position;      ///< @brief offset of the next record in the file
+  const uint8_t* m_chunk;   ///< @brief mapped part of the file (m_region)
+  uint64_t m_chunkOffset;
+  size_t m_chunkLength;
+
+  // text trace
+  std::ifstream m_text;
+  bool m_hasFirstTime;
+  int64_t m_firstTime;
+  std::string m_line;
+  std::string m_uri;
+};
+
+/**
+ * @ingroup ndn-apps
+ * @brief Reader of a request trace split among several consumers
+ *
+ * Request i of the trace belongs to shard i % shardCount.  All shards of a trace share one
+ * reader (see Open), so the trace is read and mapped once whatever the number of shards.
+ *
+ * Requests read ahead for other open shards are queued until those shards ask for them.
+ * Requests of shards that are not open (not opened yet or already closed) are skipped without
+ * decoding, so a shard opened late starts at the current position of the reader.  All shards
+ * replay the trace on one timeline, starting when the first shard opened it (GetStartTime),
+ * so a shard asks for a request before the time of the request, and the queues hold only
+ * requests due until the time of the request being read.
+ */
+class ShardedRequestTraceReader
+{
+public:
+  /**
+   * @brief Open a shard of a trace shared by shardCount consumers, opening the trace if no
+   *        consumer holds its reader yet (a trace with one shard is never shared)
+   * @param startTime current time (in nanoseconds), the start of the replay if the trace is
+   *                  opened
+   * @returns null if the file cannot be opened, if the trace is already shared by a different
+   *          number of consumers, or if the shard is already open
+   */
+  static shared_ptr<ShardedRequestTraceReader>
+  Open (const std::string& fileName, uint32_t shardCount, uint32_t shardIndex, int64_t startTime);
+
+  /**
+   * @brief Get time (in nanoseconds) the replay started, times of requests are relative to it
+   */
+  int64_t
+  GetStartTime () const;
+
+  /**
+   * @brief Read the next request of a shard
+   * @returns false at the end of the trace
+   */
+  bool
+  Next (uint32_t shardIndex, int64_t& time, Name& name);
+
+  /**
+   * @brief Stop reading requests of a shard, its queued requests are dropped
+   */
+  void
+  Close (uint32_t shardIndex);
+
+private:
+  ShardedRequestTraceReader (uint32_t shardCount, int64_t startTime);
+
+  struct Request
+  {
+    int64_t time;
+    Name name;
+  };
+
+  RequestTraceReader m_reader;
+  int64_t m_startTime;
+  uint64_t m_nRead; ///< @brief number of requests read from the trace
+  std::vector<std::deque<Request> > m_queues;
+  std::vector<bool> m_isOpen;
+};
+
+/**
+ * @ingroup ndn-apps
+ * @brief Writer of binary request traces (see RequestTraceReader)
+ */
+class RequestTraceWriter
+{
+public:
+  RequestTraceWriter ();
+
+  /**
+   * @returns false if the file cannot be created
+   */
+  bool
+  Open (const std::string& fileName);
+
+  /**
+   * @brief Append a request
+   * @param time time of the request in nanoseconds; the time of the first request is subtracted
+   * @param name name of the request
+   */
+  void
+  Write (int64_t time, const Name& name);
+
+  /**
+   * @returns false if writing failed
+   */
+  bool
+  Close ();
+
+private:
+  std::ofstream m_file;
+  bool m_hasFirstTime;
+  int64_t m_firstTime;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_REQUEST_TRACE_H
@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#include "ndn-seq-state-table.h"
+
+namespace ns3 {
+namespace ndn {
+
+static const size_t INITIAL_SLOTS = 16;
+
+SeqStateTable::SeqStateTable ()
+  : m_slots (INITIAL_SLOTS)
+  , m_mask (INITIAL_SLOTS - 1)
+  , m_size (0)
+{
+}
+
+SeqState&
+SeqStateTable::Insert (uint32_t seq)
+{
+  SeqState* existing = Find (seq);
+  if (existing != 0)
+    return *existing;
+
+  if (2 * (m_size + 1) > m_slots.size ())
+    Grow ();
+
+  size_t i = seq & m_mask;
+  while (m_slots[i].used)
+    i = (i + 1) & m_mask;
+
+  m_slots[i].used = true;
+  m_slots[i].state = SeqState ();
+  m_slots[i].state.seq = seq;
+  m_size++;
+
+  return m_slots[i].state;
+}
+
+void
+SeqStateTable::Erase (uint32_t seq)
+{
+  size_t i = seq & m_mask;
+  while (m_slots[i].used && m_slots[i].state.seq != seq)
+    i = (i + 1) & m_mask;
+
+  if (!m_slots[i].used)
+    return;
+
+  m_slots[i].used = false;
+  m_size--;
+
+  // shift back following entries of the probe sequence, so lookups need no tombstones
+  for (size_t j = (i + 1) & m_mask; m_slots[j].used; j = (j + 1) & m_mask)
+    {
+      size_t home = m_slots[j].state.seq & m_mask;
+      // entry at j can move to i only if its home slot is not in the cyclic range (i, j]
+      bool homeInRange = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+      if (homeInRange)
+        continue;
+
+      m_slots[i] = m_slots[j];
+      m_slots[j].used = false;
+      i = j;
+    }
+}
+
+void
+SeqStateTable::Grow ()
+{
+  std::vector<Slot> slots (2 * m_slots.size ());
+  slots.swap (m_slots);
+  m_mask = m_slots.size () - 1;
+
+  for (std::vector<Slot>::const_iterator slot = slots.begin (); slot != slots.end (); ++slot)
+    {
+      if (!slot->used)
+        continue;
+
+      size_t i = slot->state.seq & m_mask;
+      while (m_slots[i].used)
+        i = (i + 1) & m_mask;
+      m_slots[i] = *slot;
+    }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#ifndef NDN_SEQ_STATE_TABLE_H
+#define NDN_SEQ_STATE_TABLE_H
+
+#include "ns3/nstime.h"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief State of a sequence number requested by a consumer
+ */
+struct SeqState
+{
+  uint32_t seq;
+  uint32_t retxCount;     ///< @brief number of Interests sent for the sequence number
+  uint32_t timeoutSerial; ///< @brief serial of the retransmission timeout entry, if outstanding
+  bool sent;              ///< @brief firstSent, lastSent and retxCount are valid
+  bool outstanding;       ///< @brief waiting for Data or retransmission timeout
+  bool pendingRetx;       ///< @brief waiting to be retransmitted
+  Time firstSent;         ///< @brief time when the first Interest was sent
+  Time lastSent;          ///< @brief time when the last Interest was sent
+};
+
+/**
+ * @ingroup ndn-apps
+ * @brief Flat open-addressing table of SeqState indexed by sequence number
+ *
+ * Sequence numbers are used as hash values directly, so a window of consecutive sequence
+ * numbers occupies consecutive slots, as in a ring buffer; arbitrary sequence numbers are
+ * handled with linear probing.  Slots are reused without memory allocation, and the table
+ * only grows when it becomes half full.
+ */
+class SeqStateTable
+{
+public:
+  SeqStateTable ();
+
+  /**
+   * @brief Find state of the sequence number
+   * @returns pointer to the state, or 0 if there is none (valid until the next Insert or Erase)
+   */
+  SeqState*
+  Find (uint32_t seq);
+
+  /**
+   * @brief Find state of the sequence number, creating an empty one if there is none
+   */
+  SeqState&
+  Insert (uint32_t seq);
+
+  /**
+   * @brief Remove state of the sequence number, if any
+   */
+  void
+  Erase (uint32_t seq);
+
+  size_t
+  GetSize () const;
+
+private:
+  void
+  Grow ();
+
+private:
+  struct Slot
+  {
+    bool used;
+    SeqState state;
+  };
+
+  std::vector<Slot> m_slots; // size is a power of two
+  size_t m_mask;
+  size_t m_size;
+};
+
+inline SeqState*
+SeqStateTable::Find (uint32_t seq)
+{
+  for (size_t i = seq & m_mask; m_slots[i].used; i = (i + 1) & m_mask)
+    {
+      if (m_slots[i].state.seq == seq)
+        return &m_slots[i].state;
+    }
+  return 0;
+}
+
+inline size_t
+SeqStateTable::GetSize () const
+{
+  return m_size;
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_SEQ_STATE_TABLE_H
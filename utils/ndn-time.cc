@@ -51,8 +51,7 @@ CustomSystemClock::toPosixDuration(const system_clock::duration& duration) const
 steady_clock::time_point
 CustomSteadyClock::getNow() const
 {
-  boost::chrono::nanoseconds ns(Simulator::Now ().GetNanoSeconds());
-  return steady_clock::time_point(ns);
+  return steadyNow();
 }
 
 std::string
@@ -23,6 +23,8 @@
 
 #include <ndn-cxx/util/time-custom-clock.hpp>
 
+#include "ns3/simulator.h"
+
 namespace ns3 {
 namespace ndn {
 namespace time {
@@ -68,6 +70,20 @@ public:
   toPosixDuration(const steady_clock::duration& duration) const;
 };
 
+/**
+ * \ingroup ndn-time
+ * @brief Get current simulation time as steady_clock::TimePoint
+ *
+ * Returns the same value as steady_clock::now() with CustomSteadyClock installed,
+ * but reads the ns-3 time directly instead of through the virtual getNow() of the
+ * ndn-cxx custom clock.
+ */
+inline steady_clock::TimePoint
+steadyNow()
+{
+  return steady_clock::TimePoint(boost::chrono::nanoseconds(Simulator::Now().GetNanoSeconds()));
+}
+
 } // namespace time
 } // namespace ndn
 } // namespace ns3
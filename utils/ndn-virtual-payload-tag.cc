@@ -0,0 +1,67 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#include "ndn-virtual-payload-tag.h"
+
+namespace ns3 {
+namespace ndn {
+
+TypeId
+VirtualPayloadTag::GetTypeId ()
+{
+  static TypeId tid = TypeId("ns3::ndn::VirtualPayloadTag")
+    .SetParent<Tag>()
+    .AddConstructor<VirtualPayloadTag>()
+    ;
+  return tid;
+}
+
+TypeId
+VirtualPayloadTag::GetInstanceTypeId () const
+{
+  return VirtualPayloadTag::GetTypeId ();
+}
+
+uint32_t
+VirtualPayloadTag::GetSerializedSize () const
+{
+  return sizeof(uint32_t);
+}
+
+void
+VirtualPayloadTag::Serialize (TagBuffer i) const
+{
+  i.WriteU32 (m_size);
+}
+
+void
+VirtualPayloadTag::Deserialize (TagBuffer i)
+{
+  m_size = i.ReadU32 ();
+}
+
+void
+VirtualPayloadTag::Print (std::ostream &os) const
+{
+  os << m_size;
+}
+
+} // namespace ndn
+} // namespace ns3
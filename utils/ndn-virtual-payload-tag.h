@@ -0,0 +1,89 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#ifndef NDN_VIRTUAL_PAYLOAD_TAG_H
+#define NDN_VIRTUAL_PAYLOAD_TAG_H
+
+#include "ns3/tag.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn
+ * @brief Packet tag marking Data whose content is virtual
+ *
+ * Data carrying this tag has empty content, but is sent over links as if its content
+ * were Get () bytes long: the ns-3 packet is padded with zero bytes that are not stored
+ * in memory (see Data::getWirePacket).  The tag travels with the packet, so every hop
+ * accounts for the same size.
+ */
+class VirtualPayloadTag : public Tag
+{
+public:
+  static TypeId
+  GetTypeId (void);
+
+  VirtualPayloadTag () : m_size (0) { };
+
+  ~VirtualPayloadTag () { }
+
+  /**
+   * @brief Get size of virtual content
+   */
+  uint32_t
+  Get () const { return m_size; }
+
+  /**
+   * @brief Set size of virtual content
+   */
+  void
+  Set (uint32_t size) { m_size = size; }
+
+  ////////////////////////////////////////////////////////
+  // from ObjectBase
+  ////////////////////////////////////////////////////////
+  virtual TypeId
+  GetInstanceTypeId () const;
+
+  ////////////////////////////////////////////////////////
+  // from Tag
+  ////////////////////////////////////////////////////////
+
+  virtual uint32_t
+  GetSerializedSize () const;
+
+  virtual void
+  Serialize (TagBuffer i) const;
+
+  virtual void
+  Deserialize (TagBuffer i);
+
+  virtual void
+  Print (std::ostream &os) const;
+
+private:
+  uint32_t m_size;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_VIRTUAL_PAYLOAD_TAG_H
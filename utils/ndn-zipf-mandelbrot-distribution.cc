@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#include "ndn-zipf-mandelbrot-distribution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <tuple>
+
+namespace ns3 {
+namespace ndn {
+
+std::shared_ptr<const ZipfMandelbrotDistribution>
+ZipfMandelbrotDistribution::Get (uint32_t n, double q, double s)
+{
+  typedef std::map<std::tuple<uint32_t, double, double>,
+                   std::weak_ptr<const ZipfMandelbrotDistribution> > Registry;
+  static Registry registry;
+
+  std::weak_ptr<const ZipfMandelbrotDistribution>& entry = registry[std::make_tuple (n, q, s)];
+  std::shared_ptr<const ZipfMandelbrotDistribution> distribution = entry.lock ();
+  if (distribution == nullptr)
+    {
+      // forget distributions no longer used by anyone
+      for (Registry::iterator i = registry.begin (); i != registry.end (); )
+        {
+          if (i->second.expired () && &i->second != &entry)
+            registry.erase (i++);
+          else
+            ++i;
+        }
+
+      distribution = std::make_shared<ZipfMandelbrotDistribution> (n, q, s);
+      entry = distribution;
+    }
+  return distribution;
+}
+
+ZipfMandelbrotDistribution::ZipfMandelbrotDistribution (uint32_t n, double q, double s)
+  : m_n (n)
+  , m_q (q)
+  , m_s (s)
+  , m_cdf (n + 1)
+  , m_guide (n + 1)
+{
+  m_cdf[0] = 0.0;
+  for (uint32_t i = 1; i <= m_n; i++)
+    {
+      m_cdf[i] = m_cdf[i - 1] + 1.0 / std::pow (i + m_q, m_s);
+    }
+
+  for (uint32_t i = 1; i <= m_n; i++)
+    {
+      m_cdf[i] = m_cdf[i] / m_cdf[m_n];
+    }
+
+  // bucket j covers uniform numbers in [j/N, (j+1)/N)
+  const double buckets = m_n;
+  uint32_t k = 0;
+  for (uint32_t j = 0; j <= m_n; j++)
+    {
+      while (k < m_n && m_cdf[k] * buckets < j)
+        k++;
+      m_guide[j] = k;
+    }
+}
+
+uint32_t
+ZipfMandelbrotDistribution::GetRank (double uniform) const
+{
+  if (m_n == 0)
+    return 1;
+
+  double position = uniform * static_cast<double> (m_n);
+  uint32_t bucket = position >= m_n ? m_n - 1 : static_cast<uint32_t> (position);
+
+  // all ranks before m_guide[bucket] have smaller cumulative probability, and
+  // m_guide[bucket + 1] has larger one (except for rounding in the last bucket)
+  std::vector<double>::const_iterator begin = m_cdf.begin () + m_guide[bucket];
+  std::vector<double>::const_iterator end = m_cdf.begin () + m_guide[bucket + 1] + 1;
+
+  std::vector<double>::const_iterator rank = std::lower_bound (begin, end, uniform);
+  if (rank == end)
+    rank = std::lower_bound (end, m_cdf.end (), uniform);
+
+  if (rank == m_cdf.end ())
+    return 1;
+  return rank - m_cdf.begin ();
+}
+
+} // namespace ndn
+} // namespace ns3
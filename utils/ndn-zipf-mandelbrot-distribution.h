@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011-2014 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * See AUTHORS file for the list of authors.
+ */
+
+#ifndef NDN_ZIPF_MANDELBROT_DISTRIBUTION_H
+#define NDN_ZIPF_MANDELBROT_DISTRIBUTION_H
+
+#include <stdint.h>
+#include <memory>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Immutable Zipf-Mandelbrot popularity distribution over ranks 1..N
+ *
+ * Probability of rank k is proportional to 1 / (k + q)^s.  Tables are built once per
+ * (N, q, s) by Get and shared by all users, so many consumers with the same catalog use
+ * a single copy.
+ *
+ * Sampling is an inverse-CDF lookup accelerated by a guide table (cutpoint method): a
+ * uniform number selects a bucket, which bounds the part of the CDF to be searched.  The
+ * expected cost is constant, and the result is always the smallest rank whose cumulative
+ * probability is not less than the uniform number, as with a linear scan of the CDF.
+ */
+class ZipfMandelbrotDistribution
+{
+public:
+  /**
+   * @brief Get shared distribution for the parameters, building it if no one uses it yet
+   */
+  static std::shared_ptr<const ZipfMandelbrotDistribution>
+  Get (uint32_t n, double q, double s);
+
+  /**
+   * @brief Build the distribution (use Get to share it)
+   */
+  ZipfMandelbrotDistribution (uint32_t n, double q, double s);
+
+  uint32_t
+  GetN () const;
+
+  double
+  GetQ () const;
+
+  double
+  GetS () const;
+
+  /**
+   * @brief Get rank corresponding to the uniform random number
+   * @param uniform number in (0, 1]
+   * @returns rank in [1, N] (1 if N is 0)
+   */
+  uint32_t
+  GetRank (double uniform) const;
+
+  /**
+   * @brief Get cumulative probability of ranks 1..k
+   */
+  double
+  GetCumulativeProbability (uint32_t k) const;
+
+private:
+  uint32_t m_n;
+  double m_q;
+  double m_s;
+
+  std::vector<double> m_cdf; ///< @brief m_cdf[k] is the probability of ranks 1..k, m_cdf[0] = 0
+  std::vector<uint32_t> m_guide; ///< @brief m_guide[j] is the smallest k with m_cdf[k] * N >= j
+};
+
+inline uint32_t
+ZipfMandelbrotDistribution::GetN () const
+{
+  return m_n;
+}
+
+inline double
+ZipfMandelbrotDistribution::GetQ () const
+{
+  return m_q;
+}
+
+inline double
+ZipfMandelbrotDistribution::GetS () const
+{
+  return m_s;
+}
+
+inline double
+ZipfMandelbrotDistribution::GetCumulativeProbability (uint32_t k) const
+{
+  return m_cdf[k];
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_ZIPF_MANDELBROT_DISTRIBUTION_H